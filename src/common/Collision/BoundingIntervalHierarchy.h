@@ -29,6 +29,7 @@
 #include <cstring>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #define MAX_STACK_SIZE 64
@@ -233,12 +234,24 @@ public:
                     {
                         // leaf - test some objects
                         int n = tree[node + 1];
-                        while (n > 0)
+                        if constexpr (std::is_invocable_v<RayCallback&, const G3D::Ray&, uint32 const*, uint32, float&, bool>)
                         {
-                            bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirstHit);
-                            if (stopAtFirstHit && hit) { return; }
-                            --n;
-                            ++offset;
+                            // callback tests the whole leaf at once
+                            if (n > 0)
+                            {
+                                bool hit = intersectCallback(r, &objects[offset], uint32(n), maxDist, stopAtFirstHit);
+                                if (stopAtFirstHit && hit) { return; }
+                            }
+                        }
+                        else
+                        {
+                            while (n > 0)
+                            {
+                                bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirstHit);
+                                if (stopAtFirstHit && hit) { return; }
+                                --n;
+                                ++offset;
+                            }
                         }
                         break;
                     }
@@ -0,0 +1,477 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DYNAMIC_BVH_H
+#define _DYNAMIC_BVH_H
+
+#include "Define.h"
+#include "Errors.h"
+#include <G3D/AABox.h>
+#include <G3D/BoundsTrait.h>
+#include <G3D/Ray.h>
+#include <G3D/Vector3.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Bounding volume hierarchy for objects that are inserted, removed and moved while it is queried.
+ *
+ * Every change is applied right away: the leaf is (re)inserted next to the sibling that grows the
+ * tree the least and its ancestors are refit and rotated on the way back to the root, so the tree
+ * stays balanced without periodic rebuilds. Leaves are enlarged by LEAF_MARGIN, a model moving
+ * inside that margin does not touch the tree at all.
+ *
+ * rebuild() builds a new median split tree from scratch, which gives better trees than many
+ * single insertions, e.g. after all spawns of a map were added.
+ */
+template<class T, class BoundsFunc = BoundsTrait<T>>
+class DynamicBVH
+{
+public:
+    static constexpr float LEAF_MARGIN = 1.0f;
+
+    DynamicBVH() : _root(NULL_NODE), _freeList(NULL_NODE) { }
+
+    void insert(T const& obj)
+    {
+        G3D::AABox bounds;
+        BoundsFunc::GetBounds2(&obj, bounds);
+
+        int32 leaf = allocateNode();
+        _nodes[leaf].Bounds = fatten(bounds);
+        _nodes[leaf].Object = &obj;
+        _leaves[&obj] = leaf;
+        insertLeaf(leaf);
+    }
+
+    void remove(T const& obj)
+    {
+        auto itr = _leaves.find(&obj);
+        if (itr == _leaves.end())
+            return;
+
+        removeLeaf(itr->second);
+        freeNode(itr->second);
+        _leaves.erase(itr);
+    }
+
+    // Picks up the new bounds of an object already in the tree, returns false if the tree did not need to change
+    bool move(T const& obj)
+    {
+        auto itr = _leaves.find(&obj);
+        if (itr == _leaves.end())
+            return false;
+
+        G3D::AABox bounds;
+        BoundsFunc::GetBounds2(&obj, bounds);
+
+        int32 leaf = itr->second;
+        if (_nodes[leaf].Bounds.contains(bounds))
+            return false;
+
+        removeLeaf(leaf);
+        _nodes[leaf].Bounds = fatten(bounds);
+        insertLeaf(leaf);
+        return true;
+    }
+
+    void rebuild()
+    {
+        std::vector<T const*> objects;
+        objects.reserve(_leaves.size());
+        for (auto const& [obj, leaf] : _leaves)
+            objects.push_back(obj);
+
+        _nodes.clear();
+        _leaves.clear();
+        _root = NULL_NODE;
+        _freeList = NULL_NODE;
+
+        if (objects.empty())
+            return;
+
+        std::vector<int32> leaves;
+        leaves.reserve(objects.size());
+        for (T const* obj : objects)
+        {
+            G3D::AABox bounds;
+            BoundsFunc::GetBounds2(obj, bounds);
+
+            int32 leaf = allocateNode();
+            _nodes[leaf].Bounds = fatten(bounds);
+            _nodes[leaf].Object = obj;
+            _leaves[obj] = leaf;
+            leaves.push_back(leaf);
+        }
+
+        _root = buildRange(leaves, 0, leaves.size());
+        _nodes[_root].Parent = NULL_NODE;
+    }
+
+    [[nodiscard]] bool contains(T const& obj) const { return _leaves.find(&obj) != _leaves.end(); }
+    [[nodiscard]] int size() const { return int(_leaves.size()); }
+    [[nodiscard]] int height() const { return _root == NULL_NODE ? 0 : _nodes[_root].Height; }
+
+    template<typename RayCallback>
+    void intersectRay(G3D::Ray const& ray, RayCallback& intersectCallback, float& maxDist, bool stopAtFirstHit) const
+    {
+        if (_root == NULL_NODE)
+            return;
+
+        int32 stack[MAX_STACK_SIZE];
+        uint32 stackSize = 0;
+        stack[stackSize++] = _root;
+
+        while (stackSize)
+        {
+            Node const& node = _nodes[stack[--stackSize]];
+            if (!intersectsBox(ray, node.Bounds, maxDist))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                if (intersectCallback(ray, *node.Object, maxDist, stopAtFirstHit) && stopAtFirstHit)
+                    return;
+                continue;
+            }
+
+            ASSERT(stackSize + 2 <= MAX_STACK_SIZE);
+            stack[stackSize++] = node.Child2;
+            stack[stackSize++] = node.Child1;
+        }
+    }
+
+    template<typename IsectCallback>
+    void intersectPoint(G3D::Vector3 const& point, IsectCallback& intersectCallback) const
+    {
+        if (_root == NULL_NODE)
+            return;
+
+        int32 stack[MAX_STACK_SIZE];
+        uint32 stackSize = 0;
+        stack[stackSize++] = _root;
+
+        while (stackSize)
+        {
+            Node const& node = _nodes[stack[--stackSize]];
+            if (!node.Bounds.contains(point))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                intersectCallback(point, *node.Object);
+                continue;
+            }
+
+            ASSERT(stackSize + 2 <= MAX_STACK_SIZE);
+            stack[stackSize++] = node.Child2;
+            stack[stackSize++] = node.Child1;
+        }
+    }
+
+private:
+    static constexpr int32 NULL_NODE = -1;
+    // the rotations keep the height close to 1.44 * log2(n), far below this for any map
+    static constexpr uint32 MAX_STACK_SIZE = 128;
+
+    struct Node
+    {
+        G3D::AABox Bounds;
+        T const* Object = nullptr;
+        int32 Parent = NULL_NODE;   // next free node while the node is unused
+        int32 Child1 = NULL_NODE;
+        int32 Child2 = NULL_NODE;
+        int32 Height = 0;           // 0 for leaves
+
+        [[nodiscard]] bool IsLeaf() const { return Child1 == NULL_NODE; }
+    };
+
+    static G3D::AABox fatten(G3D::AABox const& bounds)
+    {
+        G3D::Vector3 const margin(LEAF_MARGIN, LEAF_MARGIN, LEAF_MARGIN);
+        return G3D::AABox(bounds.low() - margin, bounds.high() + margin);
+    }
+
+    static G3D::AABox merged(G3D::AABox const& first, G3D::AABox const& second)
+    {
+        G3D::AABox result = first;
+        result.merge(second);
+        return result;
+    }
+
+    // slab test against [0, maxDist], NaNs from axis parallel rays are ignored and keep the box
+    static bool intersectsBox(G3D::Ray const& ray, G3D::AABox const& box, float maxDist)
+    {
+        float tNear = 0.0f;
+        float tFar = maxDist;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float t1 = (box.low()[axis] - ray.origin()[axis]) * ray.invDirection()[axis];
+            float t2 = (box.high()[axis] - ray.origin()[axis]) * ray.invDirection()[axis];
+            if (t1 > t2)
+                std::swap(t1, t2);
+
+            if (t1 > tNear)
+                tNear = t1;
+            if (t2 < tFar)
+                tFar = t2;
+            if (tNear > tFar)
+                return false;
+        }
+        return true;
+    }
+
+    int32 allocateNode()
+    {
+        int32 index;
+        if (_freeList != NULL_NODE)
+        {
+            index = _freeList;
+            _freeList = _nodes[index].Parent;
+            _nodes[index] = Node();
+        }
+        else
+        {
+            index = int32(_nodes.size());
+            _nodes.emplace_back();
+        }
+        return index;
+    }
+
+    void freeNode(int32 index)
+    {
+        _nodes[index] = Node();
+        _nodes[index].Parent = _freeList;
+        _freeList = index;
+    }
+
+    // cost of putting the new leaf below index, SAH increase of the subtree
+    float insertionCost(int32 index, G3D::AABox const& leafBounds, float inheritedCost) const
+    {
+        float area = merged(_nodes[index].Bounds, leafBounds).area();
+        if (_nodes[index].IsLeaf())
+            return area + inheritedCost;
+        return area - _nodes[index].Bounds.area() + inheritedCost;
+    }
+
+    void insertLeaf(int32 leaf)
+    {
+        if (_root == NULL_NODE)
+        {
+            _root = leaf;
+            _nodes[leaf].Parent = NULL_NODE;
+            return;
+        }
+
+        // find the sibling that makes the tree grow the least
+        G3D::AABox const leafBounds = _nodes[leaf].Bounds;
+        int32 index = _root;
+        while (!_nodes[index].IsLeaf())
+        {
+            float area = _nodes[index].Bounds.area();
+            float combinedArea = merged(_nodes[index].Bounds, leafBounds).area();
+
+            // cost of a new parent for this node and the leaf, and the minimum cost pushed down to the children
+            float cost = 2.0f * combinedArea;
+            float inheritedCost = 2.0f * (combinedArea - area);
+
+            float cost1 = insertionCost(_nodes[index].Child1, leafBounds, inheritedCost);
+            float cost2 = insertionCost(_nodes[index].Child2, leafBounds, inheritedCost);
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? _nodes[index].Child1 : _nodes[index].Child2;
+        }
+
+        int32 sibling = index;
+        int32 oldParent = _nodes[sibling].Parent;
+        int32 newParent = allocateNode();
+        _nodes[newParent].Parent = oldParent;
+        _nodes[newParent].Bounds = merged(leafBounds, _nodes[sibling].Bounds);
+        _nodes[newParent].Height = _nodes[sibling].Height + 1;
+        _nodes[newParent].Child1 = sibling;
+        _nodes[newParent].Child2 = leaf;
+        _nodes[sibling].Parent = newParent;
+        _nodes[leaf].Parent = newParent;
+
+        if (oldParent == NULL_NODE)
+            _root = newParent;
+        else if (_nodes[oldParent].Child1 == sibling)
+            _nodes[oldParent].Child1 = newParent;
+        else
+            _nodes[oldParent].Child2 = newParent;
+
+        refitAncestors(newParent);
+    }
+
+    void removeLeaf(int32 leaf)
+    {
+        if (leaf == _root)
+        {
+            _root = NULL_NODE;
+            return;
+        }
+
+        int32 parent = _nodes[leaf].Parent;
+        int32 grandParent = _nodes[parent].Parent;
+        int32 sibling = _nodes[parent].Child1 == leaf ? _nodes[parent].Child2 : _nodes[parent].Child1;
+
+        freeNode(parent);
+        _nodes[sibling].Parent = grandParent;
+        _nodes[leaf].Parent = NULL_NODE;
+
+        if (grandParent == NULL_NODE)
+        {
+            _root = sibling;
+            return;
+        }
+
+        if (_nodes[grandParent].Child1 == parent)
+            _nodes[grandParent].Child1 = sibling;
+        else
+            _nodes[grandParent].Child2 = sibling;
+
+        refitAncestors(grandParent);
+    }
+
+    // walks from index to the root, rotating unbalanced nodes and fixing bounds and heights
+    void refitAncestors(int32 index)
+    {
+        while (index != NULL_NODE)
+        {
+            index = rotate(index);
+
+            Node& node = _nodes[index];
+            node.Height = 1 + std::max(_nodes[node.Child1].Height, _nodes[node.Child2].Height);
+            node.Bounds = merged(_nodes[node.Child1].Bounds, _nodes[node.Child2].Bounds);
+
+            index = node.Parent;
+        }
+    }
+
+    /**
+     * Lifts the higher grandchild into a's place if the subtrees below a differ in height by more than one.
+     * Returns the index of the node now at a's place.
+     *
+     *       a
+     *      / \
+     *     b   c
+     *        / \
+     *       f   g
+     */
+    int32 rotate(int32 a)
+    {
+        Node& nodeA = _nodes[a];
+        if (nodeA.IsLeaf() || nodeA.Height < 2)
+            return a;
+
+        int32 b = nodeA.Child1;
+        int32 c = nodeA.Child2;
+        int32 balance = _nodes[c].Height - _nodes[b].Height;
+
+        if (balance > 1)
+            return rotateUp(a, c, b, false);
+        if (balance < -1)
+            return rotateUp(a, b, c, true);
+        return a;
+    }
+
+    // child becomes the parent of a, child's higher child stays below child, the lower one moves below a
+    int32 rotateUp(int32 a, int32 child, int32 otherChild, bool childIsFirst)
+    {
+        Node& nodeA = _nodes[a];
+        Node& nodeChild = _nodes[child];
+
+        int32 f = nodeChild.Child1;
+        int32 g = nodeChild.Child2;
+
+        nodeChild.Child1 = a;
+        nodeChild.Parent = nodeA.Parent;
+        nodeA.Parent = child;
+
+        if (nodeChild.Parent == NULL_NODE)
+            _root = child;
+        else if (_nodes[nodeChild.Parent].Child1 == a)
+            _nodes[nodeChild.Parent].Child1 = child;
+        else
+            _nodes[nodeChild.Parent].Child2 = child;
+
+        int32 keep = f;
+        int32 give = g;
+        if (_nodes[f].Height < _nodes[g].Height)
+            std::swap(keep, give);
+
+        nodeChild.Child2 = keep;
+        if (childIsFirst)
+            nodeA.Child1 = give;
+        else
+            nodeA.Child2 = give;
+        _nodes[give].Parent = a;
+
+        nodeA.Bounds = merged(_nodes[otherChild].Bounds, _nodes[give].Bounds);
+        nodeA.Height = 1 + std::max(_nodes[otherChild].Height, _nodes[give].Height);
+        nodeChild.Bounds = merged(nodeA.Bounds, _nodes[keep].Bounds);
+        nodeChild.Height = 1 + std::max(nodeA.Height, _nodes[keep].Height);
+        return child;
+    }
+
+    int32 buildRange(std::vector<int32>& leaves, std::size_t begin, std::size_t end)
+    {
+        if (end - begin == 1)
+            return leaves[begin];
+
+        // split at the median along the longest axis of the leaf centers
+        G3D::AABox centers;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            G3D::Vector3 center = _nodes[leaves[i]].Bounds.center();
+            if (i == begin)
+                centers = G3D::AABox(center, center);
+            else
+                centers.merge(center);
+        }
+
+        G3D::Vector3 extent = centers.extent();
+        int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+        std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(leaves.begin() + begin, leaves.begin() + mid, leaves.begin() + end, [&](int32 left, int32 right)
+        {
+            return _nodes[left].Bounds.center()[axis] < _nodes[right].Bounds.center()[axis];
+        });
+
+        int32 child1 = buildRange(leaves, begin, mid);
+        int32 child2 = buildRange(leaves, mid, end);
+
+        int32 index = allocateNode();
+        Node& node = _nodes[index];
+        node.Child1 = child1;
+        node.Child2 = child2;
+        node.Height = 1 + std::max(_nodes[child1].Height, _nodes[child2].Height);
+        node.Bounds = merged(_nodes[child1].Bounds, _nodes[child2].Bounds);
+        _nodes[child1].Parent = index;
+        _nodes[child2].Parent = index;
+        return index;
+    }
+
+    std::vector<Node> _nodes;
+    std::unordered_map<T const*, int32> _leaves;
+    int32 _root;
+    int32 _freeList;
+};
+
+#endif // _DYNAMIC_BVH_H
@@ -16,13 +16,11 @@
  */
 
 #include "DynamicTree.h"
-#include "BoundingIntervalHierarchyWrapper.h"
+#include "DynamicBVH.h"
 #include "GameObjectModel.h"
 #include "MapTree.h"
 #include "ModelIgnoreFlags.h"
 #include "ModelInstance.h"
-#include "RegularGrid.h"
-#include "Timer.h"
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
 #include "WorldModel.h"
@@ -33,78 +31,18 @@
 
 using VMAP::ModelInstance;
 
-namespace
-{
-    int CHECK_TREE_PERIOD = 200;
-}
-
-template<> struct HashTrait< GameObjectModel>
-{
-    static std::size_t hashCode(const GameObjectModel& g) { return (size_t)(void*)&g; }
-};
-
-template<> struct PositionTrait< GameObjectModel>
-{
-    static void GetPosition(const GameObjectModel& g, G3D::Vector3& p) { p = g.GetPosition(); }
-};
-
 template<> struct BoundsTrait< GameObjectModel>
 {
     static void GetBounds(const GameObjectModel& g, G3D::AABox& out) { out = g.GetBounds();}
     static void GetBounds2(const GameObjectModel* g, G3D::AABox& out) { out = g->GetBounds();}
 };
 
-typedef RegularGrid2D<GameObjectModel, BIHWrap<GameObjectModel>> ParentTree;
-
-struct DynTreeImpl : public ParentTree
+struct DynTreeImpl : public DynamicBVH<GameObjectModel>
 {
-    typedef GameObjectModel Model;
-    typedef ParentTree base;
+    DynTreeImpl() : generation(0), inserted_since_rebuild(0) { }
 
-    DynTreeImpl() :
-        rebalance_timer(CHECK_TREE_PERIOD),
-        unbalanced_times(0)
-    {
-    }
-
-    void insert(const Model& mdl)
-    {
-        base::insert(mdl);
-        ++unbalanced_times;
-    }
-
-    void remove(const Model& mdl)
-    {
-        base::remove(mdl);
-        ++unbalanced_times;
-    }
-
-    void balance()
-    {
-        base::balance();
-        unbalanced_times = 0;
-    }
-
-    void update(uint32 difftime)
-    {
-        if (!size())
-        {
-            return;
-        }
-
-        rebalance_timer.Update(difftime);
-        if (rebalance_timer.Passed())
-        {
-            rebalance_timer.Reset(CHECK_TREE_PERIOD);
-            if (unbalanced_times > 0)
-            {
-                balance();
-            }
-        }
-    }
-
-    TimeTrackerSmall rebalance_timer;
-    int unbalanced_times;
+    uint32 generation;
+    int inserted_since_rebuild;
 };
 
 DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()) { }
@@ -117,11 +55,25 @@ DynamicMapTree::~DynamicMapTree()
 void DynamicMapTree::insert(const GameObjectModel& mdl)
 {
     impl->insert(mdl);
+    ++impl->generation;
+    ++impl->inserted_since_rebuild;
 }
 
 void DynamicMapTree::remove(const GameObjectModel& mdl)
 {
     impl->remove(mdl);
+    ++impl->generation;
+}
+
+void DynamicMapTree::move(const GameObjectModel& mdl)
+{
+    impl->move(mdl);
+    ++impl->generation;
+}
+
+void DynamicMapTree::invalidate()
+{
+    ++impl->generation;
 }
 
 bool DynamicMapTree::contains(const GameObjectModel& mdl) const
@@ -131,7 +83,12 @@ bool DynamicMapTree::contains(const GameObjectModel& mdl) const
 
 void DynamicMapTree::balance()
 {
-    impl->balance();
+    // the incremental tree is fine for a few additions, only rebuild after bulk loads (grids, battlegrounds)
+    if (impl->inserted_since_rebuild * 4 < impl->size())
+        return;
+
+    impl->rebuild();
+    impl->inserted_since_rebuild = 0;
 }
 
 int DynamicMapTree::size() const
@@ -139,9 +96,9 @@ int DynamicMapTree::size() const
     return impl->size();
 }
 
-void DynamicMapTree::update(uint32 t_diff)
+uint32 DynamicMapTree::GetGeneration() const
 {
-    impl->update(t_diff);
+    return impl->generation;
 }
 
 struct DynamicTreeIntersectionCallback
@@ -196,11 +153,11 @@ private:
     GameObjectModel const* _hitModel;
 };
 
-bool DynamicMapTree::GetIntersectionTime(const uint32 phasemask, const G3D::Ray& ray, const G3D::Vector3& endPos, float& maxDist) const
+bool DynamicMapTree::GetIntersectionTime(const uint32 phasemask, const G3D::Ray& ray, float& maxDist) const
 {
     float distance = maxDist;
     DynamicTreeIntersectionCallback callback(phasemask, VMAP::ModelIgnoreFlags::Nothing);
-    impl->intersectRay(ray, callback, distance, endPos, false);
+    impl->intersectRay(ray, callback, distance, false);
     if (callback.didHit())
     {
         maxDist = distance;
@@ -225,7 +182,7 @@ bool DynamicMapTree::GetObjectHitPos(const uint32 phasemask, const G3D::Vector3&
     G3D::Vector3 dir = (endPos - startPos) / maxDist;            // direction with length of 1
     G3D::Ray ray(startPos, dir);
     float dist = maxDist;
-    if (GetIntersectionTime(phasemask, ray, endPos, dist))
+    if (GetIntersectionTime(phasemask, ray, dist))
     {
         resultHit = startPos + dir * dist;
         if (modifyDist < 0)
@@ -267,7 +224,7 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
 
     G3D::Ray r(v1, (v2 - v1) / maxDist);
     DynamicTreeIntersectionCallback callback(phasemask, ignoreFlags);
-    impl->intersectRay(r, callback, maxDist, v2, true);
+    impl->intersectRay(r, callback, maxDist, true);
 
     return !callback.didHit();
 }
@@ -277,7 +234,7 @@ float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist,
     G3D::Vector3 v(x, y, z);
     G3D::Ray r(v, G3D::Vector3(0, 0, -1));
     DynamicTreeIntersectionCallback callback(phasemask, VMAP::ModelIgnoreFlags::Nothing);
-    impl->intersectZAllignedRay(r, callback, maxSearchDist);
+    impl->intersectRay(r, callback, maxSearchDist, false);
 
     if (callback.didHit())
     {
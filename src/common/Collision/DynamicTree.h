@@ -46,7 +46,7 @@ public:
 
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, VMAP::ModelIgnoreFlags ignoreFlags) const;
 
-    bool GetIntersectionTime(uint32 phasemask, const G3D::Ray& ray, const G3D::Vector3& endPos, float& maxDist) const;
+    bool GetIntersectionTime(uint32 phasemask, const G3D::Ray& ray, float& maxDist) const;
 
     bool GetAreaAndLiquidData(float x, float y, float z, uint32 phasemask, Optional<uint8> reqLiquidType, VMAP::AreaAndLiquidData& data) const;
 
@@ -58,11 +58,18 @@ public:
 
     void insert(const GameObjectModel&);
     void remove(const GameObjectModel&);
+    // call after GameObjectModel::UpdatePosition of a model in the tree
+    void move(const GameObjectModel&);
+    // call when a model in the tree changed in a way the tree can't see, e.g. its collision was toggled
+    void invalidate();
     [[nodiscard]] bool contains(const GameObjectModel&) const;
     [[nodiscard]] int size() const;
 
+    // changes with every insert, remove, move and invalidate, cached query results of an older generation are stale
+    [[nodiscard]] uint32 GetGeneration() const;
+
+    // the tree stays balanced on its own, this rebuilds it from scratch when a large part of it was inserted since the last rebuild
     void balance();
-    void update(uint32 diff);
 };
 
 #endif // _DYNTREE_H
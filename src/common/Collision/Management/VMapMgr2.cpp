@@ -29,9 +29,24 @@
 
 using G3D::Vector3;
 
+namespace
+{
+    // Hit and miss counts are added to the shared counters in batches
+    constexpr uint32 QUERY_CACHE_STATS_BATCH = 1024;
+
+    struct ThreadQueryCache
+    {
+        VMAP::VMapQueryCache Cache;
+        uint32 Hits = 0;
+        uint32 Misses = 0;
+    };
+
+    thread_local ThreadQueryCache threadQueryCache;
+}
+
 namespace VMAP
 {
-    VMapMgr2::VMapMgr2()
+    VMapMgr2::VMapMgr2() : iQueryCacheEnabled(false), iQueryCacheSize(0), iQueryCacheHits(0), iQueryCacheMisses(0)
     {
         GetLiquidFlagsPtr = &GetLiquidFlagsDummy;
         IsVMAPDisabledForPtr = &IsVMAPDisabledForDummy;
@@ -57,6 +72,7 @@ namespace VMAP
         for (const uint32& mapId : mapIds)
         {
             iInstanceMapTrees.emplace(mapId, nullptr);
+            iTreeGenerations.try_emplace(mapId);
         }
 
         thread_safe_environment = false;
@@ -102,6 +118,7 @@ namespace VMAP
         {
             if (_loadMap(mapId, basePath, x, y))
             {
+                UpdateTreeGeneration(mapId);
                 result = VMAP_LOAD_RESULT_OK;
             }
             else
@@ -122,6 +139,7 @@ namespace VMAP
             if (thread_safe_environment)
             {
                 instanceTree = iInstanceMapTrees.insert(InstanceTreeMap::value_type(mapId, nullptr)).first;
+                iTreeGenerations.try_emplace(mapId);
             }
             else
                 ABORT("Invalid mapId {} tile [{}, {}] passed to VMapMgr2 after startup in thread unsafe environment",
@@ -149,6 +167,7 @@ namespace VMAP
         if (instanceTree != iInstanceMapTrees.end() && instanceTree->second)
         {
             instanceTree->second->UnloadMap(this);
+            UpdateTreeGeneration(mapId);
             if (instanceTree->second->numLoadedTiles() == 0)
             {
                 delete instanceTree->second;
@@ -163,6 +182,7 @@ namespace VMAP
         if (instanceTree != iInstanceMapTrees.end() && instanceTree->second)
         {
             instanceTree->second->UnloadMapTile(x, y, this);
+            UpdateTreeGeneration(mapId);
             if (instanceTree->second->numLoadedTiles() == 0)
             {
                 delete instanceTree->second;
@@ -187,7 +207,18 @@ namespace VMAP
             Vector3 pos2 = convertPositionToInternalRep(x2, y2, z2);
             if (pos1 != pos2)
             {
-                return instanceTree->second->isInLineOfSight(pos1, pos2, ignoreFlags);
+                if (!iQueryCacheEnabled)
+                    return instanceTree->second->isInLineOfSight(pos1, pos2, ignoreFlags);
+
+                VMapQueryCache::Key key = VMapQueryCache::MakeLineOfSightKey(mapId, x1, y1, z1, x2, y2, z2, uint32(ignoreFlags));
+                uint32 generation = GetTreeGeneration(mapId);
+                float cachedResult;
+                if (FindCachedQuery(key, generation, cachedResult))
+                    return cachedResult != 0.0f;
+
+                bool result = instanceTree->second->isInLineOfSight(pos1, pos2, ignoreFlags);
+                StoreCachedQuery(key, generation, result ? 1.0f : 0.0f);
+                return result;
             }
         }
 
@@ -239,13 +270,27 @@ namespace VMAP
             InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
             if (instanceTree != iInstanceMapTrees.end())
             {
+                VMapQueryCache::Key key{};
+                uint32 generation = 0;
+                if (iQueryCacheEnabled)
+                {
+                    key = VMapQueryCache::MakeHeightKey(mapId, x, y, z, maxSearchDist);
+                    generation = GetTreeGeneration(mapId);
+                    float cachedHeight;
+                    if (FindCachedQuery(key, generation, cachedHeight))
+                        return cachedHeight;
+                }
+
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
                 float height = instanceTree->second->getHeight(pos, maxSearchDist);
                 if (height >= G3D::finf())
                 {
-                    return height = VMAP_INVALID_HEIGHT_VALUE;    // No height
+                    height = VMAP_INVALID_HEIGHT_VALUE;    // No height
                 }
 
+                if (iQueryCacheEnabled)
+                    StoreCachedQuery(key, generation, height);
+
                 return height;
             }
         }
@@ -253,6 +298,62 @@ namespace VMAP
         return VMAP_INVALID_HEIGHT_VALUE;
     }
 
+    void VMapMgr2::SetQueryCacheSettings(bool enabled, uint32 size)
+    {
+        iQueryCacheEnabled = enabled && size;
+        iQueryCacheSize = size;
+    }
+
+    void VMapMgr2::GetQueryCacheStats(uint64& hits, uint64& misses)
+    {
+        hits = iQueryCacheHits.exchange(0);
+        misses = iQueryCacheMisses.exchange(0);
+    }
+
+    uint32 VMapMgr2::GetTreeGeneration(uint32 mapId) const
+    {
+        auto itr = iTreeGenerations.find(mapId);
+        return itr != iTreeGenerations.end() ? itr->second.load() : 0;
+    }
+
+    void VMapMgr2::UpdateTreeGeneration(uint32 mapId)
+    {
+        auto itr = iTreeGenerations.find(mapId);
+        if (itr != iTreeGenerations.end())
+            ++itr->second;
+    }
+
+    VMapQueryCache& VMapMgr2::GetQueryCache()
+    {
+        // settings are only changed on config reload, cached entries are dropped then
+        threadQueryCache.Cache.Configure(iQueryCacheSize);
+        return threadQueryCache.Cache;
+    }
+
+    bool VMapMgr2::FindCachedQuery(VMapQueryCache::Key const& key, uint32 generation, float& result)
+    {
+        bool found = GetQueryCache().Find(key, generation, result);
+        if (found)
+            ++threadQueryCache.Hits;
+        else
+            ++threadQueryCache.Misses;
+
+        if (threadQueryCache.Hits + threadQueryCache.Misses >= QUERY_CACHE_STATS_BATCH)
+        {
+            iQueryCacheHits += threadQueryCache.Hits;
+            iQueryCacheMisses += threadQueryCache.Misses;
+            threadQueryCache.Hits = 0;
+            threadQueryCache.Misses = 0;
+        }
+
+        return found;
+    }
+
+    void VMapMgr2::StoreCachedQuery(VMapQueryCache::Key const& key, uint32 generation, float result)
+    {
+        threadQueryCache.Cache.Store(key, generation, result);
+    }
+
     bool VMapMgr2::GetAreaAndLiquidData(uint32 mapId, float x, float y, float z, Optional<uint8> reqLiquidType, AreaAndLiquidData& data) const
     {
         InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
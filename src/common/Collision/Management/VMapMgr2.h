@@ -19,6 +19,8 @@
 #define _VMAPMANAGER2_H
 
 #include "IVMapMgr.h"
+#include "VMapQueryCache.h"
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -91,6 +93,21 @@ namespace VMAP
 
         InstanceTreeMap::const_iterator GetMapTree(uint32 mapId) const;
 
+        // Query cache, see VMapQueryCache
+        bool FindCachedQuery(VMapQueryCache::Key const& key, uint32 generation, float& result);
+        void StoreCachedQuery(VMapQueryCache::Key const& key, uint32 generation, float result);
+        [[nodiscard]] VMapQueryCache& GetQueryCache();
+
+        // changed whenever a tile of the map is loaded or unloaded, the entries are added along with the iInstanceMapTrees ones
+        std::unordered_map<uint32, std::atomic<uint32>> iTreeGenerations;
+        [[nodiscard]] uint32 GetTreeGeneration(uint32 mapId) const;
+        void UpdateTreeGeneration(uint32 mapId);
+
+        bool iQueryCacheEnabled;
+        uint32 iQueryCacheSize;
+        std::atomic<uint64> iQueryCacheHits;
+        std::atomic<uint64> iQueryCacheMisses;
+
     public:
         // public for debug
         [[nodiscard]] G3D::Vector3 convertPositionToInternalRep(float x, float y, float z) const;
@@ -101,6 +118,13 @@ namespace VMAP
 
         void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
 
+        /**
+        Cache line of sight and height results of the static trees, per thread and keyed on the exact positions
+        */
+        void SetQueryCacheSettings(bool enabled, uint32 size);
+        /// Returns the number of cache hits and misses since the last call
+        void GetQueryCacheStats(uint64& hits, uint64& misses);
+
         int loadMap(const char* pBasePath, unsigned int mapId, int x, int y) override;
 
         void unloadMap(unsigned int mapId, int x, int y) override;
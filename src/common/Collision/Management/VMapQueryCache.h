@@ -0,0 +1,149 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _VMAPQUERYCACHE_H
+#define _VMAPQUERYCACHE_H
+
+#include "Define.h"
+#include <array>
+#include <bit>
+#include <list>
+#include <unordered_map>
+
+namespace VMAP
+{
+    /**
+    Bounded LRU cache of static tree query results, VMapMgr2 keeps one per thread.
+    Only queries with exactly the same positions share a result. Entries remember the tree generation
+    of their map they were computed with and are ignored once tiles of that map were loaded or unloaded since.
+    */
+    class VMapQueryCache
+    {
+    public:
+        enum class QueryType : uint8
+        {
+            LineOfSight,
+            Height
+        };
+
+        struct Key
+        {
+            uint32 MapId;
+            QueryType Type;
+            uint32 Flags;
+            std::array<uint32, 6> Position;   // bit patterns of the coordinates
+
+            bool operator==(Key const& right) const = default;
+        };
+
+        VMapQueryCache() : _capacity(0) { }
+
+        /// Drops all entries if the capacity changed
+        void Configure(std::size_t capacity)
+        {
+            if (capacity == _capacity)
+                return;
+
+            Clear();
+            _capacity = capacity;
+        }
+
+        static Key MakeLineOfSightKey(uint32 mapId, float x1, float y1, float z1, float x2, float y2, float z2, uint32 ignoreFlags)
+        {
+            return { mapId, QueryType::LineOfSight, ignoreFlags, { Bits(x1), Bits(y1), Bits(z1), Bits(x2), Bits(y2), Bits(z2) } };
+        }
+
+        static Key MakeHeightKey(uint32 mapId, float x, float y, float z, float maxSearchDist)
+        {
+            return { mapId, QueryType::Height, 0, { Bits(x), Bits(y), Bits(z), Bits(maxSearchDist), 0, 0 } };
+        }
+
+        bool Find(Key const& key, uint32 generation, float& result)
+        {
+            auto itr = _index.find(key);
+            if (itr == _index.end() || itr->second->Generation != generation)
+                return false;
+
+            // move to front
+            _entries.splice(_entries.begin(), _entries, itr->second);
+            result = itr->second->Result;
+            return true;
+        }
+
+        void Store(Key const& key, uint32 generation, float result)
+        {
+            if (!_capacity)
+                return;
+
+            auto itr = _index.find(key);
+            if (itr != _index.end())
+            {
+                itr->second->Generation = generation;
+                itr->second->Result = result;
+                _entries.splice(_entries.begin(), _entries, itr->second);
+                return;
+            }
+
+            if (_entries.size() >= _capacity)
+            {
+                _index.erase(_entries.back().CacheKey);
+                _entries.pop_back();
+            }
+
+            _entries.push_front({ key, generation, result });
+            _index.emplace(key, _entries.begin());
+        }
+
+        void Clear()
+        {
+            _index.clear();
+            _entries.clear();
+        }
+
+        [[nodiscard]] std::size_t GetSize() const { return _entries.size(); }
+
+    private:
+        struct Entry
+        {
+            Key CacheKey;
+            uint32 Generation;
+            float Result;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(Key const& key) const
+            {
+                std::size_t hash = (std::size_t(key.MapId) << 8) ^ std::size_t(key.Type) ^ (std::size_t(key.Flags) << 4);
+                for (uint32 value : key.Position)
+                    hash ^= std::hash<uint32>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+                return hash;
+            }
+        };
+
+        static uint32 Bits(float value)
+        {
+            return std::bit_cast<uint32>(value);
+        }
+
+        std::size_t _capacity;
+        std::list<Entry> _entries; // most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> _index;
+    };
+}
+
+#endif
@@ -19,11 +19,16 @@
 #include "BoundingIntervalHierarchy.h"
 #include "MapDefines.h"
 #include "MapTree.h"
+#include "Timer.h"
 #include "VMapDefinitions.h"
+#include <algorithm>
+#include <atomic>
 #include <boost/filesystem.hpp>
 #include <iomanip>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -52,8 +57,8 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
-        : iDestDir(pDestDirName), iSrcDir(pSrcDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads)
+        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iThreads(std::max<uint32>(threads, 1))
     {
         boost::filesystem::create_directory(iDestDir);
         //init();
@@ -72,147 +77,228 @@ namespace VMAP
             return false;
         }
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        uint32 const startTime = getMSTime();
+
+        // export Map data, every map is written to its own files so they are built in parallel
+        std::vector<MapData::iterator> maps;
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            maps.push_back(map_iter);
+        }
+
+        std::vector<std::set<std::string>> mapModelFiles(maps.size());
+        std::vector<uint32> mapTimes(maps.size(), 0);
+        std::atomic<bool> failed(false);
+        runParallel(maps.size(), [&](std::size_t i)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+            uint32 const mapStartTime = getMSTime();
+            if (!convertMap(maps[i]->first, *maps[i]->second, mapModelFiles[i]))
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                    {
-                        break;
-                    }
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    /// @todo remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
+                failed = true;
             }
+            mapTimes[i] = GetMSTimeDiffToNow(mapStartTime);
+            return !failed;
+        });
+        success = !failed;
+
+        printf("Map trees done in %u ms, slowest maps:\n", GetMSTimeDiffToNow(startTime));
+        std::vector<std::size_t> slowestMaps(maps.size());
+        for (std::size_t i = 0; i < maps.size(); ++i)
+        {
+            slowestMaps[i] = i;
+        }
+        std::stable_sort(slowestMaps.begin(), slowestMaps.end(), [&](std::size_t left, std::size_t right) { return mapTimes[left] > mapTimes[right]; });
+        for (std::size_t i = 0; i < slowestMaps.size() && i < 10; ++i)
+        {
+            printf("    map %03u: %u spawns, %u ms\n", maps[slowestMaps[i]]->first, uint32(maps[slowestMaps[i]]->second->UniqueEntries.size()), mapTimes[slowestMaps[i]]);
+        }
 
-            printf("Creating map tree for map %u...\n", map_iter->first);
-            BIH pTree;
+        for (std::set<std::string> const& modelFiles : mapModelFiles)
+        {
+            spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
+        }
 
-            try
-            {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::GetBounds);
-            }
-            catch (std::exception& e)
-            {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
-                return false;
-            }
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        uint32 const modelStartTime = getMSTime();
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::mutex outputLock;
+        failed = false;
+        runParallel(modelFiles.size(), [&](std::size_t i)
+        {
+            bool converted = convertRawFile(modelFiles[i]);
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i = 0; i < mapSpawns.size(); ++i)
+            std::lock_guard<std::mutex> guard(outputLock);
+            std::cout << "Converting " << modelFiles[i] << std::endl;
+            if (!converted)
             {
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+                std::cout << "error converting " << modelFiles[i] << std::endl;
+                failed = true;
             }
+            return !failed;
+        });
+        success = success && !failed;
+        printf("Converted %u model files in %u ms using %u threads\n", uint32(modelFiles.size()), GetMSTimeDiffToNow(modelStartTime), iThreads);
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
-            {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
-            }
+        //cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
 
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) { success = false; }
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) { success = false; }
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) { success = false; }
-            if (success) { success = pTree.writeToFile(mapfile); }
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) { success = false; }
-
-            for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+    void TileAssembler::runParallel(std::size_t count, std::function<bool(std::size_t)> const& job) const
+    {
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]()
+        {
+            for (std::size_t i = next++; i < count; i = next++)
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                if (!job(i))
+                {
+                    // let the other workers run out of jobs too
+                    next = count;
+                    return;
+                }
             }
+        };
 
-            fclose(mapfile);
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < iThreads && i < count; ++i)
+        {
+            workers.emplace_back(worker);
+        }
 
-            // <====
+        worker();
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap& tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        for (std::thread& thread : workers)
+        {
+            thread.join();
+        }
+    }
+
+    bool TileAssembler::convertMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles)
+    {
+        bool success = true;
+
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapId);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                const ModelSpawn& spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                if (!calculateTransformedBound(entry->second))
                 {
-                    continue;
-                }
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << '/' << std::setw(3) << map_iter->first << '_';
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
-                if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
-                {
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) { success = false; }
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) { success = false; }
-                    // write tile spawns
-                    for (uint32 s = 0; s < nSpawns; ++s)
-                    {
-                        if (s)
-                        {
-                            ++tile;
-                        }
-                        const ModelSpawn& spawn2 = map_iter->second->UniqueEntries[tile->second];
-                        success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                        // MapTree nodes to update when loading tile:
-                        std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                        if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) { success = false; }
-                    }
-                    fclose(tilefile);
+                    break;
                 }
             }
-            // break; //test, extract only first map; TODO: remvoe this line
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
+            {
+                /// @todo remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
+            }
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        printf("Creating map tree for map %u...\n", mapId);
+        BIH pTree;
+
+        try
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
-            }
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::GetBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build", e.what());
+            return false;
         }
 
-        //cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i = 0; i < mapSpawns.size(); ++i)
         {
-            delete map_iter->second;
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        }
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
+
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) { success = false; }
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) { success = false; }
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) { success = false; }
+        if (success) { success = pTree.writeToFile(mapfile); }
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) { success = false; }
+
+        for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::writeToFile(mapfile, spawns.UniqueEntries[glob->second]);
         }
+
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap& tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn& spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+            {
+                continue;
+            }
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << '/' << std::setw(3) << mapId << '_';
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
+            if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
+            {
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) { success = false; }
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) { success = false; }
+                // write tile spawns
+                for (uint32 s = 0; s < nSpawns; ++s)
+                {
+                    if (s)
+                    {
+                        ++tile;
+                    }
+                    const ModelSpawn& spawn2 = spawns.UniqueEntries[tile->second];
+                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                    // MapTree nodes to update when loading tile:
+                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) { success = false; }
+                }
+                fclose(tilefile);
+            }
+        }
+
         return success;
     }
 
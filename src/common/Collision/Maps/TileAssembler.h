@@ -20,6 +20,7 @@
 
 #include <G3D/Matrix3.h>
 #include <G3D/Vector3.h>
+#include <functional>
 #include <map>
 #include <set>
 
@@ -97,12 +98,18 @@ namespace VMAP
         G3D::Table<std::string, unsigned int > iUniqueNameIds;
         MapData mapData;
         std::set<std::string> spawnedModelFiles;
+        uint32 iThreads;
+
+        // runs job(0) .. job(count - 1) on iThreads threads, stops handing out jobs once one returns false
+        void runParallel(std::size_t count, std::function<bool(std::size_t)> const& job) const;
 
     public:
-        TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+        TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads = 1);
         virtual ~TileAssembler();
 
         bool convertWorld2();
+        // writes the map tree and tile files of one map, collects the models it spawns
+        bool convertMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles);
         bool readMapSpawns();
         bool calculateTransformedBound(ModelSpawn& spawn);
         void exportGameobjectModels();
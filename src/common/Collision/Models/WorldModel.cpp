@@ -22,6 +22,11 @@
 #include "VMapDefinitions.h"
 #include <array>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define VMAP_SSE_TRIANGLE_INTERSECTION
+#endif
+
 using G3D::Vector3;
 
 template<> struct BoundsTrait<VMAP::GroupModel>
@@ -84,6 +89,98 @@ namespace VMAP
         return false;
     }
 
+#ifdef VMAP_SSE_TRIANGLE_INTERSECTION
+    uint32 IntersectTriangles(std::vector<MeshTriangle>::const_iterator triangles, uint32 const* entries, uint32 count,
+        std::vector<Vector3>::const_iterator points, const G3D::Ray& ray, std::array<float, 4>& distances)
+    {
+        // Lanes hold one triangle each, every step below is the lane wise version of the scalar
+        // expression in IntersectTriangle (same operations in the same order, no fused multiply-add)
+        // so hits and distances are bit identical
+        alignas(16) std::array<std::array<float, 4>, 9> corners;
+        for (uint32 lane = 0; lane < 4; ++lane)
+        {
+            // unused lanes repeat the first triangle and are masked out below
+            MeshTriangle const& tri = triangles[entries[lane < count ? lane : 0]];
+            Vector3 const& p0 = points[tri.idx0];
+            Vector3 const& p1 = points[tri.idx1];
+            Vector3 const& p2 = points[tri.idx2];
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                corners[axis][lane] = p0[axis];
+                corners[3 + axis][lane] = p1[axis];
+                corners[6 + axis][lane] = p2[axis];
+            }
+        }
+
+        auto dot = [](__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+        {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        };
+
+        __m128 const p0x = _mm_load_ps(corners[0].data());
+        __m128 const p0y = _mm_load_ps(corners[1].data());
+        __m128 const p0z = _mm_load_ps(corners[2].data());
+
+        __m128 const e1x = _mm_sub_ps(_mm_load_ps(corners[3].data()), p0x);
+        __m128 const e1y = _mm_sub_ps(_mm_load_ps(corners[4].data()), p0y);
+        __m128 const e1z = _mm_sub_ps(_mm_load_ps(corners[5].data()), p0z);
+        __m128 const e2x = _mm_sub_ps(_mm_load_ps(corners[6].data()), p0x);
+        __m128 const e2y = _mm_sub_ps(_mm_load_ps(corners[7].data()), p0y);
+        __m128 const e2z = _mm_sub_ps(_mm_load_ps(corners[8].data()), p0z);
+
+        __m128 const dx = _mm_set1_ps(ray.direction().x);
+        __m128 const dy = _mm_set1_ps(ray.direction().y);
+        __m128 const dz = _mm_set1_ps(ray.direction().z);
+
+        // p = direction x e2
+        __m128 const px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 const py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 const pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        __m128 const a = dot(e1x, e1y, e1z, px, py, pz);
+
+        __m128 const absA = _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+        __m128 valid = _mm_cmpge_ps(absA, _mm_set1_ps(1e-5f));
+        // NaN determinants pass the scalar (fabs(a) < EPS) check as well
+        valid = _mm_or_ps(valid, _mm_cmpunord_ps(a, a));
+
+        __m128 const f = _mm_div_ps(_mm_set1_ps(1.0f), a);
+        __m128 const sx = _mm_sub_ps(_mm_set1_ps(ray.origin().x), p0x);
+        __m128 const sy = _mm_sub_ps(_mm_set1_ps(ray.origin().y), p0y);
+        __m128 const sz = _mm_sub_ps(_mm_set1_ps(ray.origin().z), p0z);
+        __m128 const u = _mm_mul_ps(f, dot(sx, sy, sz, px, py, pz));
+
+        __m128 const zero = _mm_setzero_ps();
+        __m128 const one = _mm_set1_ps(1.0f);
+        valid = _mm_andnot_ps(_mm_or_ps(_mm_cmplt_ps(u, zero), _mm_cmpgt_ps(u, one)), valid);
+
+        // q = s x e1
+        __m128 const qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        __m128 const qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        __m128 const qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        __m128 const v = _mm_mul_ps(f, dot(dx, dy, dz, qx, qy, qz));
+        valid = _mm_andnot_ps(_mm_or_ps(_mm_cmplt_ps(v, zero), _mm_cmpgt_ps(_mm_add_ps(u, v), one)), valid);
+
+        __m128 const t = _mm_mul_ps(f, dot(e2x, e2y, e2z, qx, qy, qz));
+        valid = _mm_and_ps(valid, _mm_cmpgt_ps(t, zero));
+
+        _mm_storeu_ps(distances.data(), t);
+        return uint32(_mm_movemask_ps(valid)) & ((1u << count) - 1);
+    }
+#else
+    uint32 IntersectTriangles(std::vector<MeshTriangle>::const_iterator triangles, uint32 const* entries, uint32 count,
+        std::vector<Vector3>::const_iterator points, const G3D::Ray& ray, std::array<float, 4>& distances)
+    {
+        uint32 mask = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            distances[i] = G3D::finf();
+            if (IntersectTriangle(triangles[entries[i]], points, ray, distances[i]))
+                mask |= 1 << i;
+        }
+        return mask;
+    }
+#endif
+
     class TriBoundFunc
     {
     public:
@@ -434,6 +531,30 @@ namespace VMAP
             if (result) { hit = true; }
             return hit;
         }
+        // all triangles of a BIH leaf, results are applied in the same order as single triangle calls would
+        bool operator()(const G3D::Ray& ray, uint32 const* entries, uint32 count, float& distance, bool stopAtFirstHit)
+        {
+            if (count == 1)
+                return (*this)(ray, *entries, distance, stopAtFirstHit);
+
+            std::array<float, 4> distances;
+            for (uint32 i = 0; i < count; i += 4)
+            {
+                uint32 batch = std::min<uint32>(count - i, 4);
+                uint32 mask = IntersectTriangles(triangles, entries + i, batch, vertices, ray, distances);
+                for (uint32 j = 0; mask; ++j, mask >>= 1)
+                {
+                    if ((mask & 1) && distances[j] < distance)
+                    {
+                        distance = distances[j];
+                        hit = true;
+                        if (stopAtFirstHit)
+                            return hit;
+                    }
+                }
+            }
+            return hit;
+        }
         std::vector<Vector3>::const_iterator vertices;
         std::vector<MeshTriangle>::const_iterator triangles;
         bool hit;
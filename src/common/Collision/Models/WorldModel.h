@@ -23,6 +23,7 @@
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include <G3D/Vector3.h>
+#include <array>
 
 namespace VMAP
 {
@@ -43,6 +44,14 @@ namespace VMAP
         uint32 idx2{0};
     };
 
+    //! ray/triangle test, updates distance and returns true if the triangle is hit closer than distance
+    bool IntersectTriangle(const MeshTriangle& tri, std::vector<G3D::Vector3>::const_iterator points, const G3D::Ray& ray, float& distance);
+
+    /*! Tests up to 4 triangles at once (SSE on x86-64) with the same floating point operations as IntersectTriangle.
+        Returns a bit mask of the triangles hit in front of the ray origin, their distances are stored in distances */
+    uint32 IntersectTriangles(std::vector<MeshTriangle>::const_iterator triangles, uint32 const* entries, uint32 count,
+        std::vector<G3D::Vector3>::const_iterator points, const G3D::Ray& ray, std::array<float, 4>& distances);
+
     class WmoLiquid
     {
     public:
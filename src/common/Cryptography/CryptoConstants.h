@@ -18,6 +18,8 @@
 #ifndef AZEROTHCORE_CRYPTO_CONSTANTS_H
 #define AZEROTHCORE_CRYPTO_CONSTANTS_H
 
+#include <cstddef>
+
 namespace Acore::Crypto
 {
     struct Constants
@@ -25,12 +25,14 @@
 #include "Banner.h"
 #include "BattlegroundMgr.h"
 #include "BigNumber.h"
+#include "CharacterEnumCache.h"
 #include "CliRunnable.h"
 #include "Common.h"
 #include "Config.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "GitRevision.h"
+#include "GuildMgr.h"
 #include "IoContext.h"
 #include "MapMgr.h"
 #include "Metric.h"
@@ -39,6 +41,7 @@
 #include "MySQLThreading.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvPMgr.h"
+#include "PlayerSaveScheduler.h"
 #include "ProcessPriority.h"
 #include "RASession.h"
 #include "RealmList.h"
@@ -49,6 +52,8 @@
 #include "SharedDefines.h"
 #include "SteadyTimer.h"
 #include "Systemd.h"
+#include "VMapFactory.h"
+#include "VMapMgr2.h"
 #include "World.h"
 #include "WorldSessionMgr.h"
 #include "WorldSocket.h"
@@ -291,6 +296,26 @@ int main(int argc, char** argv)
         METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+        METRIC_VALUE("player_save_queue", uint64(sPlayerSaveScheduler->GetQueueSize(false)), METRIC_TAG("priority", "normal"));
+        METRIC_VALUE("player_save_queue", uint64(sPlayerSaveScheduler->GetQueueSize(true)), METRIC_TAG("priority", "at_risk"));
+
+        uint64 vmapCacheHits, vmapCacheMisses;
+        VMAP::VMapFactory::createOrGetVMapMgr()->GetQueryCacheStats(vmapCacheHits, vmapCacheMisses);
+        METRIC_VALUE("vmap_query_cache", vmapCacheHits, METRIC_TAG("result", "hit"));
+        METRIC_VALUE("vmap_query_cache", vmapCacheMisses, METRIC_TAG("result", "miss"));
+
+        uint64 charEnumCacheHits, charEnumCacheMisses;
+        sCharacterEnumCache->GetStats(charEnumCacheHits, charEnumCacheMisses);
+        METRIC_VALUE("char_enum_cache", charEnumCacheHits, METRIC_TAG("result", "hit"));
+        METRIC_VALUE("char_enum_cache", charEnumCacheMisses, METRIC_TAG("result", "miss"));
+
+        GuildMgr::Stats guildStats = sGuildMgr->GetStats();
+        METRIC_VALUE("guild_mgr", uint64(guildStats.Guilds), METRIC_TAG("type", "guilds"));
+        METRIC_VALUE("guild_mgr", uint64(guildStats.LoadedGuilds), METRIC_TAG("type", "loaded_guilds"));
+        METRIC_VALUE("guild_mgr", uint64(guildStats.LoadedMembers), METRIC_TAG("type", "loaded_members"));
+        METRIC_VALUE("guild_mgr", uint64(guildStats.LoadedBankItems), METRIC_TAG("type", "loaded_bank_items"));
+        METRIC_VALUE("guild_mgr", uint64(guildStats.Loads), METRIC_TAG("type", "loads"));
+        METRIC_VALUE("guild_mgr", uint64(guildStats.Unloads), METRIC_TAG("type", "unloads"));
     });
 
     METRIC_EVENT("events", "Worldserver started", "");
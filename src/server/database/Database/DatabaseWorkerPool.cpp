@@ -234,12 +234,13 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
 }
 
 template <class T>
-SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, std::size_t parallelism /*= 1*/)
 {
-    SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
-    // Store future result before enqueueing - task might get already processed and deleted before returning from this method
-    QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
+    std::vector<SQLQueryHolderTask*> tasks = SQLQueryHolderTask::Split(holder, std::min(parallelism, _connections[IDX_ASYNC].size()));
+    // Store future result before enqueueing - tasks might get already processed and deleted before returning from this method
+    QueryResultHolderFuture result = tasks.front()->GetFuture();
+    for (SQLQueryHolderTask* task : tasks)
+        Enqueue(task);
     return { std::move(holder), std::move(result) };
 }
 
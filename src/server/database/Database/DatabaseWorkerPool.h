@@ -160,7 +160,9 @@ public:
     //! return object as soon as the query is executed.
     //! The return value is then processed in ProcessQueryCallback methods.
     //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-    SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+    //! With parallelism > 1 the queries are split by weight in up to that many operations (never more than there are
+    //! async connections) that run side by side, the result is set once the last of them finished.
+    SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, std::size_t parallelism = 1);
 
     /**
         Transaction context methods.
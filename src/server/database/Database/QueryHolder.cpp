@@ -21,6 +21,7 @@
 #include "MySQLConnection.h"
 #include "PreparedStatement.h"
 #include "QueryResult.h"
+#include <algorithm>
 
 bool SQLQueryHolderBase::SetPreparedQueryImpl(std::size_t index, PreparedStatementBase* stmt)
 {
@@ -70,21 +71,75 @@ void SQLQueryHolderBase::SetSize(std::size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_weights.resize(size, 1);
 }
 
+void SQLQueryHolderBase::SetQueryWeight(std::size_t index, uint32 weight)
+{
+    if (index < m_weights.size())
+        m_weights[index] = weight;
+}
+
+SQLQueryHolderTask::SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
+    : m_holder(std::move(holder)), m_barrier(std::make_shared<SQLQueryHolderBarrier>(1))
+{
+    for (std::size_t i = 0; i < m_holder->m_queries.size(); ++i)
+        m_indexes.push_back(i);
+}
+
+SQLQueryHolderTask::SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder, std::shared_ptr<SQLQueryHolderBarrier> barrier, std::vector<std::size_t> indexes)
+    : m_holder(std::move(holder)), m_barrier(std::move(barrier)), m_indexes(std::move(indexes)) { }
+
 SQLQueryHolderTask::~SQLQueryHolderTask() = default;
 
 bool SQLQueryHolderTask::Execute()
 {
-    /// execute all queries in the holder and pass the results
-    for (std::size_t i = 0; i < m_holder->m_queries.size(); ++i)
+    /// execute the queries of this part and pass the results, parts write to different indexes only
+    for (std::size_t i : m_indexes)
         if (PreparedStatementBase* stmt = m_holder->m_queries[i].first)
             m_holder->SetPreparedResult(i, m_conn->Query(stmt));
 
-    m_result.set_value();
+    if (--m_barrier->Remaining == 0)
+        m_barrier->Result.set_value();
+
     return true;
 }
 
+std::vector<SQLQueryHolderTask*> SQLQueryHolderTask::Split(std::shared_ptr<SQLQueryHolderBase> const& holder, std::size_t parts)
+{
+    std::vector<std::size_t> indexes;
+    for (std::size_t i = 0; i < holder->m_queries.size(); ++i)
+        if (holder->m_queries[i].first)
+            indexes.push_back(i);
+
+    parts = std::max<std::size_t>(std::min(parts, indexes.size()), 1);
+    if (parts == 1)
+        return { new SQLQueryHolderTask(holder) };
+
+    // heaviest first, each one to the lightest part so far
+    std::stable_sort(indexes.begin(), indexes.end(), [&holder](std::size_t left, std::size_t right)
+    {
+        return holder->m_weights[left] > holder->m_weights[right];
+    });
+
+    std::vector<std::vector<std::size_t>> partIndexes(parts);
+    std::vector<uint64> partWeights(parts, 0);
+    for (std::size_t index : indexes)
+    {
+        std::size_t lightest = std::distance(partWeights.begin(), std::min_element(partWeights.begin(), partWeights.end()));
+        partIndexes[lightest].push_back(index);
+        partWeights[lightest] += holder->m_weights[index];
+    }
+
+    std::shared_ptr<SQLQueryHolderBarrier> barrier = std::make_shared<SQLQueryHolderBarrier>(parts);
+    std::vector<SQLQueryHolderTask*> tasks;
+    tasks.reserve(parts);
+    for (std::vector<std::size_t>& part : partIndexes)
+        tasks.push_back(new SQLQueryHolderTask(holder, barrier, std::move(part)));
+
+    return tasks;
+}
+
 bool SQLQueryHolderCallback::InvokeIfReady()
 {
     if (m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
@@ -19,6 +19,7 @@
 #define _QUERYHOLDER_H
 
 #include "SQLOperation.h"
+#include <atomic>
 #include <vector>
 
 class AC_DATABASE_API SQLQueryHolderBase
@@ -32,11 +33,15 @@ public:
     PreparedQueryResult GetPreparedResult(std::size_t index) const;
     void SetPreparedResult(std::size_t index, PreparedResultSet* result);
 
+    // Relative cost of a query (default 1), used to balance the parts of a holder that is run in parallel
+    void SetQueryWeight(std::size_t index, uint32 weight);
+
 protected:
     bool SetPreparedQueryImpl(std::size_t index, PreparedStatementBase* stmt);
 
 private:
     std::vector<std::pair<PreparedStatementBase*, PreparedQueryResult>> m_queries;
+    std::vector<uint32> m_weights;
 };
 
 template<typename T>
@@ -49,20 +54,35 @@ public:
     }
 };
 
+//- Shared by the tasks a holder was split into, the last one to finish sets the result
+struct SQLQueryHolderBarrier
+{
+    explicit SQLQueryHolderBarrier(std::size_t parts) : Remaining(parts) { }
+
+    std::atomic<std::size_t> Remaining;
+    QueryResultHolderPromise Result;
+};
+
 class AC_DATABASE_API SQLQueryHolderTask : public SQLOperation
 {
 public:
-    explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
-        : m_holder(std::move(holder)) { }
+    explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder);
+    SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder, std::shared_ptr<SQLQueryHolderBarrier> barrier, std::vector<std::size_t> indexes);
 
     ~SQLQueryHolderTask();
 
     bool Execute() override;
-    QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
+
+    // Only to be called on one of the tasks of a split holder
+    QueryResultHolderFuture GetFuture() { return m_barrier->Result.get_future(); }
+
+    // Spreads the queries of the holder over up to parts tasks of about the same weight
+    static std::vector<SQLQueryHolderTask*> Split(std::shared_ptr<SQLQueryHolderBase> const& holder, std::size_t parts);
 
 private:
     std::shared_ptr<SQLQueryHolderBase> m_holder;
-    QueryResultHolderPromise m_result;
+    std::shared_ptr<SQLQueryHolderBarrier> m_barrier;
+    std::vector<std::size_t> m_indexes;
 };
 
 class AC_DATABASE_API SQLQueryHolderCallback
@@ -93,6 +93,110 @@ void TransactionBase::Cleanup()
     _cleanedUp = true;
 }
 
+namespace
+{
+    // 64 bit FNV-1a
+    constexpr uint64 DIGEST_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64 DIGEST_PRIME = 1099511628211ULL;
+
+    void DigestBytes(uint64& digest, void const* data, std::size_t size)
+    {
+        uint8 const* bytes = static_cast<uint8 const*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            digest ^= bytes[i];
+            digest *= DIGEST_PRIME;
+        }
+    }
+
+    template<typename T>
+    void DigestValue(uint64& digest, T const& value)
+    {
+        DigestBytes(digest, &value, sizeof(T));
+    }
+
+    // calls visitor(data, size) with the raw bytes of a bound parameter
+    template<typename Visitor>
+    void VisitParameterBytes(PreparedStatementData const& parameter, Visitor&& visitor)
+    {
+        std::visit([&](auto const& value)
+        {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8>>)
+                visitor(value.data(), value.size());
+            else if constexpr (std::is_same_v<T, std::nullptr_t>)
+                visitor(nullptr, 0);
+            else
+                visitor(&value, sizeof(T));
+        }, parameter.data);
+    }
+}
+
+std::size_t TransactionBase::GetPayloadSize(std::size_t first /*= 0*/) const
+{
+    std::size_t size = 0;
+    for (std::size_t i = first; i < m_queries.size(); ++i)
+    {
+        SQLElementData const& data = m_queries[i];
+        if (data.type == SQL_ELEMENT_RAW)
+        {
+            size += std::get<std::string>(data.element).size();
+            continue;
+        }
+
+        for (PreparedStatementData const& parameter : std::get<PreparedStatementBase*>(data.element)->GetParameters())
+            VisitParameterBytes(parameter, [&size](void const* /*bytes*/, std::size_t count) { size += count; });
+    }
+
+    return size;
+}
+
+uint64 TransactionBase::GetDigest(std::size_t first /*= 0*/) const
+{
+    uint64 digest = DIGEST_OFFSET_BASIS;
+    for (std::size_t i = first; i < m_queries.size(); ++i)
+    {
+        SQLElementData const& data = m_queries[i];
+        DigestValue(digest, uint8(data.type));
+        if (data.type == SQL_ELEMENT_RAW)
+        {
+            std::string const& sql = std::get<std::string>(data.element);
+            DigestValue(digest, sql.size());
+            DigestBytes(digest, sql.data(), sql.size());
+            continue;
+        }
+
+        PreparedStatementBase const* stmt = std::get<PreparedStatementBase*>(data.element);
+        DigestValue(digest, stmt->GetIndex());
+        for (PreparedStatementData const& parameter : stmt->GetParameters())
+        {
+            // the type takes part too, so uint32(1) and uint8(1) do not collide
+            DigestValue(digest, uint8(parameter.data.index()));
+            VisitParameterBytes(parameter, [&digest](void const* bytes, std::size_t count)
+            {
+                DigestValue(digest, count);
+                DigestBytes(digest, bytes, count);
+            });
+        }
+    }
+
+    return digest;
+}
+
+void TransactionBase::Truncate(std::size_t size)
+{
+    ASSERT(!_cleanedUp);
+
+    while (m_queries.size() > size)
+    {
+        SQLElementData& data = m_queries.back();
+        if (data.type == SQL_ELEMENT_PREPARED)
+            delete std::get<PreparedStatementBase*>(data.element);
+
+        m_queries.pop_back();
+    }
+}
+
 bool TransactionTask::Execute()
 {
     int errorCode = TryExecute();
@@ -49,6 +49,15 @@ public:
 
     [[nodiscard]] std::size_t GetSize() const { return m_queries.size(); }
 
+    // Bytes carried by the statements from index first on: raw query text and bound parameter values
+    [[nodiscard]] std::size_t GetPayloadSize(std::size_t first = 0) const;
+
+    // Hash of the statements from index first on, the same statements bound to the same values hash the same
+    [[nodiscard]] uint64 GetDigest(std::size_t first = 0) const;
+
+    // Drops the statements from index size on
+    void Truncate(std::size_t size);
+
 protected:
     void AppendPreparedStatement(PreparedStatementBase* statement);
     void Cleanup();
@@ -59,6 +59,7 @@ SmartScript::SmartScript()
     isProcessingTimedActionList = false;
     mCurrentPriority = 0;
     mEventSortingRequired = false;
+    mEventIndexesDirty = false;
     _allowPhaseReset = true;
 }
 
@@ -134,27 +135,30 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_AC_END)//special handling
+        return;
+
+    if (mEventIndexesDirty)
+        BuildEventIndexes();
+
+    // only the events of the raised type, in mEvents order
+    std::vector<uint32> const& events = mEventsByType[e];
+    for (std::size_t i = 0; i < events.size(); ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        SmartScriptHolder& holder = mEvents[events[i]];
 
-        if (eventType == e)
-        {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent((*i).entryOrGuid, (*i).event_id, (*i).source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
+        ConditionList conds = sConditionMgr->GetConditionsForSmartEvent(holder.entryOrGuid, holder.event_id, holder.source_type);
+        ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+        if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+        {
+            ASSERT(executionStack.empty());
+            executionStack.emplace_back(SmartScriptFrame{ holder, unit, var0, var1, bvar, spell, gob });
+            while (!executionStack.empty())
             {
-                ASSERT(executionStack.empty());
-                executionStack.emplace_back(SmartScriptFrame{ *i, unit, var0, var1, bvar, spell, gob });
-                while (!executionStack.empty())
-                {
-                    auto [stack_holder , stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
-                    executionStack.pop_back();
-                    ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
-                }
+                auto [stack_holder , stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
+                executionStack.pop_back();
+                ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
             }
         }
     }
@@ -4853,6 +4857,41 @@ void SmartScript::InitTimer(SmartScriptHolder& e)
             break;
     }
 }
+bool SmartScript::IsTimedEvent(uint32 eventType)
+{
+    switch (eventType)
+    {
+        case SMART_EVENT_NEAR_PLAYERS:
+        case SMART_EVENT_NEAR_PLAYERS_NEGATION:
+        case SMART_EVENT_NEAR_UNIT:
+        case SMART_EVENT_NEAR_UNIT_NEGATION:
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALTH_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_AREA_RANGE:
+        case SMART_EVENT_VICTIM_CASTING:
+        case SMART_EVENT_AREA_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+        case SMART_EVENT_FRIENDLY_HEALTH_PCT:
+        case SMART_EVENT_DISTANCE_CREATURE:
+        case SMART_EVENT_DISTANCE_GAMEOBJECT:
+        case SMART_EVENT_IS_IN_MELEE_RANGE:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
 {
     // min/max was checked at loading!
@@ -4897,57 +4936,29 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         } // @TODO: Can't these be handled by the action themselves instead? Less expensive
 
         e.active = true;//activate events with cooldown
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_NEAR_PLAYERS:
-            case SMART_EVENT_NEAR_PLAYERS_NEGATION:
-            case SMART_EVENT_NEAR_UNIT:
-            case SMART_EVENT_NEAR_UNIT_NEGATION:
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALTH_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_AREA_RANGE:
-            case SMART_EVENT_VICTIM_CASTING:
-            case SMART_EVENT_AREA_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            case SMART_EVENT_FRIENDLY_HEALTH_PCT:
-            case SMART_EVENT_DISTANCE_CREATURE:
-            case SMART_EVENT_DISTANCE_GAMEOBJECT:
-            case SMART_EVENT_IS_IN_MELEE_RANGE:
-                {
-                    ASSERT(executionStack.empty());
-                    executionStack.emplace_back(SmartScriptFrame{ e, nullptr, 0, 0, false, nullptr, nullptr });
-                    while (!executionStack.empty())
-                    {
-                        auto [stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
-                        executionStack.pop_back();
-                        ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
-                    }
-                    if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+        if (IsTimedEvent(e.GetEventType()))//process ONLY timed events
+        {
+            ASSERT(executionStack.empty());
+            executionStack.emplace_back(SmartScriptFrame{ e, nullptr, 0, 0, false, nullptr, nullptr });
+            while (!executionStack.empty())
+            {
+                auto [stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
+                executionStack.pop_back();
+                ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
+            }
+            if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+            {
+                e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
+                {
+                    //find the first event which is not the current one and enable it
+                    if (i->event_id > e.event_id)
                     {
-                        e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                        for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
-                        {
-                            //find the first event which is not the current one and enable it
-                            if (i->event_id > e.event_id)
-                            {
-                                i->enableTimed = true;
-                                break;
-                            }
-                        }
+                        i->enableTimed = true;
+                        break;
                     }
-                    break;
                 }
+            }
         }
 
         if (e.priority != SmartScriptHolder::DEFAULT_PRIORITY)
@@ -4979,6 +4990,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        mEventIndexesDirty = true;
     }
 }
 
@@ -4995,8 +5007,19 @@ void SmartScript::OnUpdate(uint32 const diff)
         mEventSortingRequired = false;
     }
 
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        UpdateTimer(*i, diff);
+    if (mEventIndexesDirty)
+        BuildEventIndexes();
+
+    for (std::size_t i = 0; i < mUpdatableEvents.size(); ++i)
+    {
+        SmartScriptHolder& holder = mEvents[mUpdatableEvents[i].Index];
+
+        // nothing to count down and nothing to process, UpdateTimer would not change anything
+        if (mUpdatableEvents[i].CooldownOnly && !holder.timer && holder.active && holder.priority == SmartScriptHolder::DEFAULT_PRIORITY)
+            continue;
+
+        UpdateTimer(holder, diff);
+    }
 
     if (!mStoredEvents.empty())
     {
@@ -5053,6 +5076,33 @@ void SmartScript::OnUpdate(uint32 const diff)
 void SmartScript::SortEvents(SmartAIEventList& events)
 {
     std::sort(events.begin(), events.end());
+
+    if (&events == &mEvents)
+        mEventIndexesDirty = true;
+}
+
+void SmartScript::BuildEventIndexes()
+{
+    for (std::vector<uint32>& events : mEventsByType)
+        events.clear();
+
+    mUpdatableEvents.clear();
+
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        SmartScriptHolder const& e = mEvents[i];
+        uint32 eventType = e.GetEventType();
+        if (eventType == SMART_EVENT_LINK || eventType >= SMART_EVENT_AC_END)
+            continue;
+
+        mEventsByType[eventType].push_back(i);
+
+        // events which are neither timed nor delayed while casting only need an update while on cooldown
+        bool cooldownOnly = !IsTimedEvent(eventType) && e.GetActionType() != SMART_ACTION_CAST && e.GetActionType() != SMART_ACTION_FLEE_FOR_ASSIST;
+        mUpdatableEvents.push_back({ i, cooldownOnly });
+    }
+
+    mEventIndexesDirty = false;
 }
 
 void SmartScript::RaisePriority(SmartScriptHolder& e)
@@ -5110,6 +5160,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    mEventIndexesDirty = true;
 }
 
 void SmartScript::GetScript()
@@ -23,6 +23,7 @@
 #include "SmartScriptMgr.h"
 #include "Spell.h"
 #include "Unit.h"
+#include <array>
 #include <deque>
 
 class SmartScript
@@ -52,6 +53,7 @@ public:
     static void RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max);
     void UpdateTimer(SmartScriptHolder& e, uint32 const diff);
     static void InitTimer(SmartScriptHolder& e);
+    static bool IsTimedEvent(uint32 eventType);
     void ProcessAction(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     void GetTargets(ObjectVector& targets, SmartScriptHolder const& e, WorldObject* invoker = nullptr) const;
@@ -216,6 +218,7 @@ private:
     bool IsInPhase(uint32 p) const;
 
     void SortEvents(SmartAIEventList& events);
+    void BuildEventIndexes();
     void RaisePriority(SmartScriptHolder& e);
     void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
@@ -243,6 +246,17 @@ private:
     uint32 mCurrentPriority;
     bool mEventSortingRequired;
 
+    // Positions in mEvents, kept in mEvents order and rebuilt whenever mEvents is filled or sorted
+    struct UpdatableEvent
+    {
+        uint32 Index;
+        bool CooldownOnly; // UpdateTimer only counts down its cooldown, nothing to do while it is ready
+    };
+
+    std::array<std::vector<uint32>, SMART_EVENT_AC_END> mEventsByType;
+    std::vector<UpdatableEvent> mUpdatableEvents;
+    bool mEventIndexesDirty;
+
     // Xinef: misc
     bool _allowPhaseReset;
 
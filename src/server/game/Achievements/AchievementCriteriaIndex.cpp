@@ -0,0 +1,142 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AchievementCriteriaIndex.h"
+#include "DBCStructure.h"
+#include <algorithm>
+
+bool AchievementCriteriaIndex::GetPrimaryAsset(AchievementCriteriaEntry const* criteria, uint32& asset)
+{
+    switch (criteria->requiredType)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+            asset = criteria->kill_creature.creatureID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_BG:
+            asset = criteria->win_bg.bgMapID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+            asset = criteria->reach_skill_level.skillID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT:
+            asset = criteria->complete_achievement.linkedAchievement;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+            asset = criteria->complete_quests_in_zone.zoneID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_BATTLEGROUND:
+            asset = criteria->complete_battleground.mapID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+            asset = criteria->killed_by_creature.creatureEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+            asset = criteria->complete_quest.questID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+            asset = criteria->be_spell_target.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+            asset = criteria->cast_spell.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+            asset = criteria->bg_objective.objectiveId;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+            asset = criteria->honorable_kill_at_area.areaID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+            asset = criteria->learn_spell.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+            asset = criteria->own_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+            asset = criteria->learn_skill_level.skillID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+            asset = criteria->use_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+            asset = criteria->own_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+            asset = criteria->gain_reputation.factionID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
+            asset = criteria->equip_epic_item.itemSlot;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+            asset = criteria->hk_class.classID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+            asset = criteria->hk_race.raceID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+            asset = criteria->do_emote.emoteID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+            asset = criteria->equip_item.itemID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+            asset = criteria->use_gameobject.goEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+            asset = criteria->be_spell_target.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+            asset = criteria->fish_in_gameobject.goEntry;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+            asset = criteria->learn_skillline_spell.skillLine;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+            asset = criteria->loot_type.lootType;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+            asset = criteria->cast_spell.spellID;
+            return true;
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            asset = criteria->learn_skill_line.skillLine;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool AchievementCriteriaIndex::Add(AchievementCriteriaEntry const* criteria)
+{
+    uint32 asset;
+    if (!GetPrimaryAsset(criteria, asset))
+        return false;
+
+    Add(criteria->requiredType, asset, criteria);
+    return true;
+}
+
+void AchievementFinishedCriteria::Insert(uint32 criteriaId, std::size_t criteriaCount)
+{
+    if (criteriaId >= _finished.size())
+        _finished.resize(std::max<std::size_t>(criteriaCount, criteriaId + 1));
+
+    _finished[criteriaId] = true;
+}
+
+bool AchievementFinishedCriteria::CanBeFinished(AchievementEntry const* achievement)
+{
+    return !(achievement->flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL));
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ACORE_ACHIEVEMENT_CRITERIA_INDEX_H
+#define __ACORE_ACHIEVEMENT_CRITERIA_INDEX_H
+
+#include "DBCEnums.h"
+#include "Define.h"
+#include <unordered_map>
+#include <vector>
+
+struct AchievementCriteriaEntry;
+struct AchievementEntry;
+
+typedef std::vector<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
+
+/**
+ * @brief Criteria grouped by their type and primary asset (creature, quest, item, spell...).
+ *
+ * UpdateAchievementCriteria looks up the criteria of one (type, asset) pair on every kill, loot or
+ * quest event, so the lookup is a single hash probe and the matching criteria are stored next to
+ * each other. Filled once at startup, read only afterwards.
+ */
+class AchievementCriteriaIndex
+{
+public:
+    void Add(uint32 type, uint32 asset, AchievementCriteriaEntry const* criteria)
+    {
+        _criteria[MakeKey(type, asset)].push_back(criteria);
+    }
+
+    // Adds the criteria under its primary asset, false for types without one (explored areas are added by the caller)
+    bool Add(AchievementCriteriaEntry const* criteria);
+
+    // The asset UpdateAchievementCriteria passes as miscValue1 for that criteria type
+    static bool GetPrimaryAsset(AchievementCriteriaEntry const* criteria, uint32& asset);
+
+    void Clear() { _criteria.clear(); }
+
+    // Criteria of that type using that asset, nullptr if there are none
+    [[nodiscard]] AchievementCriteriaEntryList const* Find(AchievementCriteriaTypes type, uint32 asset) const
+    {
+        auto itr = _criteria.find(MakeKey(type, asset));
+        return itr != _criteria.end() ? &itr->second : nullptr;
+    }
+
+    [[nodiscard]] std::size_t GetAssetCount() const { return _criteria.size(); }
+
+private:
+    static uint64 MakeKey(uint32 type, uint32 asset) { return (uint64(type) << 32) | asset; }
+
+    std::unordered_map<uint64, AchievementCriteriaEntryList> _criteria;
+};
+
+/**
+ * @brief Criteria of one player that can never progress again: their achievement and every achievement
+ * referencing it are completed. UpdateAchievementCriteria skips them before any other check.
+ */
+class AchievementFinishedCriteria
+{
+public:
+    [[nodiscard]] bool Contains(uint32 criteriaId) const { return criteriaId < _finished.size() && _finished[criteriaId]; }
+
+    // criteriaCount sizes the set once for all criteria ids
+    void Insert(uint32 criteriaId, std::size_t criteriaCount);
+    void Clear() { _finished.clear(); }
+
+    // someone else may complete a realm first before the player does, those criteria are never finished for good
+    static bool CanBeFinished(AchievementEntry const* achievement);
+
+private:
+    std::vector<bool> _finished;
+};
+
+#endif
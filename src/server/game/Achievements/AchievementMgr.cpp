@@ -507,6 +507,7 @@ void AchievementMgr::Reset()
 
     _completedAchievements.clear();
     _criteriaProgress.clear();
+    _finishedCriteria.Clear();
     DeleteFromDB(_player->GetGUID().GetCounter());
 
     // re-fill data
@@ -887,9 +888,12 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
 
     sScriptMgr->OnBeforeCheckCriteria(this, achievementCriteriaList);
 
-    for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList->begin(); i != achievementCriteriaList->end(); ++i)
+    for (AchievementCriteriaEntry const* achievementCriteria : *achievementCriteriaList)
     {
-        AchievementCriteriaEntry const* achievementCriteria = (*i);
+        // cheap skip for criteria of achievements done for good
+        if (_finishedCriteria.Contains(achievementCriteria->ID))
+            continue;
+
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
         if (!achievement)
             continue;
@@ -1853,7 +1857,13 @@ bool AchievementMgr::IsCompletedCriteria(AchievementCriteriaEntry const* achieve
                 }
 
         if (completed)
+        {
+            // nothing brings a finished achievement back, realm firsts excepted
+            if (AchievementFinishedCriteria::CanBeFinished(achievement))
+                _finishedCriteria.Insert(achievementCriteria->ID, sAchievementCriteriaStore.GetNumRows());
+
             return true;
+        }
     }
 
     CriteriaProgress const* progress = GetCriteriaProgress(achievementCriteria);
@@ -2644,116 +2654,22 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
                 criteria->additionalRequirements[1].additionalRequirement_type != criteria->additionalRequirements[0].additionalRequirement_type)
             _achievementCriteriasByCondition[criteria->additionalRequirements[1].additionalRequirement_type][criteria->additionalRequirements[1].additionalRequirement_value].push_back(criteria);
 
-        switch (criteria->requiredType)
+        // explored areas are indexed under every area of their world map overlay
+        if (!_specialList.Add(criteria) && criteria->requiredType == ACHIEVEMENT_CRITERIA_TYPE_EXPLORE_AREA)
         {
-            case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
-                _specialList[criteria->requiredType][criteria->kill_creature.creatureID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_WIN_BG:
-                _specialList[criteria->requiredType][criteria->win_bg.bgMapID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
-                _specialList[criteria->requiredType][criteria->reach_skill_level.skillID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT:
-                _specialList[criteria->requiredType][criteria->complete_achievement.linkedAchievement].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
-                _specialList[criteria->requiredType][criteria->complete_quests_in_zone.zoneID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_BATTLEGROUND:
-                _specialList[criteria->requiredType][criteria->complete_battleground.mapID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
-                _specialList[criteria->requiredType][criteria->killed_by_creature.creatureEntry].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
-                _specialList[criteria->requiredType][criteria->complete_quest.questID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
-                _specialList[criteria->requiredType][criteria->be_spell_target.spellID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
-                _specialList[criteria->requiredType][criteria->cast_spell.spellID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
-                _specialList[criteria->requiredType][criteria->bg_objective.objectiveId].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
-                _specialList[criteria->requiredType][criteria->honorable_kill_at_area.areaID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
-                _specialList[criteria->requiredType][criteria->learn_spell.spellID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
-                _specialList[criteria->requiredType][criteria->own_item.itemID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
-                _specialList[criteria->requiredType][criteria->learn_skill_level.skillID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
-                _specialList[criteria->requiredType][criteria->use_item.itemID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
-                _specialList[criteria->requiredType][criteria->own_item.itemID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_EXPLORE_AREA:
-                {
-                    WorldMapOverlayEntry const* worldOverlayEntry = sWorldMapOverlayStore.LookupEntry(criteria->explore_area.areaReference);
-                    if (!worldOverlayEntry)
-                        break;
-
-                    for (uint8 j = 0; j < MAX_WORLD_MAP_OVERLAY_AREA_IDX; ++j)
-                        if (worldOverlayEntry->areatableID[j])
-                        {
-                            bool valid = true;
-                            for (uint8 i = 0; i < j; ++i)
-                                if (worldOverlayEntry->areatableID[j] == worldOverlayEntry->areatableID[i])
-                                    valid = false;
-                            if (valid)
-                                _specialList[criteria->requiredType][worldOverlayEntry->areatableID[j]].push_back(criteria);
-                        }
-                }
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
-                _specialList[criteria->requiredType][criteria->gain_reputation.factionID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
-                _specialList[criteria->requiredType][criteria->equip_epic_item.itemSlot].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
-                _specialList[criteria->requiredType][criteria->hk_class.classID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
-                _specialList[criteria->requiredType][criteria->hk_race.raceID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
-                _specialList[criteria->requiredType][criteria->do_emote.emoteID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
-                _specialList[criteria->requiredType][criteria->equip_item.itemID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
-                _specialList[criteria->requiredType][criteria->use_gameobject.goEntry].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
-                _specialList[criteria->requiredType][criteria->be_spell_target.spellID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
-                _specialList[criteria->requiredType][criteria->fish_in_gameobject.goEntry].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
-                _specialList[criteria->requiredType][criteria->learn_skillline_spell.skillLine].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
-                _specialList[criteria->requiredType][criteria->loot_type.lootType].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
-                _specialList[criteria->requiredType][criteria->cast_spell.spellID].push_back(criteria);
-                break;
-            case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
-                _specialList[criteria->requiredType][criteria->learn_skill_line.skillLine].push_back(criteria);
-                break;
+            if (WorldMapOverlayEntry const* worldOverlayEntry = sWorldMapOverlayStore.LookupEntry(criteria->explore_area.areaReference))
+            {
+                for (uint8 j = 0; j < MAX_WORLD_MAP_OVERLAY_AREA_IDX; ++j)
+                    if (worldOverlayEntry->areatableID[j])
+                    {
+                        bool valid = true;
+                        for (uint8 i = 0; i < j; ++i)
+                            if (worldOverlayEntry->areatableID[j] == worldOverlayEntry->areatableID[i])
+                                valid = false;
+                        if (valid)
+                            _specialList.Add(criteria->requiredType, worldOverlayEntry->areatableID[j], criteria);
+                    }
+            }
         }
 
         if (criteria->timeLimit)
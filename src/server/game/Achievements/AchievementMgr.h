@@ -18,6 +18,7 @@
 #ifndef __ACORE_ACHIEVEMENTMGR_H
 #define __ACORE_ACHIEVEMENTMGR_H
 
+#include "AchievementCriteriaIndex.h"
 #include "Common.h"
 #include "DBCEnums.h"
 #include "DBCStores.h"
@@ -26,7 +27,6 @@
 #include <map>
 #include <string>
 
-typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::unordered_map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
@@ -338,6 +338,7 @@ private:
     CompletedAchievementMap _completedAchievements;
     typedef std::map<uint32, uint32> TimedAchievementMap;
     TimedAchievementMap _timedAchievements;      // Criteria id/time left in MS
+    AchievementFinishedCriteria _finishedCriteria;   // cleared by Reset only
 
     // Offline updates cannot be processed while players are loading,
     // as the player will not be notified of the changes.
@@ -363,11 +364,9 @@ public:
         return &_achievementCriteriasByType[type];
     }
 
-    AchievementCriteriaEntryList const* GetSpecialAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 val)
+    [[nodiscard]] AchievementCriteriaEntryList const* GetSpecialAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 val) const
     {
-        if (_specialList[type].find(val) != _specialList[type].end())
-            return &_specialList[type][val];
-        return nullptr;
+        return _specialList.Find(type, val);
     }
 
     AchievementCriteriaEntryList const* GetAchievementCriteriaByCondition(AchievementCriteriaCondition condition, uint32 val)
@@ -444,7 +443,7 @@ private:
     AchievementRewardLocales _achievementRewardLocales;
 
     // pussywizard:
-    std::map<uint32, AchievementCriteriaEntryList> _specialList[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+    AchievementCriteriaIndex _specialList;
     std::map<uint32, AchievementCriteriaEntryList> _achievementCriteriasByCondition[ACHIEVEMENT_CRITERIA_CONDITION_TOTAL];
 };
 
@@ -29,6 +29,7 @@
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "ScriptMgr.h"
+#include <limits>
 #include <unordered_map>
 
 #include "BattlegroundUtils.h"
@@ -58,6 +59,10 @@ BattlegroundQueue::~BattlegroundQueue()
     m_events.KillAllEvents(false);
 
     m_QueuedPlayers.clear();
+    for (auto& bracketIndex : m_RatedArenaIndex)
+        for (auto& teamIndex : bracketIndex)
+            teamIndex.Clear();
+
     for (auto& m_QueuedGroup : m_QueuedGroups)
     {
         for (auto& j : m_QueuedGroup)
@@ -126,6 +131,92 @@ bool BattlegroundQueue::SelectionPool::AddGroup(GroupQueueInfo* ginfo, uint32 de
     return PlayerCount < desiredCount;
 }
 
+/*********************************************************/
+/***          RATED ARENA QUEUE RATING INDEX           ***/
+/*********************************************************/
+
+void BattlegroundQueue::RatedArenaIndex::Insert(GroupQueueInfo* ginfo)
+{
+    if (_entries.find(ginfo) != _entries.end())
+        return;
+
+    uint64 order = _nextOrder++;
+    _byJoinOrder.emplace(order, ginfo);
+    _entries[ginfo] = { order, _byRating.emplace(ginfo->ArenaMatchmakerRating, order) };
+}
+
+void BattlegroundQueue::RatedArenaIndex::Remove(GroupQueueInfo const* ginfo)
+{
+    auto itr = _entries.find(ginfo);
+    if (itr == _entries.end())
+        return;
+
+    _byJoinOrder.erase(itr->second.Order);
+    _byRating.erase(itr->second.RatingItr);
+    _entries.erase(itr);
+}
+
+void BattlegroundQueue::RatedArenaIndex::Clear()
+{
+    _byJoinOrder.clear();
+    _byRating.clear();
+    _entries.clear();
+}
+
+GroupQueueInfo* BattlegroundQueue::RatedArenaIndex::FindFirst(uint32 minRating, uint32 maxRating, int32 discardTime, GroupQueueInfo const* from /*= nullptr*/, MatchPredicate const& predicate /*= nullptr*/) const
+{
+    uint64 fromOrder = 0;
+    if (from)
+    {
+        auto itr = _entries.find(from);
+        if (itr == _entries.end())
+            return nullptr;
+
+        fromOrder = itr->second.Order;
+    }
+
+    auto IsMatch = [&predicate](GroupQueueInfo const* ginfo)
+    {
+        return !ginfo->IsInvitedToBGInstanceGUID && (!predicate || predicate(ginfo));
+    };
+
+    uint64 bestOrder = std::numeric_limits<uint64>::max();
+
+    // groups are indexed in join order, so the ones whose rating is already discarded form a prefix
+    for (auto itr = _byJoinOrder.lower_bound(fromOrder); itr != _byJoinOrder.end() && int32(itr->second->JoinTime) < discardTime; ++itr)
+    {
+        if (IsMatch(itr->second))
+        {
+            bestOrder = itr->first;
+            break;
+        }
+    }
+
+    // then look for an earlier group inside the rating window
+    for (auto itr = _byRating.lower_bound(minRating); itr != _byRating.end() && itr->first <= maxRating; ++itr)
+    {
+        if (itr->second < fromOrder || itr->second >= bestOrder)
+            continue;
+
+        if (IsMatch(_byJoinOrder.find(itr->second)->second))
+            bestOrder = itr->second;
+    }
+
+    if (bestOrder == std::numeric_limits<uint64>::max())
+        return nullptr;
+
+    return _byJoinOrder.find(bestOrder)->second;
+}
+
+void BattlegroundQueue::RemoveFromRatedArenaIndex(GroupQueueInfo const* ginfo)
+{
+    if (!ginfo->IsRated || ginfo->BracketId >= MAX_BATTLEGROUND_BRACKETS)
+        return;
+
+    for (auto& teamIndex : m_RatedArenaIndex[ginfo->BracketId])
+        teamIndex.Remove(ginfo);
+}
+
 /*********************************************************/
 /***               BATTLEGROUND QUEUES                 ***/
 /*********************************************************/
@@ -193,6 +284,10 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* group, Battle
     //add GroupInfo to m_QueuedGroups
     m_QueuedGroups[bracketId][index].push_back(ginfo);
 
+    // rated arena teams are also indexed by matchmaker rating
+    if (isRated && index < BG_QUEUE_NORMAL_ALLIANCE)
+        m_RatedArenaIndex[bracketId][index].Insert(ginfo);
+
     // announce world (this doesn't need mutex)
     SendJoinMessageArenaQueue(leader, ginfo, bracketEntry, isRated);
 
@@ -338,6 +433,7 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove group queue info no players left
     if (groupInfo->Players.empty())
     {
+        RemoveFromRatedArenaIndex(groupInfo);
         m_QueuedGroups[_bracketId][_groupType].erase(group_itr);
         delete groupInfo;
         return;
@@ -869,25 +965,17 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
         int32 discardOpponentsTime = GameTime::GetGameTimeMS().count() - sWorld->getIntConfig(CONFIG_ARENA_PREV_OPPONENTS_DISCARD_TIMER);
 
         // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[PVP_TEAMS_COUNT];
+        GroupQueueInfo* teams[PVP_TEAMS_COUNT] = { nullptr, nullptr };
         uint8 found = 0;
         uint8 team = 0;
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
         {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
+            // take the group that joined first and matches conditions
+            if (GroupQueueInfo* ginfo = m_RatedArenaIndex[bracket_id][i].FindFirst(arenaMinRating, arenaMaxRating, discardTime))
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
+                teams[found++] = ginfo;
+                team = i;
             }
         }
 
@@ -896,24 +984,22 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
 
         if (found == 1)
         {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
+            GroupQueueInfo const* first = teams[0];
+            auto CanFaceFirstTeam = [first, discardOpponentsTime](GroupQueueInfo const* ginfo)
             {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating) || (int32)(*itr3)->JoinTime < discardTime)
-                    && ((*(itr_teams[0]))->ArenaTeamId != (*itr3)->PreviousOpponentsTeamId || ((int32)(*itr3)->JoinTime < discardOpponentsTime))
-                    && (*(itr_teams[0]))->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
-            }
+                return (first->ArenaTeamId != ginfo->PreviousOpponentsTeamId || (int32)ginfo->JoinTime < discardOpponentsTime)
+                    && first->ArenaTeamId != ginfo->ArenaTeamId;
+            };
+
+            if (GroupQueueInfo* ginfo = m_RatedArenaIndex[bracket_id][team].FindFirst(arenaMinRating, arenaMaxRating, discardTime, first, CanFaceFirstTeam))
+                teams[found++] = ginfo;
         }
 
         //if we have 2 teams, then start new arena and invite players!
         if (found == 2)
         {
-            GroupQueueInfo* aTeam = *(itr_teams[TEAM_ALLIANCE]);
-            GroupQueueInfo* hTeam = *(itr_teams[TEAM_HORDE]);
+            GroupQueueInfo* aTeam = teams[TEAM_ALLIANCE];
+            GroupQueueInfo* hTeam = teams[TEAM_HORDE];
 
             Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
@@ -930,19 +1016,25 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
             LOG_DEBUG("bg.battleground", "setting oposite teamrating for team {} to {}", aTeam->ArenaTeamId, aTeam->OpponentsTeamRating);
             LOG_DEBUG("bg.battleground", "setting oposite teamrating for team {} to {}", hTeam->ArenaTeamId, hTeam->OpponentsTeamRating);
 
+            // both teams leave the rating index, they are not looking for a match anymore
+            m_RatedArenaIndex[bracket_id][TEAM_ALLIANCE].Remove(aTeam);
+            m_RatedArenaIndex[bracket_id][TEAM_HORDE].Remove(aTeam);
+            m_RatedArenaIndex[bracket_id][TEAM_ALLIANCE].Remove(hTeam);
+            m_RatedArenaIndex[bracket_id][TEAM_HORDE].Remove(hTeam);
+
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
             if (aTeam->teamId != TEAM_ALLIANCE)
             {
                 aTeam->GroupType = BG_QUEUE_PREMADE_ALLIANCE;
+                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].remove(aTeam);
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
             }
 
             if (hTeam->teamId != TEAM_HORDE)
             {
                 hTeam->GroupType = BG_QUEUE_PREMADE_HORDE;
+                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].remove(hTeam);
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
             }
 
             arena->SetArenaMatchmakerRating(TEAM_ALLIANCE, aTeam->ArenaMatchmakerRating);
@@ -1229,6 +1321,7 @@ void BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
 
     // set invitation
     ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
+    RemoveFromRatedArenaIndex(ginfo);
 
     BattlegroundTypeId bgTypeId = bg->GetBgTypeID();
     BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(ginfo->BgTypeId, ginfo->ArenaType);
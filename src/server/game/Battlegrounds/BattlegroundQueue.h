@@ -24,6 +24,9 @@
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
 #include <array>
+#include <functional>
+#include <map>
+#include <unordered_map>
 
 constexpr auto COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME = 10;
 
@@ -125,10 +128,49 @@ public:
     //one selection pool for horde, other one for alliance
     SelectionPool m_SelectionPools[PVP_TEAMS_COUNT];
 
+    // rating ordered index of rated arena groups waiting for a match (invited groups are not indexed)
+    class RatedArenaIndex
+    {
+    public:
+        typedef std::function<bool(GroupQueueInfo const*)> MatchPredicate;
+
+        RatedArenaIndex() : _nextOrder(0) { }
+
+        void Insert(GroupQueueInfo* ginfo);
+        void Remove(GroupQueueInfo const* ginfo);
+        void Clear();
+
+        // returns the earliest queued group (at or after 'from' in join order) that is in the rating range or joined before discardTime
+        [[nodiscard]] GroupQueueInfo* FindFirst(uint32 minRating, uint32 maxRating, int32 discardTime, GroupQueueInfo const* from = nullptr, MatchPredicate const& predicate = nullptr) const;
+
+        [[nodiscard]] std::size_t Size() const { return _entries.size(); }
+        [[nodiscard]] bool Contains(GroupQueueInfo const* ginfo) const { return _entries.find(ginfo) != _entries.end(); }
+
+    private:
+        typedef std::map<uint64, GroupQueueInfo*> JoinOrderMap;
+        typedef std::multimap<uint32, uint64> RatingMap;
+
+        struct Entry
+        {
+            uint64 Order;
+            RatingMap::iterator RatingItr;
+        };
+
+        JoinOrderMap _byJoinOrder;
+        RatingMap _byRating;
+        std::unordered_map<GroupQueueInfo const*, Entry> _entries;
+        uint64 _nextOrder;
+    };
+
+    // one index per bracket and premade queue (BG_QUEUE_PREMADE_ALLIANCE / BG_QUEUE_PREMADE_HORDE)
+    RatedArenaIndex m_RatedArenaIndex[MAX_BATTLEGROUND_BRACKETS][PVP_TEAMS_COUNT];
+
     void SetQueueAnnouncementTimer(uint32 bracketId, int32 timer, bool isCrossFactionBG = true);
     [[nodiscard]] int32 GetQueueAnnouncementTimer(uint32 bracketId) const;
 
 private:
+    void RemoveFromRatedArenaIndex(GroupQueueInfo const* ginfo);
+
     uint32 m_WaitTimes[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
     uint32 m_WaitTimeLastIndex[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
 
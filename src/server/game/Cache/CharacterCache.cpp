@@ -17,6 +17,7 @@
 
 #include "CharacterCache.h"
 #include "ArenaTeam.h"
+#include "CharacterEnumCache.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
 #include "Player.h"
@@ -137,10 +138,16 @@ void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accou
 
     // Fill Name to Guid Store
     _characterCacheByNameStore[name] = &data;
+
+    sCharacterEnumCache->InvalidateAccount(accountId);
 }
 
 void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name)
 {
+    auto itr = _characterCacheStore.find(guid);
+    if (itr != _characterCacheStore.end())
+        sCharacterEnumCache->InvalidateAccount(itr->second.AccountId);
+
     _characterCacheStore.erase(guid);
     _characterCacheByNameStore.erase(name);
 }
@@ -151,6 +158,9 @@ void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string con
     if (itr == _characterCacheStore.end())
         return;
 
+    // the character screen only has to be rebuilt for an actual change
+    bool const changed = itr->second.Name != name || (gender && itr->second.Sex != *gender) || (race && itr->second.Race != *race);
+
     std::string oldName = itr->second.Name;
     itr->second.Name = name;
 
@@ -170,6 +180,9 @@ void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string con
     // Correct name -> pointer storage
     _characterCacheByNameStore.erase(oldName);
     _characterCacheByNameStore[name] = &itr->second;
+
+    if (changed)
+        sCharacterEnumCache->InvalidateAccount(itr->second.AccountId);
 }
 
 void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
@@ -180,7 +193,14 @@ void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
         return;
     }
 
+    if (itr->second.Level == level)
+    {
+        return;
+    }
+
     itr->second.Level = level;
+
+    sCharacterEnumCache->InvalidateAccount(itr->second.AccountId);
 }
 
 void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 accountId)
@@ -191,6 +211,15 @@ void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 acc
         return;
     }
 
+    if (itr->second.AccountId == accountId)
+    {
+        return;
+    }
+
+    // the character moves from one character list to the other
+    sCharacterEnumCache->InvalidateAccount(itr->second.AccountId);
+    sCharacterEnumCache->InvalidateAccount(accountId);
+
     itr->second.AccountId = accountId;
 }
 
@@ -202,7 +231,14 @@ void CharacterCache::UpdateCharacterGuildId(ObjectGuid const& guid, ObjectGuid::
         return;
     }
 
+    if (itr->second.GuildId == guildId)
+    {
+        return;
+    }
+
     itr->second.GuildId = guildId;
+
+    sCharacterEnumCache->InvalidateAccount(itr->second.AccountId);
 }
 
 void CharacterCache::UpdateCharacterArenaTeamId(ObjectGuid const& guid, uint8 slot, uint32 arenaTeamId)
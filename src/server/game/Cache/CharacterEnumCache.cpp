@@ -0,0 +1,182 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterEnumCache.h"
+#include "DatabaseEnv.h"
+#include "World.h"
+
+// expired entries are only looked for every that many stores
+static constexpr uint32 CLEANUP_STORE_INTERVAL = 1024;
+
+CharacterEnumCache* CharacterEnumCache::instance()
+{
+    static CharacterEnumCache instance;
+    return &instance;
+}
+
+bool CharacterEnumCache::Get(uint32 accountId, std::vector<uint8>& packetData, GuidSet& legitCharacters)
+{
+    Seconds const lifetime(sWorld->getIntConfig(CONFIG_CHAR_ENUM_CACHE_LIFETIME));
+    if (lifetime == Seconds::zero())
+        return false;
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _entries.find(accountId);
+    if (itr == _entries.end() || itr->second.Ticket || std::chrono::steady_clock::now() - itr->second.BuildTime >= lifetime)
+    {
+        ++_misses;
+        return false;
+    }
+
+    packetData = itr->second.PacketData;
+    legitCharacters = itr->second.LegitCharacters;
+    ++_hits;
+    return true;
+}
+
+uint32 CharacterEnumCache::BeginQuery(uint32 accountId)
+{
+    if (!sWorld->getIntConfig(CONFIG_CHAR_ENUM_CACHE_LIFETIME))
+        return 0;
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    // never 0, that marks a finished entry
+    if (!++_nextTicket)
+        ++_nextTicket;
+
+    Entry& entry = _entries[accountId];
+    entry.Ticket = _nextTicket;
+    entry.PacketData.clear();
+    entry.LegitCharacters.clear();
+    return _nextTicket;
+}
+
+void CharacterEnumCache::Store(uint32 accountId, uint32 ticket, uint8 const* packetData, std::size_t packetSize, GuidSet const& legitCharacters)
+{
+    Seconds const lifetime(sWorld->getIntConfig(CONFIG_CHAR_ENUM_CACHE_LIFETIME));
+    if (!ticket || lifetime == Seconds::zero())
+        return;
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    // the query may have run before a save of the account got committed
+    if (_savesInFlight.count(accountId))
+        return;
+
+    // invalidated meanwhile, or a newer query is on its way
+    auto itr = _entries.find(accountId);
+    if (itr == _entries.end() || itr->second.Ticket != ticket)
+        return;
+
+    TimePoint const now = std::chrono::steady_clock::now();
+    itr->second.Ticket = 0;
+    itr->second.BuildTime = now;
+    itr->second.PacketData.assign(packetData, packetData + packetSize);
+    itr->second.LegitCharacters = legitCharacters;
+
+    if (++_storesSinceCleanup >= CLEANUP_STORE_INTERVAL)
+        RemoveExpired(now, lifetime);
+}
+
+void CharacterEnumCache::AddSave(uint32 accountId, TransactionCallback&& callback, std::function<void(bool)> afterCommit /*= nullptr*/)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++_savesInFlight[accountId];
+        _entries.erase(accountId);
+    }
+
+    callback.AfterComplete([this, accountId, afterCommit = std::move(afterCommit)](bool success)
+    {
+        EndSave(accountId);
+
+        if (afterCommit)
+            afterCommit(success);
+    });
+
+    std::lock_guard<std::mutex> guard(_saveCallbacksLock);
+    _saveCallbacks.AddCallback(std::move(callback));
+}
+
+void CharacterEnumCache::ProcessSaveCallbacks()
+{
+    std::lock_guard<std::mutex> guard(_saveCallbacksLock);
+    _saveCallbacks.ProcessReadyCallbacks();
+}
+
+void CharacterEnumCache::CommitTransaction(uint32 accountId, CharacterDatabaseTransaction trans)
+{
+    AddSave(accountId, CharacterDatabase.AsyncCommitTransaction(trans));
+}
+
+void CharacterEnumCache::ExecuteOrAppend(uint32 accountId, CharacterDatabaseTransaction trans, CharacterDatabasePreparedStatement* stmt)
+{
+    if (trans)
+    {
+        trans->Append(stmt);
+        return;
+    }
+
+    trans = CharacterDatabase.BeginTransaction();
+    trans->Append(stmt);
+    CommitTransaction(accountId, trans);
+}
+
+void CharacterEnumCache::InvalidateAccount(uint32 accountId)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _entries.erase(accountId);
+}
+
+void CharacterEnumCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _entries.clear();
+}
+
+void CharacterEnumCache::GetStats(uint64& hits, uint64& misses)
+{
+    hits = _hits.exchange(0);
+    misses = _misses.exchange(0);
+}
+
+void CharacterEnumCache::EndSave(uint32 accountId)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _savesInFlight.find(accountId);
+    if (itr != _savesInFlight.end() && !--itr->second)
+        _savesInFlight.erase(itr);
+
+    // an enum query started meanwhile was not stored, a newer one may be running
+    _entries.erase(accountId);
+}
+
+void CharacterEnumCache::RemoveExpired(TimePoint now, Seconds lifetime)
+{
+    _storesSinceCleanup = 0;
+
+    for (auto itr = _entries.begin(); itr != _entries.end();)
+    {
+        if (!itr->second.Ticket && now - itr->second.BuildTime >= lifetime)
+            itr = _entries.erase(itr);
+        else
+            ++itr;
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CHARACTER_ENUM_CACHE_H_
+#define _CHARACTER_ENUM_CACHE_H_
+
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include "Duration.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Keeps the SMSG_CHAR_ENUM of recently enumerated accounts, so going back to the character screen does not query the db again.
+ *
+ * An entry is built from the regular enum query and dropped whenever something shown on the character screen
+ * may have changed: a save of one of the account's characters, any change going through sCharacterCache
+ * (create, delete, rename, customize, level, guild, account transfer), bans and the at login flags set by commands.
+ * The writes behind these changes go through AddSave or CommitTransaction.
+ * Entries also expire after CharEnumCache.Lifetime, for changes written to the db by other means.
+ * No entry is kept for an account while a save of one of its characters is not committed yet, as the enum query
+ * could still read the old rows.
+ *
+ * Thread safe, saves invalidate from the map threads.
+ */
+class CharacterEnumCache
+{
+public:
+    static CharacterEnumCache* instance();
+
+    // Copies the cached enum of the account, false if there is none
+    bool Get(uint32 accountId, std::vector<uint8>& packetData, GuidSet& legitCharacters);
+
+    // Called before the enum query is sent, the returned ticket has to be handed to Store
+    uint32 BeginQuery(uint32 accountId);
+    // Keeps the enum built from the query, unless the account was invalidated while the query ran
+    void Store(uint32 accountId, uint32 ticket, uint8 const* packetData, std::size_t packetSize, GuidSet const& legitCharacters);
+
+    // Keeps the account out of the cache until the character save committed by callback is done, afterCommit is run from the world update then
+    void AddSave(uint32 accountId, TransactionCallback&& callback, std::function<void(bool)> afterCommit = nullptr);
+    // Finishes the committed saves, called from the world update
+    void ProcessSaveCallbacks();
+
+    // Commits trans like AddSave, for any write changing what the character screen of the account shows
+    void CommitTransaction(uint32 accountId, CharacterDatabaseTransaction trans);
+    // Appends stmt to trans when there is one, the owner of trans has to commit it through CommitTransaction
+    void ExecuteOrAppend(uint32 accountId, CharacterDatabaseTransaction trans, CharacterDatabasePreparedStatement* stmt);
+
+    void InvalidateAccount(uint32 accountId);
+    void Clear();
+
+    // Hits and misses since the last call
+    void GetStats(uint64& hits, uint64& misses);
+
+private:
+    CharacterEnumCache() = default;
+    ~CharacterEnumCache() = default;
+
+    CharacterEnumCache(CharacterEnumCache const&) = delete;
+    CharacterEnumCache& operator=(CharacterEnumCache const&) = delete;
+
+    struct Entry
+    {
+        uint32 Ticket = 0;          // set while the enum query of the account runs
+        TimePoint BuildTime;
+        std::vector<uint8> PacketData;
+        GuidSet LegitCharacters;
+    };
+
+    void RemoveExpired(TimePoint now, Seconds lifetime);
+    void EndSave(uint32 accountId);
+
+    std::mutex _lock;
+    std::unordered_map<uint32, Entry> _entries;
+    uint32 _nextTicket = 0;
+    uint32 _storesSinceCleanup = 0;
+    std::unordered_map<uint32, uint32> _savesInFlight;  // accountId, uncommitted saves
+
+    // taken before _lock when both are needed, the callbacks end the saves
+    std::mutex _saveCallbacksLock;
+    AsyncCallbackProcessor<TransactionCallback> _saveCallbacks;
+
+    std::atomic<uint64> _hits{0};
+    std::atomic<uint64> _misses{0};
+};
+
+#define sCharacterEnumCache CharacterEnumCache::instance()
+
+#endif
@@ -18,9 +18,85 @@
 #include "WhoListCacheMgr.h"
 #include "AreaDefines.h"
 #include "GuildMgr.h"
-#include "ObjectAccessor.h"
-#include "World.h"
-#include "WorldSessionMgr.h"
+#include "Player.h"
+#include "WorldSession.h"
+
+void WhoListIndex::AddToBucket(Bucket& bucket, WhoListPlayerInfo* info, uint32& slot)
+{
+    slot = uint32(bucket.size());
+    bucket.push_back(info);
+}
+
+void WhoListIndex::RemoveFromBucket(Bucket& bucket, uint32 slot, uint32 WhoListPlayerInfo::* slotMember)
+{
+    // move the last entry into the gap
+    WhoListPlayerInfo* last = bucket.back();
+    bucket[slot] = last;
+    last->*slotMember = slot;
+    bucket.pop_back();
+}
+
+void WhoListIndex::Insert(WhoListPlayerInfo const& info)
+{
+    Remove(info.GetGuid());
+
+    WhoListPlayerInfo& stored = _players.emplace(info.GetGuid(), info).first->second;
+    AddToBucket(_levels[stored._level], &stored, stored._levelSlot);
+    AddToBucket(_zones[stored._zoneid], &stored, stored._zoneSlot);
+}
+
+void WhoListIndex::Remove(ObjectGuid guid)
+{
+    auto itr = _players.find(guid);
+    if (itr == _players.end())
+        return;
+
+    WhoListPlayerInfo& info = itr->second;
+    RemoveFromBucket(_levels[info._level], info._levelSlot, &WhoListPlayerInfo::_levelSlot);
+    RemoveFromBucket(_zones[info._zoneid], info._zoneSlot, &WhoListPlayerInfo::_zoneSlot);
+    _players.erase(itr);
+}
+
+void WhoListIndex::Clear()
+{
+    _players.clear();
+    for (Bucket& bucket : _levels)
+        bucket.clear();
+    _zones.clear();
+}
+
+WhoListPlayerInfo* WhoListIndex::Find(ObjectGuid guid)
+{
+    auto itr = _players.find(guid);
+    return itr != _players.end() ? &itr->second : nullptr;
+}
+
+void WhoListIndex::SetLevel(WhoListPlayerInfo& info, uint8 level)
+{
+    if (info._level == level)
+        return;
+
+    RemoveFromBucket(_levels[info._level], info._levelSlot, &WhoListPlayerInfo::_levelSlot);
+    info._level = level;
+    AddToBucket(_levels[level], &info, info._levelSlot);
+}
+
+void WhoListIndex::SetZoneId(WhoListPlayerInfo& info, uint32 zoneId)
+{
+    if (info._zoneid == zoneId)
+        return;
+
+    RemoveFromBucket(_zones[info._zoneid], info._zoneSlot, &WhoListPlayerInfo::_zoneSlot);
+    info._zoneid = zoneId;
+    AddToBucket(_zones[zoneId], &info, info._zoneSlot);
+}
+
+void WhoListIndex::SetGuildName(uint32 guildId, std::wstring const& wideGuildName, std::string const& guildName)
+{
+    for (auto& [guid, info] : _players)
+        if (info._guildId == guildId)
+            info.SetGuild(guildId, wideGuildName, guildName);
+}
 
 WhoListCacheMgr* WhoListCacheMgr::instance()
 {
@@ -28,36 +104,69 @@ WhoListCacheMgr* WhoListCacheMgr::instance()
     return &instance;
 }
 
-void WhoListCacheMgr::Update()
+static bool BuildWideLowerName(std::string const& name, std::wstring& wideName)
 {
-    // clear current list
-    _whoListStorage.clear();
-    _whoListStorage.reserve(sWorldSessionMgr->GetPlayerCount() + 1);
+    if (!Utf8toWStr(name, wideName))
+        return false;
 
-    for (auto const& [guid, player] : ObjectAccessor::GetPlayers())
-    {
-        if (!player->FindMap() || player->GetSession()->PlayerLoading())
-            continue;
+    wstrToLower(wideName);
+    return true;
+}
 
-        std::string playerName = player->GetName();
-        std::wstring widePlayerName;
+void WhoListCacheMgr::AddPlayer(Player const* player)
+{
+    std::string playerName = player->GetName();
+    std::wstring widePlayerName;
+    if (!BuildWideLowerName(playerName, widePlayerName))
+        return;
 
-        if (!Utf8toWStr(playerName, widePlayerName))
-            continue;
+    std::string guildName = sGuildMgr->GetGuildNameById(player->GetGuildId());
+    std::wstring wideGuildName;
+    if (!BuildWideLowerName(guildName, wideGuildName))
+        return;
 
-        wstrToLower(widePlayerName);
+    WhoListPlayerInfo info(player->GetGUID(), player->GetTeamId(), player->GetSession()->GetSecurity(), player->GetLevel(),
+        player->getClass(), player->getRace(),
+        (player->IsSpectator() ? AREA_DALARAN : player->GetZoneId()), player->getGender(), player->IsVisible(),
+        widePlayerName, player->GetGuildId(), wideGuildName, playerName, guildName);
 
-        std::string guildName = sGuildMgr->GetGuildNameById(player->GetGuildId());
-        std::wstring wideGuildName;
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    _whoListStorage.Insert(info);
+}
+
+void WhoListCacheMgr::RemovePlayer(ObjectGuid guid)
+{
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    _whoListStorage.Remove(guid);
+}
 
-        if (!Utf8toWStr(guildName, wideGuildName))
-            continue;
+void WhoListCacheMgr::UpdatePlayer(Player const* player)
+{
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    WhoListPlayerInfo* info = _whoListStorage.Find(player->GetGUID());
+    if (!info)
+        return;
 
-        wstrToLower(wideGuildName);
+    _whoListStorage.SetLevel(*info, player->GetLevel());
+    _whoListStorage.SetZoneId(*info, player->IsSpectator() ? AREA_DALARAN : player->GetZoneId());
+    info->SetSecurity(player->GetSession()->GetSecurity());
+    info->SetVisible(player->IsVisible());
 
-        _whoListStorage.emplace_back(player->GetGUID(), player->GetTeamId(), player->GetSession()->GetSecurity(), player->GetLevel(),
-            player->getClass(), player->getRace(),
-            (player->IsSpectator() ? AREA_DALARAN : player->GetZoneId()), player->getGender(), player->IsVisible(),
-            widePlayerName, wideGuildName, playerName, guildName);
+    if (info->IsGuildOutdated(player->GetGuildId()))
+    {
+        std::string guildName = sGuildMgr->GetGuildNameById(player->GetGuildId());
+        std::wstring wideGuildName;
+        if (BuildWideLowerName(guildName, wideGuildName))
+            info->SetGuild(player->GetGuildId(), wideGuildName, guildName);
     }
 }
+
+void WhoListCacheMgr::UpdateGuildName(uint32 guildId, std::string const& guildName)
+{
+    std::wstring wideGuildName;
+    if (!BuildWideLowerName(guildName, wideGuildName))
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    _whoListStorage.SetGuildName(guildId, wideGuildName, guildName);
+}
@@ -19,14 +19,22 @@
 #define _WHO_LISTCACHE_H_
 
 #include "Common.h"
+#include "DBCEnums.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include <algorithm>
+#include <array>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+class Player;
 
 class WhoListPlayerInfo
 {
 public:
     WhoListPlayerInfo(ObjectGuid guid, TeamId team, AccountTypes security, uint8 level, uint8 clss, uint8 race, uint32 zoneid, uint8 gender, bool visible, std::wstring const& widePlayerName,
-        std::wstring const& wideGuildName, std::string const& playerName, std::string const& guildName) :
+        uint32 guildId, std::wstring const& wideGuildName, std::string const& playerName, std::string const& guildName) :
         _guid(guid),
         _team(team),
         _security(security),
@@ -37,6 +45,7 @@ public:
         _gender(gender),
         _visible(visible),
         _widePlayerName(widePlayerName),
+        _guildId(guildId),
         _wideGuildName(wideGuildName),
         _playerName(playerName),
         _guildName(guildName) { }
@@ -51,11 +60,25 @@ public:
     uint8 GetGender() const { return _gender; }
     bool IsVisible() const { return _visible; }
     std::wstring const& GetWidePlayerName() const { return _widePlayerName; }
+    uint32 GetGuildId() const { return _guildId; }
     std::wstring const& GetWideGuildName() const { return _wideGuildName; }
     std::string const& GetPlayerName() const { return _playerName; }
     std::string const& GetGuildName() const { return _guildName; }
+    // the name is missing if the player joined the guild before it was registered with the GuildMgr
+    bool IsGuildOutdated(uint32 guildId) const { return _guildId != guildId || (guildId && _guildName.empty()); }
+
+    void SetSecurity(AccountTypes security) { _security = security; }
+    void SetVisible(bool visible) { _visible = visible; }
+    void SetGuild(uint32 guildId, std::wstring const& wideGuildName, std::string const& guildName)
+    {
+        _guildId = guildId;
+        _wideGuildName = wideGuildName;
+        _guildName = guildName;
+    }
 
 private:
+    friend class WhoListIndex;
+
     ObjectGuid _guid;
     TeamId _team;
     AccountTypes _security;
@@ -66,13 +89,88 @@ private:
     uint8 _gender;
     bool _visible;
     std::wstring _widePlayerName;
+    uint32 _guildId;
     std::wstring _wideGuildName;
     std::string _playerName;
     std::string _guildName;
+
+    // positions in the level and zone buckets of WhoListIndex
+    uint32 _levelSlot = 0;
+    uint32 _zoneSlot = 0;
 };
 
-using WhoListInfoVector = std::vector<WhoListPlayerInfo>;
+/**
+ * Who list entries by guid, bucketed by level and by zone so a /who request only looks at
+ * the players that can match its level range or zone list. Not thread safe.
+ */
+class AC_GAME_API WhoListIndex
+{
+public:
+    // adds the entry, replacing the one with the same guid if any
+    void Insert(WhoListPlayerInfo const& info);
+    void Remove(ObjectGuid guid);
+    void Clear();
+
+    WhoListPlayerInfo* Find(ObjectGuid guid);
+    void SetLevel(WhoListPlayerInfo& info, uint8 level);
+    void SetZoneId(WhoListPlayerInfo& info, uint32 zoneId);
+    void SetGuildName(uint32 guildId, std::wstring const& wideGuildName, std::string const& guildName);
+
+    [[nodiscard]] std::size_t GetSize() const { return _players.size(); }
+
+    /**
+     * @brief Calls visitor for every entry with a level in [levelMin, levelMax] that is in one of zoneIds,
+     * or in any zone if zoneIds is empty. Every entry is visited at most once.
+     */
+    template<typename Visitor>
+    void Visit(uint32 levelMin, uint32 levelMax, std::vector<uint32> const& zoneIds, Visitor&& visitor) const
+    {
+        levelMax = std::min<uint32>(levelMax, STRONG_MAX_LEVEL);
+        if (levelMin > levelMax)
+            return;
+
+        if (zoneIds.empty())
+        {
+            for (uint32 level = levelMin; level <= levelMax; ++level)
+                for (WhoListPlayerInfo const* info : _levels[level])
+                    visitor(*info);
+            return;
+        }
 
+        for (std::size_t i = 0; i < zoneIds.size(); ++i)
+        {
+            // the client may send the same zone twice
+            if (std::find(zoneIds.begin(), zoneIds.begin() + i, zoneIds[i]) != zoneIds.begin() + i)
+                continue;
+
+            auto itr = _zones.find(zoneIds[i]);
+            if (itr == _zones.end())
+                continue;
+
+            for (WhoListPlayerInfo const* info : itr->second)
+                if (info->GetLevel() >= levelMin && info->GetLevel() <= levelMax)
+                    visitor(*info);
+        }
+    }
+
+private:
+    typedef std::vector<WhoListPlayerInfo*> Bucket;
+
+    static void AddToBucket(Bucket& bucket, WhoListPlayerInfo* info, uint32& slot);
+    static void RemoveFromBucket(Bucket& bucket, uint32 slot, uint32 WhoListPlayerInfo::* slotMember);
+
+    std::unordered_map<ObjectGuid, WhoListPlayerInfo> _players;
+    std::array<Bucket, STRONG_MAX_LEVEL + 1> _levels;
+    std::unordered_map<uint32, Bucket> _zones;
+};
+
+/**
+ * Online players as shown by /who. Players are added once they finished logging in and removed
+ * on logout, everything /who filters on is updated by the code changing it (level, zone, guild,
+ * visibility) so requests never have to touch the players themselves.
+ *
+ * Updated and read from map threads, hence the lock.
+ */
 class AC_GAME_API WhoListCacheMgr
 {
     WhoListCacheMgr() = default;
@@ -86,11 +184,22 @@ class AC_GAME_API WhoListCacheMgr
 public:
     static WhoListCacheMgr* instance();
 
-    void Update();
-    WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
+    void AddPlayer(Player const* player);
+    void RemovePlayer(ObjectGuid guid);
+    // refreshes level, zone, guild and visibility of a player that was added before
+    void UpdatePlayer(Player const* player);
+    void UpdateGuildName(uint32 guildId, std::string const& guildName);
+
+    template<typename Visitor>
+    void Visit(uint32 levelMin, uint32 levelMax, std::vector<uint32> const& zoneIds, Visitor&& visitor) const
+    {
+        std::shared_lock<std::shared_mutex> lock(_lock);
+        _whoListStorage.Visit(levelMin, levelMax, zoneIds, std::forward<Visitor>(visitor));
+    }
 
 protected:
-    WhoListInfoVector _whoListStorage;
+    mutable std::shared_mutex _lock;
+    WhoListIndex _whoListStorage;
 };
 
 #define sWhoListCacheMgr WhoListCacheMgr::instance()
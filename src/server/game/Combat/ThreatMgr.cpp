@@ -25,6 +25,7 @@
 #include "SpellMgr.h"
 #include "Unit.h"
 #include "UnitEvents.h"
+#include <algorithm>
 
 //==============================================================
 //================= ThreatCalcHelper ===========================
@@ -254,6 +255,41 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iReferenceByGuid.clear();
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    StorageType::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), hostileRef);
+    if (itr == iThreatList.end())
+        return;
+
+    iThreatList.erase(itr);
+
+    auto refItr = iReferenceByGuid.find(hostileRef->getUnitGuid());
+    if (refItr == iReferenceByGuid.end() || refItr->second != hostileRef)
+        return;
+
+    // fall back to another reference to the same target, if any
+    StorageType::const_iterator other = std::find_if(iThreatList.begin(), iThreatList.end(), [hostileRef](HostileReference const* ref)
+    {
+        return ref->getUnitGuid() == hostileRef->getUnitGuid();
+    });
+
+    if (other != iThreatList.end())
+        refItr->second = *other;
+    else
+        iReferenceByGuid.erase(refItr);
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iThreatList.push_back(hostileRef);
+    iReferenceByGuid.emplace(hostileRef->getUnitGuid(), hostileRef);
 }
 
 //============================================================
@@ -268,16 +304,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit const* victim) cons
 
 HostileReference* ThreatContainer::getReferenceByTarget(ObjectGuid const& guid) const
 {
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-        {
-            return ref;
-        }
-    }
-
-    return nullptr;
+    auto itr = iReferenceByGuid.find(guid);
+    return itr != iReferenceByGuid.end() ? itr->second : nullptr;
 }
 
 //============================================================
@@ -300,12 +328,25 @@ void ThreatContainer::ModifyThreatByPercent(Unit* victim, int32 percent)
 }
 
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Check if the list is dirty and restore the order if necessary
+// Between two updates only the references whose threat changed are out of place,
+// so each of them is moved to its position found by binary search in the already ordered prefix
+// instead of resorting the whole list. References with equal threat keep their previous order.
 
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Acore::ThreatOrderPred());
+    {
+        Acore::ThreatOrderPred const pred;
+        for (StorageType::iterator itr = std::next(iThreatList.begin()); itr != iThreatList.end(); ++itr)
+        {
+            if (!pred(*itr, *std::prev(itr)))
+                continue;
+
+            StorageType::iterator pos = std::upper_bound(iThreatList.begin(), itr, *itr, pred);
+            std::rotate(pos, itr, std::next(itr));
+        }
+    }
 
     iDirty = false;
 }
@@ -23,7 +23,8 @@
 #include "Reference.h"
 #include "SharedDefines.h"
 #include "UnitEvents.h"
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 //==============================================================
 
@@ -144,7 +145,7 @@ class ThreatContainer
     friend class ThreatMgr;
 
 public:
-    typedef std::list<HostileReference*> StorageType;
+    typedef std::vector<HostileReference*> StorageType;
 
     ThreatContainer() = default;
 
@@ -176,22 +177,17 @@ public:
     [[nodiscard]] StorageType const& GetThreatList() const { return iThreatList; }
 
 private:
-    void remove(HostileReference* hostileRef)
-    {
-        iThreatList.remove(hostileRef);
-    }
+    void remove(HostileReference* hostileRef);
 
-    void addReference(HostileReference* hostileRef)
-    {
-        iThreatList.push_back(hostileRef);
-    }
+    void addReference(HostileReference* hostileRef);
 
     void clearReferences();
 
-    // Sort the list if necessary
+    // Restore the threat order if necessary
     void update();
 
     StorageType iThreatList;
+    std::unordered_map<ObjectGuid, HostileReference*> iReferenceByGuid; // lookup for getReferenceByTarget, which runs on every threat change
     bool iDirty{false};
 };
 
@@ -224,8 +220,8 @@ public:
     [[nodiscard]] bool isThreatListEmpty() const { return iThreatContainer.empty(); }
     [[nodiscard]] bool areThreatListsEmpty() const { return iThreatContainer.empty() && iThreatOfflineContainer.empty(); }
 
-    Acore::IteratorPair<std::list<ThreatReference*>::const_iterator> GetSortedThreatList() const { auto& list = iThreatContainer.GetThreatList(); return { list.cbegin(), list.cend() }; }
-    Acore::IteratorPair<std::list<ThreatReference*>::const_iterator> GetUnsortedThreatList() const { return GetSortedThreatList(); }
+    Acore::IteratorPair<ThreatContainer::StorageType::const_iterator> GetSortedThreatList() const { auto& list = iThreatContainer.GetThreatList(); return { list.cbegin(), list.cend() }; }
+    Acore::IteratorPair<ThreatContainer::StorageType::const_iterator> GetUnsortedThreatList() const { return GetSortedThreatList(); }
 
     void processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusChangeEvent);
 
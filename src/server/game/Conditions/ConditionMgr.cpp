@@ -17,6 +17,7 @@
 
 #include "ConditionMgr.h"
 #include "AchievementMgr.h"
+#include "ConditionPlan.h"
 #include "GameEventMgr.h"
 #include "GameObject.h"
 #include "GameObjectAI.h"
@@ -31,6 +32,7 @@
 #include "SpellAuras.h"
 #include "SpellMgr.h"
 #include "WorldState.h"
+#include <unordered_set>
 
 // Checks if object meets the condition
 // Can have CONDITION_SOURCE_TYPE_NONE && !mReferenceId if called from a special event (ie: eventAI)
@@ -907,46 +909,11 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& co
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions)
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> ElseGroupStore;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    return IsConditionListMet(conditions, ConditionReferenceStore, [&sourceInfo](Condition* condition)
     {
-        LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: {} val1: {}", (*i)->ConditionType, (*i)->ConditionValue1);
-        if ((*i)->isLoaded())
-        {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = ElseGroupStore.find((*i)->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == ElseGroupStore.end())
-                ElseGroupStore[(*i)->ElseGroup] = true;
-            else if (!(*itr).second)
-                continue;
-
-            if ((*i)->ReferenceId) // handle reference
-            {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
-                        ElseGroupStore[(*i)->ElseGroup] = false;
-                }
-                else
-                {
-                    LOG_DEBUG("condition", "IsPlayerMeetToConditionList: Reference template -{} not found", (*i)->ReferenceId);
-                }
-            }
-            else // handle normal condition
-            {
-                if (!(*i)->Meets(sourceInfo))
-                    ElseGroupStore[(*i)->ElseGroup] = false;
-            }
-        }
-    }
-    for (std::map<uint32, bool>::const_iterator i = ElseGroupStore.begin(); i != ElseGroupStore.end(); ++i)
-        if (i->second)
-            return true;
-
-    return false;
+        LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: {} val1: {}", condition->ConditionType, condition->ConditionValue1);
+        return condition->Meets(sourceInfo);
+    });
 }
 
 bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object, ConditionList const& conditions)
@@ -967,9 +934,103 @@ bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, Con
         return true;
 
     LOG_DEBUG("condition", "ConditionMgr::IsObjectMeetToConditions");
+    if (ConditionPlan const* plan = GetPlan(conditions))
+        return plan->Evaluate([&sourceInfo](Condition* condition) { return condition->Meets(sourceInfo); });
+
+    // lists built outside of LoadConditions (scripts, modules) have no plan
     return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
+ConditionPlan const* ConditionMgr::GetPlan(ConditionList const& conditions) const
+{
+    ConditionPlanContainer::const_iterator itr = ConditionPlanStore.find(conditions.front());
+    if (itr == ConditionPlanStore.end() || !itr->second->IsCompiledFrom(conditions))
+        return nullptr;
+
+    return itr->second.get();
+}
+
+void ConditionMgr::CompilePlans()
+{
+    uint32 oldMSTime = getMSTime();
+
+    ConditionPlanContainer plans;
+    ConditionReferencePlanContainer referencePlans;
+    std::unordered_set<uint32> compilingReferences;
+
+    ConditionPlan::ReferenceResolver resolveReference = [&](uint32 referenceId) -> ConditionPlan const*
+    {
+        ConditionReferencePlanContainer::const_iterator itr = referencePlans.find(referenceId);
+        if (itr != referencePlans.end())
+            return itr->second.get();
+
+        ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(referenceId);
+        if (ref == ConditionReferenceStore.end())
+            return nullptr;
+
+        if (!compilingReferences.insert(referenceId).second)
+        {
+            LOG_ERROR("sql.sql", "Condition reference template {} references itself through other references, ignored!", referenceId);
+            return nullptr;
+        }
+
+        // references are shared by spell conditions, whose callers look at the last failed condition
+        std::unique_ptr<ConditionPlan> plan = std::make_unique<ConditionPlan>();
+        plan->Compile(ref->second, resolveReference, true);
+        compilingReferences.erase(referenceId);
+        return referencePlans.emplace(referenceId, std::move(plan)).first->second.get();
+    };
+
+    auto compile = [&](ConditionList const& conditions, bool keepOrder)
+    {
+        if (conditions.empty())
+            return;
+
+        std::unique_ptr<ConditionPlan>& plan = plans[conditions.front()];
+        if (plan)
+            return;
+
+        plan = std::make_unique<ConditionPlan>();
+        plan->Compile(conditions, resolveReference, keepOrder);
+    };
+
+    for (ConditionReferenceContainer::value_type const& ref : ConditionReferenceStore)
+        resolveReference(ref.first);
+
+    for (ConditionContainer::value_type const& sourceType : ConditionStore)
+        for (ConditionTypeContainer::value_type const& entry : sourceType.second)
+            compile(entry.second, sourceType.first == CONDITION_SOURCE_TYPE_SPELL);
+
+    for (CreatureSpellConditionContainer::value_type const& creature : VehicleSpellConditionStore)
+        for (ConditionTypeContainer::value_type const& spell : creature.second)
+            compile(spell.second, false);
+
+    for (CreatureSpellConditionContainer::value_type const& creature : SpellClickEventConditionStore)
+        for (ConditionTypeContainer::value_type const& spell : creature.second)
+            compile(spell.second, false);
+
+    for (NpcVendorConditionContainer::value_type const& creature : NpcVendorConditionContainerStore)
+        for (ConditionTypeContainer::value_type const& item : creature.second)
+            compile(item.second, false);
+
+    for (SmartEventConditionContainer::value_type const& source : SmartEventConditionStore)
+        for (ConditionTypeContainer::value_type const& event : source.second)
+            compile(event.second, false);
+
+    // loot items, gossip menus and spell effects keep their own lists, rebuild them the same way they were filled
+    std::map<std::tuple<ConditionSourceType, uint32, int32>, ConditionList> groupedLists;
+    for (Condition* cond : AllocatedMemoryStore)
+        groupedLists[std::make_tuple(cond->SourceType, cond->SourceGroup, cond->SourceEntry)].push_back(cond);
+
+    for (auto const& grouped : groupedLists)
+        compile(grouped.second, false);
+
+    ConditionPlanStore.swap(plans);
+    ConditionReferencePlanStore.swap(referencePlans);
+
+    LOG_INFO("server.loading", ">> Compiled {} condition plans ({} references) in {} ms", ConditionPlanStore.size(), ConditionReferencePlanStore.size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
 bool ConditionMgr::CanHaveSourceGroupSet(ConditionSourceType sourceType) const
 {
     return (sourceType == CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_DISENCHANT_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_FISHING_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_GAMEOBJECT_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_ITEM_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_MAIL_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_MILLING_LOOT_TEMPLATE ||
@@ -1346,6 +1407,8 @@ void ConditionMgr::LoadConditions(bool isReload)
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} conditions in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
+
+    CompilePlans();
     LOG_INFO("server.loading", " ");
 }
 
@@ -2518,6 +2581,10 @@ bool ConditionMgr::isConditionTypeValid(Condition* cond)
 
 void ConditionMgr::Clean()
 {
+    // plans point to the conditions deleted below
+    ConditionPlanStore.clear();
+    ConditionReferencePlanStore.clear();
+
     for (ConditionReferenceContainer::iterator itr = ConditionReferenceStore.begin(); itr != ConditionReferenceStore.end(); ++itr)
     {
         for (ConditionList::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it) delete *it;
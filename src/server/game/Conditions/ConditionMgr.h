@@ -21,7 +21,10 @@
 #include "Define.h"
 #include <list>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
+class ConditionPlan;
 class Player;
 class Unit;
 class WorldObject;
@@ -245,6 +248,9 @@ typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionTypeCont
 
 typedef std::map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
 
+typedef std::unordered_map<Condition const*, std::unique_ptr<ConditionPlan>> ConditionPlanContainer; // keyed by the first condition of the compiled list
+typedef std::unordered_map<uint32, std::unique_ptr<ConditionPlan>> ConditionReferencePlanContainer;
+
 class ConditionMgr
 {
 private:
@@ -270,6 +276,15 @@ public:
     ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
     ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
 
+    /**
+     * @brief Interprets a condition list: it is met when one of its ElseGroups is, and an ElseGroup is met
+     * when all of its conditions are. Reference rows are followed into references.
+     *
+     * @param check Decides a single non-reference condition.
+     */
+    template<class Check>
+    static bool IsConditionListMet(ConditionList const& conditions, ConditionReferenceContainer const& references, Check const& check);
+
 private:
     bool isSourceTypeValid(Condition* cond);
     bool addToLootTemplate(Condition* cond, LootTemplate* loot);
@@ -278,6 +293,9 @@ private:
     bool addToSpellImplicitTargetConditions(Condition* cond);
     bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
 
+    void CompilePlans();
+    [[nodiscard]] ConditionPlan const* GetPlan(ConditionList const& conditions) const;
+
     void Clean(); // free up resources
     std::list<Condition*> AllocatedMemoryStore; // some garbage collection :)
 
@@ -287,8 +305,45 @@ private:
     CreatureSpellConditionContainer   SpellClickEventConditionStore;
     NpcVendorConditionContainer       NpcVendorConditionContainerStore;
     SmartEventConditionContainer      SmartEventConditionStore;
+
+    ConditionPlanContainer            ConditionPlanStore;
+    ConditionReferencePlanContainer   ConditionReferencePlanStore;
 };
 
+template<class Check>
+bool ConditionMgr::IsConditionListMet(ConditionList const& conditions, ConditionReferenceContainer const& references, Check const& check)
+{
+    //     groupId, groupCheckPassed
+    std::map<uint32, bool> ElseGroupStore;
+    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    {
+        if (!(*i)->isLoaded())
+            continue;
+
+        //! Find ElseGroup in ElseGroupStore
+        std::map<uint32, bool>::const_iterator itr = ElseGroupStore.find((*i)->ElseGroup);
+        //! If not found, add an entry in the store and set to true (placeholder)
+        if (itr == ElseGroupStore.end())
+            ElseGroupStore[(*i)->ElseGroup] = true;
+        else if (!(*itr).second)
+            continue;
+
+        if ((*i)->ReferenceId) // handle reference, a missing reference template does not fail the group
+        {
+            ConditionReferenceContainer::const_iterator ref = references.find((*i)->ReferenceId);
+            if (ref != references.end() && !IsConditionListMet((*ref).second, references, check))
+                ElseGroupStore[(*i)->ElseGroup] = false;
+        }
+        else if (!check(*i)) // handle normal condition
+            ElseGroupStore[(*i)->ElseGroup] = false;
+    }
+    for (std::map<uint32, bool>::const_iterator i = ElseGroupStore.begin(); i != ElseGroupStore.end(); ++i)
+        if (i->second)
+            return true;
+
+    return false;
+}
+
 #define sConditionMgr ConditionMgr::instance()
 
 #endif
@@ -0,0 +1,153 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConditionPlan.h"
+#include <algorithm>
+
+// terms that point to a reference with several groups, roughly what a small list costs
+static constexpr uint8 CONDITION_COST_REFERENCE = 2;
+
+uint8 ConditionPlan::GetConditionCost(ConditionTypes type)
+{
+    switch (type)
+    {
+        // plain field reads on the target
+        case CONDITION_ZONEID:
+        case CONDITION_TEAM:
+        case CONDITION_DRUNKENSTATE:
+        case CONDITION_CLASS:
+        case CONDITION_RACE:
+        case CONDITION_GENDER:
+        case CONDITION_UNIT_STATE:
+        case CONDITION_MAPID:
+        case CONDITION_AREAID:
+        case CONDITION_CREATURE_TYPE:
+        case CONDITION_PHASEMASK:
+        case CONDITION_LEVEL:
+        case CONDITION_OBJECT_ENTRY_GUID:
+        case CONDITION_TYPE_MASK:
+        case CONDITION_ALIVE:
+        case CONDITION_HP_VAL:
+        case CONDITION_HP_PCT:
+        case CONDITION_STAND_STATE:
+        case CONDITION_CHARMED:
+        case CONDITION_TAXI:
+        case CONDITION_DIFFICULTY_ID:
+        case CONDITION_SPAWNMASK:
+        case CONDITION_TITLE:
+            return 0;
+        // container lookups, distances and map queries
+        case CONDITION_AURA:
+        case CONDITION_ITEM_EQUIPPED:
+        case CONDITION_REPUTATION_RANK:
+        case CONDITION_SKILL:
+        case CONDITION_QUESTREWARDED:
+        case CONDITION_QUESTTAKEN:
+        case CONDITION_QUEST_NONE:
+        case CONDITION_QUEST_COMPLETE:
+        case CONDITION_QUESTSTATE:
+        case CONDITION_QUEST_OBJECTIVE_PROGRESS:
+        case CONDITION_QUEST_SATISFY_EXCLUSIVE:
+        case CONDITION_DAILY_QUEST_DONE:
+        case CONDITION_WORLD_STATE:
+        case CONDITION_ACTIVE_EVENT:
+        case CONDITION_INSTANCE_INFO:
+        case CONDITION_ACHIEVEMENT:
+        case CONDITION_REALM_ACHIEVEMENT:
+        case CONDITION_SPELL:
+        case CONDITION_HAS_AURA_TYPE:
+        case CONDITION_PET_TYPE:
+        case CONDITION_RELATION_TO:
+        case CONDITION_REACTION_TO:
+        case CONDITION_DISTANCE_TO:
+        case CONDITION_IN_WATER:
+        case CONDITION_WORLD_SCRIPT:
+        case CONDITION_AI_DATA:
+        case CONDITION_RANDOM_DUNGEON:
+            return 1;
+        // walks the whole inventory (and the bank)
+        case CONDITION_ITEM:
+            return 2;
+        // grid searches
+        case CONDITION_NEAR_CREATURE:
+        case CONDITION_NEAR_GAMEOBJECT:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+void ConditionPlan::Compile(ConditionList const& conditions, ReferenceResolver const& resolveReference, bool keepOrder)
+{
+    _source.assign(conditions.begin(), conditions.end());
+    _terms.clear();
+    _groups.clear();
+    _alwaysTrue = false;
+
+    // else groups in order of first appearance, like the interpreter creates them
+    std::vector<std::pair<uint32, std::vector<Term>>> groups;
+    for (Condition* condition : conditions)
+    {
+        if (!condition->isLoaded())
+            continue;
+
+        auto group = std::find_if(groups.begin(), groups.end(), [condition](std::pair<uint32, std::vector<Term>> const& pair) { return pair.first == condition->ElseGroup; });
+        if (group == groups.end())
+            group = groups.emplace(groups.end(), condition->ElseGroup, std::vector<Term>());
+
+        if (!condition->ReferenceId)
+        {
+            group->second.push_back({ condition, nullptr, GetConditionCost(condition->ConditionType) });
+            continue;
+        }
+
+        // a missing reference does not fail the group
+        ConditionPlan const* reference = resolveReference(condition->ReferenceId);
+        if (!reference || reference->IsAlwaysTrue())
+            continue;
+
+        if (reference->_groups.size() == 1)
+            group->second.insert(group->second.end(), reference->_terms.begin(), reference->_terms.end());
+        else
+            group->second.push_back({ nullptr, reference, CONDITION_COST_REFERENCE });
+    }
+
+    for (auto& group : groups)
+    {
+        std::vector<Term>& terms = group.second;
+
+        // nothing left to check, the group and so the whole list passes
+        if (terms.empty())
+        {
+            _terms.clear();
+            _groups.clear();
+            _alwaysTrue = true;
+            return;
+        }
+
+        if (!keepOrder)
+            std::stable_sort(terms.begin(), terms.end(), [](Term const& left, Term const& right) { return left.Cost < right.Cost; });
+
+        _groups.push_back({ uint32(_terms.size()), uint32(terms.size()) });
+        _terms.insert(_terms.end(), terms.begin(), terms.end());
+    }
+}
+
+bool ConditionPlan::IsCompiledFrom(ConditionList const& conditions) const
+{
+    return conditions.size() == _source.size() && std::equal(conditions.begin(), conditions.end(), _source.begin());
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_CONDITIONPLAN_H
+#define ACORE_CONDITIONPLAN_H
+
+#include "ConditionMgr.h"
+#include <functional>
+#include <vector>
+
+/**
+ * @brief A condition list compiled into a flat OR of AND groups.
+ *
+ * The interpreter walks the std::list, builds a std::map of else groups and looks
+ * references up on every call. A plan does that work once at load time:
+ *  - conditions of one ElseGroup are stored next to each other, groups are tried
+ *    in order and evaluation stops at the first group that passes
+ *  - references with a single group are inlined, missing references and references
+ *    that always pass are dropped, a group left without terms makes the plan always pass
+ *  - unless the order has to be kept, the terms of a group are sorted cheapest first
+ *
+ * Plans hold raw pointers to the conditions they were compiled from, they must be
+ * dropped together with those conditions.
+ */
+class ConditionPlan
+{
+public:
+    // returns the compiled plan of a reference template, nullptr if there is none
+    typedef std::function<ConditionPlan const*(uint32 /*referenceId*/)> ReferenceResolver;
+
+    ConditionPlan() = default;
+
+    /**
+     * @brief Compiles the plan from a condition list.
+     *
+     * @param keepOrder Evaluate the conditions in list order. Needed when callers read
+     *                  ConditionSourceInfo::mLastFailedCondition (spell casts, references)
+     */
+    void Compile(ConditionList const& conditions, ReferenceResolver const& resolveReference, bool keepOrder);
+
+    // true if the plan was compiled from exactly these conditions
+    [[nodiscard]] bool IsCompiledFrom(ConditionList const& conditions) const;
+
+    [[nodiscard]] bool IsAlwaysTrue() const { return _alwaysTrue; }
+    [[nodiscard]] std::size_t GetGroupCount() const { return _groups.size(); }
+    [[nodiscard]] std::size_t GetTermCount() const { return _terms.size(); }
+
+    // check is called as bool(Condition*) for every condition that has to be tested
+    template<class Check>
+    bool Evaluate(Check const& check) const
+    {
+        if (_alwaysTrue)
+            return true;
+
+        for (Group const& group : _groups)
+        {
+            bool passed = true;
+            for (uint32 i = group.First; passed && i < group.First + group.Count; ++i)
+            {
+                Term const& term = _terms[i];
+                passed = term.Reference ? term.Reference->Evaluate(check) : check(term.Cond);
+            }
+
+            if (passed)
+                return true;
+        }
+
+        return false;
+    }
+
+    // relative cost of Condition::Meets for a condition type, lower is cheaper
+    static uint8 GetConditionCost(ConditionTypes type);
+
+private:
+    struct Term
+    {
+        Condition* Cond;
+        ConditionPlan const* Reference;
+        uint8 Cost;
+    };
+
+    struct Group
+    {
+        uint32 First;
+        uint32 Count;
+    };
+
+    std::vector<Condition*> _source;
+    std::vector<Term> _terms;
+    std::vector<Group> _groups;
+    bool _alwaysTrue = false;
+};
+
+#endif
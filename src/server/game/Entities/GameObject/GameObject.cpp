@@ -2606,6 +2606,9 @@ void GameObject::EnableCollision(bool enable)
         phaseMask = GetPhaseMask();
 
     m_model->enable(phaseMask);
+
+    if (IsInWorld())
+        GetMap()->InvalidateGameObjectModel();
 }
 
 void GameObject::UpdateModel()
@@ -2906,9 +2909,8 @@ void GameObject::UpdateModelPosition()
 
     if (GetMap()->ContainsGameObjectModel(*m_model))
     {
-        GetMap()->RemoveGameObjectModel(*m_model);
         m_model->UpdatePosition();
-        GetMap()->InsertGameObjectModel(*m_model);
+        GetMap()->MoveGameObjectModel(*m_model);
     }
 }
 
@@ -34,6 +34,7 @@
 #include "Channel.h"
 #include "CharacterCache.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterEnumCache.h"
 #include "Chat.h"
 #include "CombatLogPackets.h"
 #include "Common.h"
@@ -86,6 +87,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "Weather.h"
+#include "WhoListCacheMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -191,6 +193,7 @@ Player::Player(WorldSession* session): Unit(), m_mover(this)
     m_zoneUpdateTimer = 0;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_saveAtRisk = false;
 
     m_areaUpdateId = 0;
     m_team = TEAM_NEUTRAL;
@@ -2280,6 +2283,8 @@ void Player::SetGMVisible(bool on)
         m_ExtraFlags |= PLAYER_EXTRA_GM_INVISIBLE;
         SetServerSideVisibility(SERVERSIDE_VISIBILITY_GM, GetSession()->GetSecurity());
     }
+
+    sWhoListCacheMgr->UpdatePlayer(this);
 }
 
 bool Player::IsGroupVisibleFor(Player const* p) const
@@ -2445,6 +2450,8 @@ void Player::GiveLevel(uint8 level)
     if (Guild* guild = GetGuild())
         guild->UpdateMemberData(this, GUILD_MEMBER_DATA_LEVEL, level);
 
+    MarkSaveAtRisk();
+
     PlayerLevelInfo info;
     sObjectMgr->GetPlayerLevelInfo(getRace(true), getClass(), level, &info);
 
@@ -4222,7 +4229,7 @@ void Player::DeleteFromDB(ObjectGuid::LowType lowGuid, uint32 accountId, bool up
 
                 sScriptMgr->OnPlayerDeleteFromDB(trans, lowGuid);
 
-                CharacterDatabase.CommitTransaction(trans);
+                sCharacterEnumCache->CommitTransaction(accountId, trans);
                 break;
             }
         // The character gets unlinked from the account, the name gets freed up and appears as deleted ingame
@@ -4232,7 +4239,7 @@ void Player::DeleteFromDB(ObjectGuid::LowType lowGuid, uint32 accountId, bool up
 
                 stmt->SetData(0, lowGuid);
 
-                CharacterDatabase.Execute(stmt);
+                sCharacterEnumCache->ExecuteOrAppend(accountId, nullptr, stmt);
                 break;
             }
         default:
@@ -4502,7 +4509,7 @@ void Player::OfflineResurrect(ObjectGuid const& guid, CharacterDatabaseTransacti
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
     stmt->SetData(0, uint16(AT_LOGIN_RESURRECT));
     stmt->SetData(1, guid.GetCounter());
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
+    sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(guid), trans, stmt);
 }
 
 Corpse* Player::CreateCorpse()
@@ -4615,6 +4622,7 @@ void Player::SpawnCorpseBones(bool triggerSave /*= true*/)
             trans->Append(stmt);
 
             _SaveAuras(trans, false);
+            m_saveTracker.Invalidate(PLAYER_SAVE_AURAS);
 
             CharacterDatabase.CommitTransaction(trans);
         }
@@ -10065,6 +10073,14 @@ void Player::SendProficiency(ItemClass itemClass, uint32 itemSubclassMask)
     SendDirectMessage(&data);
 }
 
+void Player::SetInGuild(uint32 GuildId)
+{
+    SetUInt32Value(PLAYER_GUILDID, GuildId);
+    // xinef: update global storage
+    sCharacterCache->UpdateCharacterGuildId(GetGUID(), GetGuildId());
+    sWhoListCacheMgr->UpdatePlayer(this);
+}
+
 void Player::RemovePetitionsAndSigns(ObjectGuid guid, uint32 type)
 {
     SignatureContainer* signatureStore = sPetitionMgr->GetSignatureStore();
@@ -15446,6 +15462,9 @@ void Player::SetIsSpectator(bool on)
             }
         }
     }
+
+    // spectators are listed in Dalaran
+    sWhoListCacheMgr->UpdatePlayer(this);
 }
 
 bool Player::NeedSendSpectatorData() const
@@ -33,6 +33,7 @@
 #include "ObjectMgr.h"
 #include "Optional.h"
 #include "PetDefines.h"
+#include "PlayerSaveTracker.h"
 #include "PlayerSettings.h"
 #include "PlayerTaxi.h"
 #include "QuestDef.h"
@@ -1566,6 +1567,7 @@ public:
 
     void SaveToDB(bool create, bool logout);
     void SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout);
+    PlayerSaveTracker& GetSaveTracker() { return m_saveTracker; }
     void SaveInventoryAndGoldToDB(CharacterDatabaseTransaction trans);                    // fast save function for item/money cheating preventing
     void SaveGoldToDB(CharacterDatabaseTransaction trans);
     void _SaveSkills(CharacterDatabaseTransaction trans);
@@ -1875,12 +1877,7 @@ public:
     void RemoveFromGroup(RemoveMethod method = GROUP_REMOVEMETHOD_DEFAULT) { RemoveFromGroup(GetGroup(), GetGUID(), method); }
     void SendUpdateToOutOfRangeGroupMembers();
 
-    void SetInGuild(uint32 GuildId)
-    {
-        SetUInt32Value(PLAYER_GUILDID, GuildId);
-        // xinef: update global storage
-        sCharacterCache->UpdateCharacterGuildId(GetGUID(), GetGuildId());
-    }
+    void SetInGuild(uint32 GuildId);
     void SetRank(uint8 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
     [[nodiscard]] uint8 GetRank() const { return uint8(GetUInt32Value(PLAYER_GUILDRANK)); }
     void SetGuildIdInvited(uint32 GuildId) { m_GuildIdInvited = GuildId; }
@@ -2575,6 +2572,8 @@ public:
 
     // saving
     void AdditionalSavingAddMask(uint8 mask) { m_additionalSaveTimer = 2000; m_additionalSaveMask |= mask; }
+    // progress that would hurt to lose, moves the next autosave to the front of the save queue
+    void MarkSaveAtRisk() { m_saveAtRisk = true; }
     // arena spectator
     [[nodiscard]] bool IsSpectator() const { return m_ExtraFlags & PLAYER_EXTRA_SPECTATOR_ON; }
     void SetIsSpectator(bool on);
@@ -2792,6 +2791,8 @@ protected:
     uint32 m_nextSave; // pussywizard
     uint16 m_additionalSaveTimer; // pussywizard
     uint8 m_additionalSaveMask; // pussywizard
+    PlayerSaveTracker m_saveTracker;
+    bool m_saveAtRisk;
     uint16 m_hostileReferenceCheckTimer; // pussywizard
     std::array<ChatFloodThrottle, ChatFloodThrottle::MAX> m_chatFloodData;
     Difficulty m_dungeonDifficulty;
@@ -16,6 +16,8 @@
  */
 
 #include "AccountMgr.h"
+#include "CharacterCache.h"
+#include "CharacterEnumCache.h"
 #include "GameTime.h"
 #include "MapMgr.h"
 #include "Player.h"
@@ -93,7 +95,7 @@ void Player::SavePositionInDB(uint32 mapid, float x, float y, float z, float o,
     stmt->SetData(5, uint16(zone));
     stmt->SetData(6, guid.GetCounter());
 
-    CharacterDatabase.Execute(stmt);
+    sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(guid), nullptr, stmt);
 }
 
 void Player::SavePositionInDB(WorldLocation const& loc, uint16 zoneId, ObjectGuid guid, CharacterDatabaseTransaction trans)
@@ -108,7 +110,7 @@ void Player::SavePositionInDB(WorldLocation const& loc, uint16 zoneId, ObjectGui
     stmt->SetData(5, zoneId);
     stmt->SetData(6, guid.GetCounter());
 
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
+    sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(guid), trans, stmt);
 }
 
 void Player::Customize(CharacterCustomizeInfo const* customizeInfo, CharacterDatabaseTransaction trans)
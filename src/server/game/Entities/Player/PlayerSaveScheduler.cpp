@@ -0,0 +1,159 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveScheduler.h"
+#include "World.h"
+
+PlayerSaveScheduler* PlayerSaveScheduler::instance()
+{
+    static PlayerSaveScheduler instance;
+    return &instance;
+}
+
+void PlayerSaveScheduler::Update(uint32 diff)
+{
+    uint32 const maxPerSecond = sWorld->getIntConfig(CONFIG_PLAYER_SAVE_MAX_PER_SECOND);
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    // the limit was removed by a config reload, nobody has to wait anymore
+    if (!maxPerSecond)
+    {
+        GrantAll();
+        return;
+    }
+
+    // at most one second worth of saves can be stored up
+    _budget = std::min(_budget + float(maxPerSecond) * diff / IN_MILLISECONDS, float(maxPerSecond));
+
+    auto grantNext = [this](std::deque<ObjectGuid>& queue, SaveState queuedState, std::size_t& queued) -> bool
+    {
+        while (!queue.empty())
+        {
+            ObjectGuid guid = queue.front();
+            queue.pop_front();
+
+            auto itr = _states.find(guid);
+            if (itr == _states.end() || itr->second != queuedState)
+                continue;
+
+            itr->second = SaveState::Granted;
+            --queued;
+            return true;
+        }
+
+        return false;
+    };
+
+    while (_budget >= 1.0f)
+    {
+        if (!grantNext(_atRiskQueue, SaveState::QueuedAtRisk, _atRiskQueued) && !grantNext(_queue, SaveState::Queued, _queued))
+            break;
+
+        _budget -= 1.0f;
+    }
+}
+
+bool PlayerSaveScheduler::RequestSave(ObjectGuid guid, bool atRisk)
+{
+    if (!sWorld->getIntConfig(CONFIG_PLAYER_SAVE_MAX_PER_SECOND))
+        return true;
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _states.find(guid);
+    if (itr == _states.end())
+    {
+        Enqueue(guid, atRisk);
+        return false;
+    }
+
+    switch (itr->second)
+    {
+        case SaveState::Granted:
+            _states.erase(itr);
+            return true;
+        case SaveState::Queued:
+            // became at risk while waiting, moves to the front queue
+            if (atRisk)
+            {
+                _states.erase(itr);
+                --_queued;
+                Enqueue(guid, true);
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+void PlayerSaveScheduler::Forget(ObjectGuid guid)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _states.find(guid);
+    if (itr == _states.end())
+        return;
+
+    if (itr->second == SaveState::Queued)
+        --_queued;
+    else if (itr->second == SaveState::QueuedAtRisk)
+        --_atRiskQueued;
+
+    _states.erase(itr);
+
+    // the queues only hold stale entries now
+    if (!_queued && !_atRiskQueued)
+    {
+        _queue.clear();
+        _atRiskQueue.clear();
+    }
+}
+
+std::size_t PlayerSaveScheduler::GetQueueSize(bool atRisk) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return atRisk ? _atRiskQueued : _queued;
+}
+
+void PlayerSaveScheduler::Enqueue(ObjectGuid guid, bool atRisk)
+{
+    if (atRisk)
+    {
+        _states[guid] = SaveState::QueuedAtRisk;
+        _atRiskQueue.push_back(guid);
+        ++_atRiskQueued;
+    }
+    else
+    {
+        _states[guid] = SaveState::Queued;
+        _queue.push_back(guid);
+        ++_queued;
+    }
+}
+
+void PlayerSaveScheduler::GrantAll()
+{
+    for (auto& [guid, state] : _states)
+        state = SaveState::Granted;
+
+    _queue.clear();
+    _atRiskQueue.clear();
+    _queued = 0;
+    _atRiskQueued = 0;
+    _budget = 0.0f;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PLAYER_SAVE_SCHEDULER_H
+#define _PLAYER_SAVE_SCHEDULER_H
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Rate limits player autosaves.
+ *
+ * A player whose autosave timer ran out asks the scheduler before saving. Without a limit
+ * (PlayerSave.MaxPerSecond = 0) the save runs right away. Otherwise the player is queued,
+ * and on every world update the scheduler grants as many queued saves as the per second budget
+ * allows, players at risk of losing progress (level up, rare item) first. A granted player
+ * saves on its next update. A player that waited saves later than its timer, and its next save
+ * is counted from then on. This spreads saves that cluster after a restart or a mass login
+ * over the save interval.
+ *
+ * Only autosaves go through here. Logout saves and saves issued by the code run right away.
+ * Thread safe, players ask from the map threads.
+ */
+class PlayerSaveScheduler
+{
+public:
+    static PlayerSaveScheduler* instance();
+
+    // Refills the budget and grants queued saves, called by the world update
+    void Update(uint32 diff);
+
+    // True if the due autosave of the player may run now, queues the player otherwise
+    bool RequestSave(ObjectGuid guid, bool atRisk);
+
+    // Drops a queued or granted save, the player was saved some other way or left
+    void Forget(ObjectGuid guid);
+
+    [[nodiscard]] std::size_t GetQueueSize(bool atRisk) const;
+
+private:
+    PlayerSaveScheduler() = default;
+    ~PlayerSaveScheduler() = default;
+
+    PlayerSaveScheduler(PlayerSaveScheduler const&) = delete;
+    PlayerSaveScheduler& operator=(PlayerSaveScheduler const&) = delete;
+
+    enum class SaveState : uint8
+    {
+        Queued,
+        QueuedAtRisk,
+        Granted
+    };
+
+    void Enqueue(ObjectGuid guid, bool atRisk);
+    void GrantAll();
+
+    mutable std::mutex _lock;
+    std::unordered_map<ObjectGuid, SaveState> _states;
+    // queued players in request order, entries whose state changed meanwhile are skipped when granting
+    std::deque<ObjectGuid> _queue;
+    std::deque<ObjectGuid> _atRiskQueue;
+    std::size_t _queued = 0;
+    std::size_t _atRiskQueued = 0;
+    float _budget = 0.0f;
+};
+
+#define sPlayerSaveScheduler PlayerSaveScheduler::instance()
+
+#endif
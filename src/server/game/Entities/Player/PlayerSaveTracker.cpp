@@ -0,0 +1,107 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveTracker.h"
+#include "DatabaseEnv.h"
+#include "Metric.h"
+
+namespace
+{
+    struct SubsystemInfo
+    {
+        char const* Name;
+        bool Snapshot;      // deletes and inserts all of its rows on every save
+    };
+
+    constexpr std::array<SubsystemInfo, MAX_PLAYER_SAVE_SUBSYSTEMS> SubsystemInfos =
+    {{
+        { "character",       false },
+        { "mail",            false },
+        { "entry_point",     true  },
+        { "inventory",       false },
+        { "quests",          false },
+        { "talents",         false },
+        { "spells",          false },
+        { "spell_cooldowns", true  },
+        { "actions",         false },
+        { "auras",           true  },
+        { "skills",          false },
+        { "achievements",    false },
+        { "reputation",      false },
+        { "equipment_sets",  false },
+        { "tutorials",       false },
+        { "glyphs",          false },
+        { "instance_times",  true  },
+        { "settings",        true  },
+        { "stats",           true  },
+    }};
+}
+
+void PlayerSaveTracker::BeginSave(bool differential)
+{
+    _differential = differential;
+    _stats.fill(SubsystemStats());
+}
+
+void PlayerSaveTracker::Track(CharacterDatabaseTransaction const& trans, PlayerSaveSubsystem subsystem, std::function<void()> const& save)
+{
+    std::size_t const first = trans->GetSize();
+
+    save();
+
+    std::size_t const statements = trans->GetSize() - first;
+    if (!statements)
+        return;
+
+    SubsystemStats& stats = _stats[subsystem];
+    if (SubsystemInfos[subsystem].Snapshot)
+    {
+        uint64 const digest = trans->GetDigest(first);
+        if (_differential && digest == _digests[subsystem])
+        {
+            // same rows as written by the last save, the save function still ran for its side effects
+            trans->Truncate(first);
+            stats.SkippedStatements += uint32(statements);
+            return;
+        }
+
+        _digests[subsystem] = digest;
+    }
+
+    stats.Statements += uint32(statements);
+    stats.Bytes += uint32(trans->GetPayloadSize(first));
+}
+
+void PlayerSaveTracker::PublishMetrics() const
+{
+    // one point per subsystem that had something to write, totals are summed up by the dashboards
+    for (uint8 i = 0; i < MAX_PLAYER_SAVE_SUBSYSTEMS; ++i)
+    {
+        SubsystemStats const& stats = _stats[i];
+        if (!stats.Statements && !stats.SkippedStatements)
+            continue;
+
+        METRIC_VALUE("player_save_statements", stats.Statements, METRIC_TAG("subsystem", SubsystemInfos[i].Name));
+        METRIC_VALUE("player_save_bytes", stats.Bytes, METRIC_TAG("subsystem", SubsystemInfos[i].Name));
+        METRIC_VALUE("player_save_skipped_statements", stats.SkippedStatements, METRIC_TAG("subsystem", SubsystemInfos[i].Name));
+    }
+}
+
+char const* PlayerSaveTracker::GetSubsystemName(PlayerSaveSubsystem subsystem)
+{
+    return SubsystemInfos[subsystem].Name;
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PLAYER_SAVE_TRACKER_H
+#define _PLAYER_SAVE_TRACKER_H
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include <array>
+#include <functional>
+
+// Parts of a player written by Player::SaveToDB, in save order
+enum PlayerSaveSubsystem : uint8
+{
+    PLAYER_SAVE_CHARACTER,
+    PLAYER_SAVE_MAIL,
+    PLAYER_SAVE_ENTRY_POINT,
+    PLAYER_SAVE_INVENTORY,
+    PLAYER_SAVE_QUESTS,
+    PLAYER_SAVE_TALENTS,
+    PLAYER_SAVE_SPELLS,
+    PLAYER_SAVE_SPELL_COOLDOWNS,
+    PLAYER_SAVE_ACTIONS,
+    PLAYER_SAVE_AURAS,
+    PLAYER_SAVE_SKILLS,
+    PLAYER_SAVE_ACHIEVEMENTS,
+    PLAYER_SAVE_REPUTATION,
+    PLAYER_SAVE_EQUIPMENT_SETS,
+    PLAYER_SAVE_TUTORIALS,
+    PLAYER_SAVE_GLYPHS,
+    PLAYER_SAVE_INSTANCE_TIMES,
+    PLAYER_SAVE_SETTINGS,
+    PLAYER_SAVE_STATS,
+
+    MAX_PLAYER_SAVE_SUBSYSTEMS
+};
+
+/**
+ * @brief Accounts the statements each subsystem adds to a player save and skips unchanged snapshots.
+ *
+ * Most subsystems keep per row states (item states, quest and skill save states, changed flags)
+ * and only write what changed since the last save. A few of them (entry point, spell cooldowns,
+ * auras, instance lock times, settings, stats) delete and insert their whole row set every time.
+ * For those the tracker remembers a digest of the statements of the last save and drops the
+ * statements again when the new ones are identical, so any number of changes between two saves
+ * that end up in the same rows cost nothing.
+ *
+ * Statements written outside of SaveToDB for a snapshot subsystem must Invalidate() it, and a save
+ * whose commit failed must InvalidateSnapshots(), as the digests are taken when the statements are queued.
+ */
+class PlayerSaveTracker
+{
+public:
+    struct SubsystemStats
+    {
+        uint32 Statements = 0;
+        uint32 Bytes = 0;
+        uint32 SkippedStatements = 0;
+    };
+
+    PlayerSaveTracker() = default;
+
+    // Starts a new save, snapshot subsystems are only skipped when differential is set
+    void BeginSave(bool differential);
+
+    // Runs save and accounts the statements it appended to trans
+    void Track(CharacterDatabaseTransaction const& trans, PlayerSaveSubsystem subsystem, std::function<void()> const& save);
+
+    // The next save writes the subsystem even if it looks unchanged
+    void Invalidate(PlayerSaveSubsystem subsystem) { _digests[subsystem] = 0; }
+    // The next save writes all snapshot subsystems
+    void InvalidateSnapshots() { _digests.fill(0); }
+
+    // Sends the statements and bytes of the current save to the metrics
+    void PublishMetrics() const;
+
+    [[nodiscard]] SubsystemStats const& GetStats(PlayerSaveSubsystem subsystem) const { return _stats[subsystem]; }
+
+    static char const* GetSubsystemName(PlayerSaveSubsystem subsystem);
+
+private:
+    std::array<uint64, MAX_PLAYER_SAVE_SUBSYSTEMS> _digests{};
+    std::array<SubsystemStats, MAX_PLAYER_SAVE_SUBSYSTEMS> _stats{};
+    bool _differential = false;
+};
+
+#endif
@@ -23,6 +23,7 @@
 #include "Battleground.h"
 #include "BattlegroundMgr.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterEnumCache.h"
 #include "Chat.h"
 #include "Common.h"
 #include "Config.h"
@@ -47,6 +48,7 @@
 #include "OutdoorPvP.h"
 #include "Pet.h"
 #include "Player.h"
+#include "PlayerSaveScheduler.h"
 #include "QueryHolder.h"
 #include "QuestDef.h"
 #include "ReputationMgr.h"
@@ -2547,7 +2549,10 @@ Item* Player::StoreNewItem(ItemPosCountVec const& dest, uint32 item, bool update
         // pussywizard: obtaining blue or better items saves to db
         if (ItemTemplate const* pProto = sObjectMgr->GetItemTemplate(item))
             if (pProto->Quality >= ITEM_QUALITY_RARE)
+            {
                 AdditionalSavingAddMask(ADDITIONAL_SAVING_INVENTORY_AND_GOLD);
+                MarkSaveAtRisk();
+            }
 
         ItemAddedQuestCheck(item, count);
 
@@ -4964,7 +4969,7 @@ bool Player::LoadFromDB(ObjectGuid playerGuid, CharacterDatabaseQueryHolder cons
         CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
         stmt->SetData(0, uint16(AT_LOGIN_RENAME));
         stmt->SetData(1, guid);
-        CharacterDatabase.Execute(stmt);
+        sCharacterEnumCache->ExecuteOrAppend(GetSession()->GetAccountId(), nullptr, stmt);
         return false;
     }
 
@@ -7057,7 +7062,14 @@ void Player::SaveToDB(bool create, bool logout)
 
     SaveToDB(trans, create, logout);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // the character screen shows level, zone and equipment as saved now, it is not cached again before the commit
+    sCharacterEnumCache->AddSave(GetSession()->GetAccountId(), CharacterDatabase.AsyncCommitTransaction(trans), [guid = GetGUID()](bool success)
+    {
+        // the skipped snapshots of later saves rely on this one, write them all again
+        if (!success)
+            if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
+                player->GetSaveTracker().InvalidateSnapshots();
+    });
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout)
@@ -7076,6 +7088,10 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     m_additionalSaveTimer = 0;
     m_additionalSaveMask = 0;
 
+    // a queued autosave is covered by this one
+    m_saveAtRisk = false;
+    sPlayerSaveScheduler->Forget(GetGUID());
+
     // first save/honor gain after midnight will also update the player's honor fields
     UpdateHonorFields();
 
@@ -7085,36 +7101,44 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
-    _SaveCharacter(create, trans);
+    // a character that is created has nothing in the db to compare with
+    m_saveTracker.BeginSave(!create && sWorld->getBoolConfig(CONFIG_PLAYER_SAVE_DIFFERENTIAL));
 
-    if (m_mailsUpdated)                                     //save mails only when needed
-        _SaveMail(trans);
+    m_saveTracker.Track(trans, PLAYER_SAVE_CHARACTER, [&]() { _SaveCharacter(create, trans); });
 
-    _SaveEntryPoint(trans);
-    _SaveInventory(trans);
-    _SaveQuestStatus(trans);
-    _SaveDailyQuestStatus(trans);
-    _SaveWeeklyQuestStatus(trans);
-    _SaveSeasonalQuestStatus(trans);
-    _SaveMonthlyQuestStatus(trans);
-    _SaveTalents(trans);
-    _SaveSpells(trans);
-    _SaveSpellCooldowns(trans, logout);
-    _SaveActions(trans);
-    _SaveAuras(trans, logout);
-    _SaveSkills(trans);
-    m_achievementMgr->SaveToDB(trans);
-    m_reputationMgr->SaveToDB(trans);
-    _SaveEquipmentSets(trans);
-    GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
-    _SaveGlyphs(trans);
-    _SaveInstanceTimeRestrictions(trans);
-    _SavePlayerSettings(trans);
+    if (m_mailsUpdated)                                     //save mails only when needed
+        m_saveTracker.Track(trans, PLAYER_SAVE_MAIL, [&]() { _SaveMail(trans); });
+
+    m_saveTracker.Track(trans, PLAYER_SAVE_ENTRY_POINT, [&]() { _SaveEntryPoint(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_INVENTORY, [&]() { _SaveInventory(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_QUESTS, [&]()
+    {
+        _SaveQuestStatus(trans);
+        _SaveDailyQuestStatus(trans);
+        _SaveWeeklyQuestStatus(trans);
+        _SaveSeasonalQuestStatus(trans);
+        _SaveMonthlyQuestStatus(trans);
+    });
+    m_saveTracker.Track(trans, PLAYER_SAVE_TALENTS, [&]() { _SaveTalents(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_SPELLS, [&]() { _SaveSpells(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_SPELL_COOLDOWNS, [&]() { _SaveSpellCooldowns(trans, logout); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_ACTIONS, [&]() { _SaveActions(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_AURAS, [&]() { _SaveAuras(trans, logout); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_SKILLS, [&]() { _SaveSkills(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_ACHIEVEMENTS, [&]() { m_achievementMgr->SaveToDB(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_REPUTATION, [&]() { m_reputationMgr->SaveToDB(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_EQUIPMENT_SETS, [&]() { _SaveEquipmentSets(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_TUTORIALS, [&]() { GetSession()->SaveTutorialsData(trans); }); // changed only while character in game
+    m_saveTracker.Track(trans, PLAYER_SAVE_GLYPHS, [&]() { _SaveGlyphs(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_INSTANCE_TIMES, [&]() { _SaveInstanceTimeRestrictions(trans); });
+    m_saveTracker.Track(trans, PLAYER_SAVE_SETTINGS, [&]() { _SavePlayerSettings(trans); });
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
-        _SaveStats(trans);
+        m_saveTracker.Track(trans, PLAYER_SAVE_STATS, [&]() { _SaveStats(trans); });
+
+    m_saveTracker.PublishMetrics();
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
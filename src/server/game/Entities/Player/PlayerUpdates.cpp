@@ -30,6 +30,7 @@
 #include "OutdoorPvPMgr.h"
 #include "Pet.h"
 #include "Player.h"
+#include "PlayerSaveScheduler.h"
 #include "ScriptMgr.h"
 #include "SkillDiscovery.h"
 #include "SpellAuraEffects.h"
@@ -38,6 +39,7 @@
 #include "Vehicle.h"
 #include "Weather.h"
 #include "WeatherMgr.h"
+#include "WhoListCacheMgr.h"
 #include "WorldState.h"
 #include "WorldStatePackets.h"
 
@@ -77,6 +79,9 @@ void Player::Update(uint32 p_time)
         _cinematicMgr->UpdateCinematicLocation(p_time);
     }
 
+    // send movement of far away players kept back by movement interest management
+    GetSession()->FlushCoalescedMovement();
+
     // used to implement delayed far teleports
     SetMustDelayTeleport(true);
     ProcessSpellQueue();
@@ -345,9 +350,12 @@ void Player::Update(uint32 p_time)
     {
         if (p_time >= m_nextSave)
         {
-            // m_nextSave reset in SaveToDB call
-            SaveToDB(false, false);
-            LOG_DEBUG("entities.player", "Player::Update: Player '{}' ({}) saved", GetName(), GetGUID().ToString());
+            // stays due until the scheduler lets it run, m_nextSave reset in SaveToDB call
+            if (sPlayerSaveScheduler->RequestSave(GetGUID(), m_saveAtRisk))
+            {
+                SaveToDB(false, false);
+                LOG_DEBUG("entities.player", "Player::Update: Player '{}' ({}) saved", GetName(), GetGUID().ToString());
+            }
         }
         else
         {
@@ -1304,6 +1312,8 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea, bool force)
     m_zoneUpdateId    = newZone;
     m_zoneUpdateTimer = ZONE_UPDATE_INTERVAL;
 
+    sWhoListCacheMgr->UpdatePlayer(this);
+
     // zone changed, so area changed as well, update it
     UpdateArea(newArea);
 
@@ -69,6 +69,7 @@
 #include "UpdateFields.h"
 #include "Util.h"
 #include "Vehicle.h"
+#include "WhoListCacheMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include <cmath>
@@ -4602,6 +4603,9 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     AuraApplication* aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
 
+    if (uint32 procFlags = aura->GetProcCandidateFlags())
+        m_procAuraApplications.insert(AuraApplicationProcMap::value_type(aurId, std::make_pair(aurApp, procFlags)));
+
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: even if it gets removed, it will be reapplied in a second
     if (aurSpellInfo->AuraInterruptFlags && this == aura->GetOwner())
@@ -4698,6 +4702,19 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
 
+    if (aura->GetProcCandidateFlags())
+    {
+        AuraApplicationProcMap::iterator procEnd = m_procAuraApplications.upper_bound(aura->GetId());
+        for (AuraApplicationProcMap::iterator procItr = m_procAuraApplications.lower_bound(aura->GetId()); procItr != procEnd; ++procItr)
+        {
+            if (procItr->second.first == aurApp)
+            {
+                m_procAuraApplications.erase(procItr);
+                break;
+            }
+        }
+    }
+
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: event if it gets removed, it will be reapplied in a second
     if (aura->GetSpellInfo()->AuraInterruptFlags && this == aura->GetOwner())
@@ -14404,6 +14421,9 @@ void Unit::SetVisible(bool x)
     else
         m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GM, SEC_PLAYER);
 
+    if (Player* player = ToPlayer())
+        sWhoListCacheMgr->UpdatePlayer(player);
+
     UpdateObjectVisibility();
 }
 
@@ -15711,6 +15731,7 @@ void Unit::SetLevel(uint8 lvl, bool showLevelChange)
     if (IsPlayer())
     {
         sCharacterCache->UpdateCharacterLevel(GetGUID(), lvl);
+        sWhoListCacheMgr->UpdatePlayer(ToPlayer());
     }
 }
 
@@ -16369,24 +16390,29 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, procPhase, procExtra, procSpell, damageInfo, healInfo, procAura, procAuraEffectIndex);
 
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+    // Fill procTriggered list, only auras reacting to one of the event proc flags are visited
+    for (AuraApplicationProcMap::const_iterator itr = m_procAuraApplications.begin(); itr != m_procAuraApplications.end(); ++itr)
     {
+        if (!(itr->second.second & procFlag))
+            continue;
+
+        AuraApplication* aurApp = itr->second.first;
+
         // Do not allow auras to proc from effect triggered by itself
         if (procAura && procAura->Id == itr->first)
             continue;
 
         // Xinef: Generic Item Equipment cooldown, -1 is a special marker
-        if (itr->second->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(itr->first, uint32(-1)))
+        if (aurApp->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(itr->first, uint32(-1)))
             continue;
 
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aurApp->GetBase());
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
         if (isVictim)
             procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
         // only auras that have trigger spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -16399,7 +16425,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             active = true;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(aurApp, eventInfo))
         {
             continue;
         }
@@ -16407,7 +16433,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool isTriggeredAtSpellProcEvent = IsTriggeredAtSpellProcEvent(target, triggerData.aura, attType, isVictim, active, triggerData.spellProcEvent, eventInfo);
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(itr->second, eventInfo, isTriggeredAtSpellProcEvent))
+        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(aurApp, eventInfo, isTriggeredAtSpellProcEvent))
         {
             continue;
         }
@@ -16423,9 +16449,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool hasTriggeredProc = false;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
 
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
@@ -16750,12 +16776,16 @@ void Unit::GetProcAurasTriggeredOnEvent(std::list<AuraApplication*>& aurasTrigge
     // or generate one on our own
     else
     {
-        for (AuraApplicationMap::iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+        for (AuraApplicationProcMap::iterator itr = m_procAuraApplications.begin(); itr != m_procAuraApplications.end(); ++itr)
         {
-            if (itr->second->GetBase()->IsProcTriggeredOnEvent(itr->second, eventInfo))
+            if (!(itr->second.second & eventInfo.GetTypeMask()))
+                continue;
+
+            AuraApplication* aurApp = itr->second.first;
+            if (aurApp->GetBase()->IsProcTriggeredOnEvent(aurApp, eventInfo))
             {
-                itr->second->GetBase()->PrepareProcToTrigger(itr->second, eventInfo);
-                aurasTriggeringProc.push_back(itr->second);
+                aurApp->GetBase()->PrepareProcToTrigger(aurApp, eventInfo);
+                aurasTriggeringProc.push_back(aurApp);
             }
         }
     }
@@ -19332,10 +19362,8 @@ void Unit::SetPhaseMask(uint32 newPhaseMask, bool update)
                 ThreatContainer::StorageType threatList = GetThreatMgr().GetThreatList();
                 ThreatContainer::StorageType offlineThreatList = GetThreatMgr().GetOfflineThreatList();
 
-                // merge expects sorted lists
-                threatList.sort();
-                offlineThreatList.sort();
-                threatList.merge(offlineThreatList);
+                threatList.insert(threatList.end(), offlineThreatList.begin(), offlineThreatList.end());
+                std::sort(threatList.begin(), threatList.end());
 
                 for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                     if (Unit* unit = (*itr)->getTarget())
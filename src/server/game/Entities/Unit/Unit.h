@@ -664,6 +664,7 @@ public:
     typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
     typedef std::pair<AuraApplicationMap::const_iterator, AuraApplicationMap::const_iterator> AuraApplicationMapBounds;
     typedef std::pair<AuraApplicationMap::iterator, AuraApplicationMap::iterator> AuraApplicationMapBoundsNonConst;
+    typedef std::multimap<uint32, std::pair<AuraApplication*, uint32 /*procFlags*/>> AuraApplicationProcMap;
 
     typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
@@ -2147,6 +2148,7 @@ protected:
 
     AuraMap m_ownedAuras;
     AuraApplicationMap m_appliedAuras;
+    AuraApplicationProcMap m_procAuraApplications; // applied auras which can proc, in m_appliedAuras order, with the proc flags they react to
     AuraList m_removedAuras;
     AuraMap::iterator m_auraUpdateIterator;
     uint32 m_removedAurasCount;
@@ -6276,129 +6276,6 @@ void ObjectMgr::LoadNpcTextLocales()
     LOG_INFO("server.loading", ">> Loaded {} Npc Text Locale Strings in {} ms", (uint32)_npcTextLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
-void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
-{
-    uint32 oldMSTime = getMSTime();
-
-    time_t curTime = GameTime::GetGameTime().count();
-
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
-    stmt->SetData(0, uint32(curTime));
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-    if (!result)
-        return;
-
-    std::map<uint32 /*messageId*/, MailItemInfoVec> itemsCache;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
-    stmt->SetData(0, uint32(curTime));
-    if (PreparedQueryResult items = CharacterDatabase.Query(stmt))
-    {
-        MailItemInfo item;
-        do
-        {
-            Field* fields = items->Fetch();
-            item.item_guid = fields[0].Get<uint32>();
-            item.item_template = fields[1].Get<uint32>();
-            uint32 mailId = fields[2].Get<uint32>();
-            itemsCache[mailId].push_back(item);
-        } while (items->NextRow());
-    }
-
-    uint32 deletedCount = 0;
-    uint32 returnedCount = 0;
-    do
-    {
-        Field* fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID      = fields[0].Get<uint32>();
-        m->messageType    = fields[1].Get<uint8>();
-        m->sender         = fields[2].Get<uint32>();
-        m->receiver       = fields[3].Get<uint32>();
-        bool has_items    = fields[4].Get<bool>();
-        m->expire_time    = time_t(fields[5].Get<uint32>());
-        m->deliver_time   = time_t(0);
-        m->stationery     = fields[6].Get<uint8>();
-        m->checked        = fields[7].Get<uint8>();
-        m->mailTemplateId = fields[8].Get<int16>();
-
-        Player* player = nullptr;
-        if (serverUp)
-            player = ObjectAccessor::FindPlayerByLowGUID(m->receiver);
-
-        if (player) // don't modify mails of a logged in player
-        {
-            delete m;
-            continue;
-        }
-
-        // Delete or return mail
-        if (has_items)
-        {
-            // read items from cache
-            m->items.swap(itemsCache[m->messageID]);
-
-            // If it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (!m->IsSentByPlayer() || m->IsSentByGM() || (m->IsCODPayment() || m->IsReturnedMail()))
-            {
-                for (auto const& mailedItem : m->items)
-                {
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
-                    stmt->SetData(0, mailedItem.item_guid);
-                    CharacterDatabase.Execute(stmt);
-                }
-
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
-                stmt->SetData(0, m->messageID);
-                CharacterDatabase.Execute(stmt);
-            }
-            else
-            {
-                // Mail will be returned
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
-                stmt->SetData(0, m->receiver);
-                stmt->SetData(1, m->sender);
-                stmt->SetData(2, uint32(curTime + 30 * DAY));
-                stmt->SetData(3, uint32(curTime));
-                stmt->SetData (4, uint8(MAIL_CHECK_MASK_RETURNED));
-                stmt->SetData(5, m->messageID);
-                CharacterDatabase.Execute(stmt);
-                for (auto const& mailedItem : m->items)
-                {
-                    // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
-                    stmt->SetData(0, m->sender);
-                    stmt->SetData(1, mailedItem.item_guid);
-                    CharacterDatabase.Execute(stmt);
-
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
-                    stmt->SetData(0, m->sender);
-                    stmt->SetData(1, mailedItem.item_guid);
-                    CharacterDatabase.Execute(stmt);
-                }
-
-                // xinef: update global data
-                sCharacterCache->IncreaseCharacterMailCount(ObjectGuid(HighGuid::Player, m->sender));
-                sCharacterCache->DecreaseCharacterMailCount(ObjectGuid(HighGuid::Player, m->receiver));
-
-                delete m;
-                ++returnedCount;
-                continue;
-            }
-        }
-
-        sCharacterCache->DecreaseCharacterMailCount(ObjectGuid(HighGuid::Player, m->receiver));
-
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
-        stmt->SetData(0, m->messageID);
-        CharacterDatabase.Execute(stmt);
-        delete m;
-        ++deletedCount;
-    } while (result->NextRow());
-
-    LOG_INFO("server.loading", ">> Processed {} expired mails: {} deleted and {} returned in {} ms", deletedCount + returnedCount, deletedCount, returnedCount, GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server.loading", " ");
-}
-
 void ObjectMgr::LoadQuestAreaTriggers()
 {
     uint32 oldMSTime = getMSTime();
@@ -3,17 +3,58 @@
 #include "GridTerrainData.h"
 #include "Log.h"
 #include "MapDefines.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
 #include <filesystem>
 #include <G3D/Ray.h>
 
 uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
 uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
 
-GridTerrainData::GridTerrainData()
+namespace
+{
+    static_assert(sizeof(LoadedHeightData::Uint16HeightData) == sizeof(LoadedHeightData::Uint16HeightData::V9Type) + sizeof(LoadedHeightData::Uint16HeightData::V8Type));
+    static_assert(sizeof(LoadedHeightData::Uint8HeightData) == sizeof(LoadedHeightData::Uint8HeightData::V9Type) + sizeof(LoadedHeightData::Uint8HeightData::V8Type));
+    static_assert(sizeof(LoadedHeightData::FloatHeightData) == sizeof(LoadedHeightData::FloatHeightData::V9Type) + sizeof(LoadedHeightData::FloatHeightData::V8Type));
+
+    uint32 AlignSectionOffset(uint32 offset)
+    {
+        return (offset + MapSectionAlignment - 1) & ~(MapSectionAlignment - 1);
+    }
+
+    // Returns the object at position inside the section and advances position past it, nullptr if the section is too small
+    template<class T>
+    T const* ReadSection(uint8 const* data, uint32 const size, uint32& position, uint32 const count = 1)
+    {
+        if (uint64(size - position) < uint64(sizeof(T)) * count)
+            return nullptr;
+
+        T const* result = reinterpret_cast<T const*>(data + position);
+        position += sizeof(T) * count;
+        return result;
+    }
+
+    // Same as ReadSection but copies the object, for data that is not aligned in the file
+    template<class T>
+    bool CopySection(uint8 const* data, uint32 const size, uint32& position, T& result)
+    {
+        if (size - position < sizeof(T))
+            return false;
+
+        std::memcpy(&result, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+}
+
+GridTerrainData::GridTerrainData() : _fileData(nullptr), _fileSize(0)
 {
     _gridGetHeight = &GridTerrainData::getHeightFromFlat;
 }
 
+GridTerrainData::~GridTerrainData() = default;
+
 TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
 {
     // Check if file exists, we do this first as we need to
@@ -32,84 +73,181 @@ TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
         return TerrainMapDataReadResult::ReadError;
 
     // Check for valid map and version magics
-    if (header.mapMagic != MapMagic.asUInt || header.versionMagic != MapVersionMagic)
+    if (header.versionMagic != MapVersionMagic)
+        return TerrainMapDataReadResult::InvalidMagic;
+
+    if (header.mapMagic == MapAlignedMagic.asUInt)
+    {
+        // Converted files are used in place
+        fileStream.close();
+        if (!MapFile(mapFileName))
+            return TerrainMapDataReadResult::ReadError;
+    }
+    else if (header.mapMagic == MapMagic.asUInt)
+    {
+        if (!ReadFileAligned(fileStream, header))
+            return TerrainMapDataReadResult::ReadError;
+    }
+    else
         return TerrainMapDataReadResult::InvalidMagic;
 
+    return LoadSections(header);
+}
+
+bool GridTerrainData::MapFile(std::string const& mapFileName)
+{
+    try
+    {
+        boost::interprocess::file_mapping file(mapFileName.c_str(), boost::interprocess::read_only);
+        _mappedFile = std::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        LOG_ERROR("maps", "Unable to map file '{}': {}", mapFileName, e.what());
+        return false;
+    }
+
+    _fileData = static_cast<uint8 const*>(_mappedFile->get_address());
+    _fileSize = _mappedFile->get_size();
+    return true;
+}
+
+bool GridTerrainData::ReadFileAligned(std::ifstream& fileStream, map_fileheader& header)
+{
+    struct Section
+    {
+        uint32& Offset;
+        uint32 Size;
+        uint32 FileOffset;
+    };
+
+    std::array<Section, 4> sections =
+    { {
+        { header.areaMapOffset, header.areaMapSize, header.areaMapOffset },
+        { header.heightMapOffset, header.heightMapSize, header.heightMapOffset },
+        { header.liquidMapOffset, header.liquidMapSize, header.liquidMapOffset },
+        { header.holesOffset, header.holesSize, header.holesOffset }
+    } };
+
+    // Lay the sections out like map_converter does
+    uint32 size = AlignSectionOffset(sizeof(header));
+    for (Section& section : sections)
+    {
+        if (!section.Offset || !section.Size)
+            continue;
+
+        section.Offset = size;
+        size = AlignSectionOffset(size + section.Size);
+    }
+
+    header.mapMagic = MapAlignedMagic.asUInt;
+
+    _fileBuffer.resize(size);
+    std::memcpy(_fileBuffer.data(), &header, sizeof(header));
+
+    for (Section const& section : sections)
+    {
+        if (!section.Offset || !section.Size)
+            continue;
+
+        fileStream.seekg(section.FileOffset);
+        if (!fileStream.read(reinterpret_cast<char*>(&_fileBuffer[section.Offset]), section.Size))
+            return false;
+    }
+
+    _fileData = _fileBuffer.data();
+    _fileSize = _fileBuffer.size();
+    return true;
+}
+
+TerrainMapDataReadResult GridTerrainData::LoadSections(map_fileheader const& header)
+{
     // Load area data
-    if (header.areaMapOffset && !LoadAreaData(fileStream, header.areaMapOffset))
+    if (header.areaMapOffset && !LoadAreaData(header.areaMapOffset, header.areaMapSize))
         return TerrainMapDataReadResult::InvalidAreaData;
 
     // Load height data
-    if (header.heightMapOffset && !LoadHeightData(fileStream, header.heightMapOffset))
+    if (header.heightMapOffset && !LoadHeightData(header.heightMapOffset, header.heightMapSize))
         return TerrainMapDataReadResult::InvalidHeightData;
 
     // Load liquid data
-    if (header.liquidMapOffset && !LoadLiquidData(fileStream, header.liquidMapOffset))
+    if (header.liquidMapOffset && !LoadLiquidData(header.liquidMapOffset, header.liquidMapSize))
         return TerrainMapDataReadResult::InvalidLiquidData;
 
     // Load hole data
-    if (header.holesSize && !LoadHolesData(fileStream, header.holesOffset))
+    if (header.holesSize && !LoadHolesData(header.holesOffset, header.holesSize))
         return TerrainMapDataReadResult::InvalidHoleData;
 
     return TerrainMapDataReadResult::Success;
 }
 
-bool GridTerrainData::LoadAreaData(std::ifstream& fileStream, uint32 const offset)
+uint8 const* GridTerrainData::GetSectionData(uint32 const offset, uint32 const size) const
 {
-    fileStream.seekg(offset);
+    if (offset % MapSectionAlignment || offset > _fileSize || size > _fileSize - offset)
+        return nullptr;
 
-    map_areaHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapAreaMagic.asUInt)
+    return _fileData + offset;
+}
+
+bool GridTerrainData::LoadAreaData(uint32 const offset, uint32 const size)
+{
+    uint8 const* data = GetSectionData(offset, size);
+    if (!data)
+        return false;
+
+    uint32 position = 0;
+    map_areaHeader const* header = ReadSection<map_areaHeader>(data, size, position);
+    if (!header || header->fourcc != MapAreaMagic.asUInt)
         return false;
 
     _loadedAreaData = std::make_unique<LoadedAreaData>();
-    _loadedAreaData->gridArea = header.gridArea;
-    if (!(header.flags & MAP_AREA_NO_AREA))
+    _loadedAreaData->gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
     {
-        _loadedAreaData->areaMap = std::make_unique<LoadedAreaData::AreaMapType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedAreaData->areaMap.get()), sizeof(LoadedAreaData::AreaMapType)))
+        _loadedAreaData->areaMap = ReadSection<LoadedAreaData::AreaMapType>(data, size, position);
+        if (!_loadedAreaData->areaMap)
             return false;
     }
     return true;
 }
 
-bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadHeightData(uint32 const offset, uint32 const size)
 {
-    fileStream.seekg(offset);
+    uint8 const* data = GetSectionData(offset, size);
+    if (!data)
+        return false;
 
-    map_heightHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapHeightMagic.asUInt)
+    uint32 position = 0;
+    map_heightHeader const* header = ReadSection<map_heightHeader>(data, size, position);
+    if (!header || header->fourcc != MapHeightMagic.asUInt)
         return false;
 
     _loadedHeightData = std::make_unique<LoadedHeightData>();
-    _loadedHeightData->gridHeight = header.gridHeight;
-    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    _loadedHeightData->gridHeight = header->gridHeight;
+    if (!(header->flags & MAP_HEIGHT_NO_HEIGHT))
     {
-        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        if ((header->flags & MAP_HEIGHT_AS_INT16))
         {
-            _loadedHeightData->uint16HeightData = std::make_unique<LoadedHeightData::Uint16HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v9), sizeof(_loadedHeightData->uint16HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v8), sizeof(_loadedHeightData->uint16HeightData->v8)))
+            _loadedHeightData->uint16HeightData = ReadSection<LoadedHeightData::Uint16HeightData>(data, size, position);
+            if (!_loadedHeightData->uint16HeightData)
                 return false;
 
-            _loadedHeightData->uint16HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            _loadedHeightData->gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
             _gridGetHeight = &GridTerrainData::getHeightFromUint16;
         }
-        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        else if ((header->flags & MAP_HEIGHT_AS_INT8))
         {
-            _loadedHeightData->uint8HeightData = std::make_unique<LoadedHeightData::Uint8HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v9), sizeof(_loadedHeightData->uint8HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v8), sizeof(_loadedHeightData->uint8HeightData->v8)))
+            _loadedHeightData->uint8HeightData = ReadSection<LoadedHeightData::Uint8HeightData>(data, size, position);
+            if (!_loadedHeightData->uint8HeightData)
                 return false;
 
-            _loadedHeightData->uint8HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            _loadedHeightData->gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
             _gridGetHeight = &GridTerrainData::getHeightFromUint8;
         }
         else
         {
-            _loadedHeightData->floatHeightData = std::make_unique<LoadedHeightData::FloatHeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v9), sizeof(_loadedHeightData->floatHeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v8), sizeof(_loadedHeightData->floatHeightData->v8)))
+            _loadedHeightData->floatHeightData = ReadSection<LoadedHeightData::FloatHeightData>(data, size, position);
+            if (!_loadedHeightData->floatHeightData)
                 return false;
 
             _gridGetHeight = &GridTerrainData::getHeightFromFloat;
@@ -118,12 +256,12 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
     else
         _gridGetHeight = &GridTerrainData::getHeightFromFlat;
 
-    if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
+    if (header->flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
         std::array<int16, 9> maxHeights;
         std::array<int16, 9> minHeights;
-        if (!fileStream.read(reinterpret_cast<char*>(maxHeights.data()), sizeof(maxHeights)) ||
-            !fileStream.read(reinterpret_cast<char*>(minHeights.data()), sizeof(minHeights)))
+        if (!CopySection(data, size, position, maxHeights) ||
+            !CopySection(data, size, position, minHeights))
             return false;
 
         static uint32 constexpr indices[8][3] =
@@ -163,49 +301,55 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
     return true;
 }
 
-bool GridTerrainData::LoadLiquidData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadLiquidData(uint32 const offset, uint32 const size)
 {
-    fileStream.seekg(offset);
+    uint8 const* data = GetSectionData(offset, size);
+    if (!data)
+        return false;
 
-    map_liquidHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapLiquidMagic.asUInt)
+    uint32 position = 0;
+    map_liquidHeader const* header = ReadSection<map_liquidHeader>(data, size, position);
+    if (!header || header->fourcc != MapLiquidMagic.asUInt)
         return false;
 
     _loadedLiquidData = std::make_unique<LoadedLiquidData>();
-    _loadedLiquidData->liquidGlobalEntry = header.liquidType;
-    _loadedLiquidData->liquidGlobalFlags = header.liquidFlags;
-    _loadedLiquidData->liquidOffX = header.offsetX;
-    _loadedLiquidData->liquidOffY = header.offsetY;
-    _loadedLiquidData->liquidWidth = header.width;
-    _loadedLiquidData->liquidHeight = header.height;
-    _loadedLiquidData->liquidLevel = header.liquidLevel;
-
-    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    _loadedLiquidData->liquidGlobalEntry = header->liquidType;
+    _loadedLiquidData->liquidGlobalFlags = header->liquidFlags;
+    _loadedLiquidData->liquidOffX = header->offsetX;
+    _loadedLiquidData->liquidOffY = header->offsetY;
+    _loadedLiquidData->liquidWidth = header->width;
+    _loadedLiquidData->liquidHeight = header->height;
+    _loadedLiquidData->liquidLevel = header->liquidLevel;
+
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
     {
-        _loadedLiquidData->liquidEntry = std::make_unique<LoadedLiquidData::LiquidEntryType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidEntry.get()), sizeof(LoadedLiquidData::LiquidEntryType)))
+        _loadedLiquidData->liquidEntry = ReadSection<LoadedLiquidData::LiquidEntryType>(data, size, position);
+        if (!_loadedLiquidData->liquidEntry)
             return false;
 
-        _loadedLiquidData->liquidFlags = std::make_unique<LoadedLiquidData::LiquidFlagsType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidFlags.get()), sizeof(LoadedLiquidData::LiquidFlagsType)))
+        _loadedLiquidData->liquidFlags = ReadSection<LoadedLiquidData::LiquidFlagsType>(data, size, position);
+        if (!_loadedLiquidData->liquidFlags)
             return false;
     }
-    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _loadedLiquidData->liquidMap = std::make_unique<LoadedLiquidData::LiquidMapType>();
-        _loadedLiquidData->liquidMap->resize(_loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight);
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidMap->data()), _loadedLiquidData->liquidMap->size() * sizeof(float)))
+        _loadedLiquidData->liquidMap = ReadSection<float>(data, size, position, _loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight);
+        if (!_loadedLiquidData->liquidMap)
             return false;
     }
     return true;
 }
 
-bool GridTerrainData::LoadHolesData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadHolesData(uint32 const offset, uint32 const size)
 {
-    fileStream.seekg(offset);
+    uint8 const* data = GetSectionData(offset, size);
+    if (!data)
+        return false;
 
+    uint32 position = 0;
     _loadedHoleData = std::make_unique<LoadedHoleData>();
-    if (!fileStream.read(reinterpret_cast<char*>(&_loadedHoleData->holes), sizeof(_loadedHoleData->holes)))
+    _loadedHoleData->holes = ReadSection<LoadedHoleData::HolesType>(data, size, position);
+    if (!_loadedHoleData->holes)
         return false;
 
     return true;
@@ -338,7 +482,7 @@ float GridTerrainData::getHeightFromUint8(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &_loadedHeightData->uint8HeightData->v9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &_loadedHeightData->uint8HeightData->v9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -386,7 +530,7 @@ float GridTerrainData::getHeightFromUint8(float x, float y) const
         }
     }
     // Calculate height
-    return (float)((a * x) + (b * y) + c) * _loadedHeightData->uint8HeightData->gridIntHeightMultiplier + _loadedHeightData->gridHeight;
+    return (float)((a * x) + (b * y) + c) * _loadedHeightData->gridIntHeightMultiplier + _loadedHeightData->gridHeight;
 }
 
 float GridTerrainData::getHeightFromUint16(float x, float y) const
@@ -408,7 +552,7 @@ float GridTerrainData::getHeightFromUint16(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &_loadedHeightData->uint16HeightData->v9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &_loadedHeightData->uint16HeightData->v9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -456,7 +600,7 @@ float GridTerrainData::getHeightFromUint16(float x, float y) const
         }
     }
     // Calculate height
-    return (float)((a * x) + (b * y) + c) * _loadedHeightData->uint16HeightData->gridIntHeightMultiplier + _loadedHeightData->gridHeight;
+    return (float)((a * x) + (b * y) + c) * _loadedHeightData->gridIntHeightMultiplier + _loadedHeightData->gridHeight;
 }
 
 bool GridTerrainData::isHole(int row, int col) const
@@ -469,7 +613,7 @@ bool GridTerrainData::isHole(int row, int col) const
     int holeRow = row % 8 / 2;
     int holeCol = (col - (cellCol * 8)) / 2;
 
-    uint16 hole = _loadedHoleData->holes[cellRow * 16 + cellCol];
+    uint16 hole = (*_loadedHoleData->holes)[cellRow * 16 + cellCol];
 
     return (hole & holetab_h[holeCol] & holetab_v[holeRow]) != 0;
 }
@@ -523,7 +667,7 @@ float GridTerrainData::getLiquidLevel(float x, float y) const
     if (cy_int < 0 || cy_int >= _loadedLiquidData->liquidWidth)
         return INVALID_HEIGHT;
 
-    return _loadedLiquidData->liquidMap->at(cx_int * _loadedLiquidData->liquidWidth + cy_int);
+    return _loadedLiquidData->liquidMap[cx_int * _loadedLiquidData->liquidWidth + cy_int];
 }
 
 // Get water state on map
@@ -586,7 +730,7 @@ LiquidData const GridTerrainData::GetLiquidData(float x, float y, float z, float
             if (lx_int >= 0 && lx_int < _loadedLiquidData->liquidHeight && ly_int >= 0 && ly_int < _loadedLiquidData->liquidWidth)
             {
                 // Get water level
-                float liquid_level = _loadedLiquidData->liquidMap ? _loadedLiquidData->liquidMap->at(lx_int * _loadedLiquidData->liquidWidth + ly_int) : _loadedLiquidData->liquidLevel;
+                float liquid_level = _loadedLiquidData->liquidMap ? _loadedLiquidData->liquidMap[lx_int * _loadedLiquidData->liquidWidth + ly_int] : _loadedLiquidData->liquidLevel;
                 // Get ground level
                 float ground_level = getHeight(x, y);
 
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <G3D/Plane.h>
 #include <memory>
+#include <vector>
 
 #define MAX_HEIGHT            100000.0f                     // can be use for find ground height at surface
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
@@ -51,6 +52,8 @@ union u_map_magic
 };
 
 const u_map_magic MapMagic        = { {'M', 'A', 'P', 'S'} };
+const u_map_magic MapAlignedMagic = { {'M', 'A', 'P', 'A'} };   // sections start at MapSectionAlignment, see map_converter
+const uint32 MapSectionAlignment  = 16;
 const uint32 MapVersionMagic      = 9;
 const u_map_magic MapAreaMagic    = { {'A', 'R', 'E', 'A'} };
 const u_map_magic MapHeightMagic  = { {'M', 'H', 'G', 'T'} };
@@ -113,12 +116,15 @@ struct map_liquidHeader
 // Loaded map data structures
 // ******************************************
 
+// The arrays point into the map file data owned by GridTerrainData,
+// so their layout must match the file sections exactly
+
 struct LoadedAreaData
 {
     typedef std::array<uint16, 16 * 16> AreaMapType;
 
     uint16 gridArea;
-    std::unique_ptr<AreaMapType> areaMap;
+    AreaMapType const* areaMap;
 };
 
 struct LoadedHeightData
@@ -132,7 +138,6 @@ struct LoadedHeightData
 
         V9Type v9;
         V8Type v8;
-        float gridIntHeightMultiplier;
     };
 
     struct Uint8HeightData
@@ -142,7 +147,6 @@ struct LoadedHeightData
 
         V9Type v9;
         V8Type v8;
-        float gridIntHeightMultiplier;
     };
 
     struct FloatHeightData
@@ -155,9 +159,10 @@ struct LoadedHeightData
     };
 
     float gridHeight;
-    std::unique_ptr<Uint16HeightData> uint16HeightData;
-    std::unique_ptr<Uint8HeightData> uint8HeightData;
-    std::unique_ptr<FloatHeightData> floatHeightData;
+    float gridIntHeightMultiplier;
+    Uint16HeightData const* uint16HeightData;
+    Uint8HeightData const* uint8HeightData;
+    FloatHeightData const* floatHeightData;
     std::unique_ptr<HeightPlanesType> minHeightPlanes;
 };
 
@@ -165,7 +170,6 @@ struct LoadedLiquidData
 {
     typedef std::array<uint16, 16 * 16> LiquidEntryType;
     typedef std::array<uint8, 16 * 16> LiquidFlagsType;
-    typedef std::vector<float> LiquidMapType;
 
     uint16 liquidGlobalEntry;
     uint8 liquidGlobalFlags;
@@ -174,16 +178,16 @@ struct LoadedLiquidData
     uint8 liquidWidth;
     uint8 liquidHeight;
     float liquidLevel;
-    std::unique_ptr<LiquidEntryType> liquidEntry;
-    std::unique_ptr<LiquidFlagsType> liquidFlags;
-    std::unique_ptr<LiquidMapType> liquidMap;
+    LiquidEntryType const* liquidEntry;
+    LiquidFlagsType const* liquidFlags;
+    float const* liquidMap;
 };
 
 struct LoadedHoleData
 {
     typedef std::array<uint16, 16 * 16> HolesType;
 
-    HolesType holes;
+    HolesType const* holes;
 };
 
 enum LiquidStatus : uint32
@@ -218,12 +222,30 @@ enum class TerrainMapDataReadResult
     InvalidHoleData
 };
 
+namespace boost::interprocess
+{
+    class mapped_region;
+}
+
 class GridTerrainData
 {
-    bool LoadAreaData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadHeightData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadLiquidData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadHolesData(std::ifstream& fileStream, uint32 const offset);
+    bool MapFile(std::string const& mapFileName);
+    bool ReadFileAligned(std::ifstream& fileStream, map_fileheader& header);
+    TerrainMapDataReadResult LoadSections(map_fileheader const& header);
+    uint8 const* GetSectionData(uint32 const offset, uint32 const size) const;
+
+    bool LoadAreaData(uint32 const offset, uint32 const size);
+    bool LoadHeightData(uint32 const offset, uint32 const size);
+    bool LoadLiquidData(uint32 const offset, uint32 const size);
+    bool LoadHolesData(uint32 const offset, uint32 const size);
+
+    // File contents in the MapAlignedMagic layout, either mapped read-only
+    // (shared with every other process using the same file through the page cache)
+    // or read from an old style map file into _fileBuffer
+    std::unique_ptr<boost::interprocess::mapped_region> _mappedFile;
+    std::vector<uint8> _fileBuffer;
+    uint8 const* _fileData;
+    std::size_t _fileSize;
 
     std::unique_ptr<LoadedAreaData> _loadedAreaData;
     std::unique_ptr<LoadedHeightData> _loadedHeightData;
@@ -242,7 +264,7 @@ class GridTerrainData
 
 public:
     GridTerrainData();
-    ~GridTerrainData() { };
+    ~GridTerrainData();
     TerrainMapDataReadResult Load(std::string const& mapFileName);
 
     uint16 getArea(float x, float y) const;
@@ -6,9 +6,9 @@
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
 
-void GridTerrainLoader::LoadTerrain()
+void GridTerrainLoader::LoadTerrain(std::shared_ptr<GridTerrainData> prefetchedTerrain)
 {
-    LoadMap();
+    LoadMap(std::move(prefetchedTerrain));
     if (_map->GetInstanceId() == 0)
     {
         LoadVMap();
@@ -16,7 +16,7 @@ void GridTerrainLoader::LoadTerrain()
     }
 }
 
-void GridTerrainLoader::LoadMap()
+void GridTerrainLoader::LoadMap(std::shared_ptr<GridTerrainData> prefetchedTerrain)
 {
     // Instances will point to the parent maps terrain data
     if (_map->GetInstanceId() != 0)
@@ -29,6 +29,13 @@ void GridTerrainLoader::LoadMap()
         return;
     }
 
+    if (prefetchedTerrain)
+    {
+        _grid.SetTerrainData(std::move(prefetchedTerrain));
+        sScriptMgr->OnLoadGridMap(_map, _grid.GetTerrainData(), _grid.GetX(), _grid.GetY());
+        return;
+    }
+
     // map file name
     std::string const mapFileName = Acore::StringFormat("{}maps/{:03}{:02}{:02}.map", sWorld->GetDataPath(), _map->GetId(), _grid.GetX(), _grid.GetY());
 
@@ -109,7 +116,7 @@ bool GridTerrainLoader::ExistMap(uint32 mapid, int gx, int gy)
         return false;
     }
 
-    if (header.mapMagic != MapMagic.asUInt || header.versionMagic != MapVersionMagic)
+    if ((header.mapMagic != MapMagic.asUInt && header.mapMagic != MapAlignedMagic.asUInt) || header.versionMagic != MapVersionMagic)
     {
         LOG_ERROR("maps", "Map file '{}' is from an incompatible map version ({:.4u} v{}), {:.4s} v{} is expected. Please pull your source, recompile tools and recreate maps using the updated mapextractor, then replace your old map files with new files.",
             mapFileName, 4, header.mapMagic, header.versionMagic, 4, MapMagic.asChar, MapVersionMagic);
@@ -154,4 +161,7 @@ void GridTerrainUnloader::UnloadTerrain()
 
     VMAP::VMapFactory::createOrGetVMapMgr()->unloadMap(_map->GetId(), _grid.GetX(), _grid.GetY());
     MMAP::MMapFactory::createOrGetMMapMgr()->unloadMap(_map->GetId(), _grid.GetX(), _grid.GetY());
+
+    // corridors computed this update may point into the unloaded tile
+    _map->GetPathQueryBatch().Clear();
 }
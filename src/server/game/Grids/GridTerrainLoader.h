@@ -19,6 +19,9 @@
 #define ACORE_GRID_TERRAIN_LOADER_H
 
 #include "GridDefines.h"
+#include <memory>
+
+class GridTerrainData;
 
 class GridTerrainLoader
 {
@@ -26,13 +29,14 @@ public:
     GridTerrainLoader(MapGridType& grid, Map* map)
         : _grid(grid), _map(map) { }
 
-    void LoadTerrain();
+    /// prefetchedTerrain is the .map data already read by sGridTerrainPrefetcher, if any
+    void LoadTerrain(std::shared_ptr<GridTerrainData> prefetchedTerrain = nullptr);
 
     static bool ExistMap(uint32 mapid, int gx, int gy);
     static bool ExistVMap(uint32 mapid, int gx, int gy);
 
 private:
-    void LoadMap();
+    void LoadMap(std::shared_ptr<GridTerrainData> prefetchedTerrain);
     void LoadVMap();
     void LoadMMap();
 
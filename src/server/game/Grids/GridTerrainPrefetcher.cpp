@@ -0,0 +1,159 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridTerrainPrefetcher.h"
+#include "Log.h"
+#include "Map.h"
+#include "StringFormat.h"
+#include "World.h"
+
+GridTerrainPrefetcher* GridTerrainPrefetcher::instance()
+{
+    static GridTerrainPrefetcher instance;
+    return &instance;
+}
+
+GridTerrainPrefetcher::~GridTerrainPrefetcher()
+{
+    Deactivate();
+}
+
+void GridTerrainPrefetcher::Activate(std::size_t numThreads)
+{
+    _workerThreads.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&GridTerrainPrefetcher::WorkerThread, this));
+}
+
+void GridTerrainPrefetcher::Deactivate()
+{
+    if (!IsActivated())
+        return;
+
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _workerThreads.clear();
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _requests.clear();
+    _loaded.clear();
+}
+
+void GridTerrainPrefetcher::Prefetch(uint32 mapId, uint16 x, uint16 y)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (!_requests.emplace(MakeKey(mapId, x, y), RequestState::Queued).second)
+            return;
+    }
+
+    _queue.Push(new Request{ mapId, x, y });
+}
+
+void GridTerrainPrefetcher::TakeLoaded(uint32 mapId, std::vector<LoadedTerrain>& loaded)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _loaded.find(mapId);
+    if (itr == _loaded.end())
+        return;
+
+    loaded = std::move(itr->second);
+    _loaded.erase(itr);
+}
+
+std::shared_ptr<GridTerrainData> GridTerrainPrefetcher::WaitFor(uint32 mapId, uint16 x, uint16 y)
+{
+    uint64 key = MakeKey(mapId, x, y);
+
+    std::unique_lock<std::mutex> lock(_lock);
+    auto requestItr = _requests.find(key);
+    if (requestItr != _requests.end())
+    {
+        // not started yet, loading it directly is faster than waiting for the queue
+        if (requestItr->second == RequestState::Queued)
+        {
+            _requests.erase(requestItr);
+            return nullptr;
+        }
+
+        _loadedCondition.wait(lock, [this, key]() { return !_requests.count(key); });
+    }
+
+    auto loadedItr = _loaded.find(mapId);
+    if (loadedItr == _loaded.end())
+        return nullptr;
+
+    std::vector<LoadedTerrain>& loaded = loadedItr->second;
+    for (auto itr = loaded.begin(); itr != loaded.end(); ++itr)
+    {
+        if (itr->X != x || itr->Y != y)
+            continue;
+
+        std::shared_ptr<GridTerrainData> terrain = std::move(itr->Terrain);
+        loaded.erase(itr);
+        return terrain;
+    }
+
+    return nullptr;
+}
+
+void GridTerrainPrefetcher::WorkerThread()
+{
+    for (;;)
+    {
+        Request* request = nullptr;
+        _queue.WaitAndPop(request);
+        if (!request)
+            return;
+
+        uint64 key = MakeKey(request->MapId, request->X, request->Y);
+
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            auto itr = _requests.find(key);
+            if (itr == _requests.end())
+            {
+                // dropped by WaitFor, the map loads it itself
+                delete request;
+                continue;
+            }
+
+            itr->second = RequestState::Loading;
+        }
+
+        std::string const mapFileName = Acore::StringFormat("{}maps/{:03}{:02}{:02}.map", sWorld->GetDataPath(), request->MapId, request->X, request->Y);
+        std::shared_ptr<GridTerrainData> terrain = std::make_shared<GridTerrainData>();
+
+        // failed loads are repeated by the map, which reports the error. They are handed over
+        // without terrain all the same, so the map forgets the request
+        if (terrain->Load(mapFileName) != TerrainMapDataReadResult::Success)
+            terrain = nullptr;
+
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _requests.erase(key);
+            _loaded[request->MapId].push_back({ request->X, request->Y, std::move(terrain) });
+        }
+
+        _loadedCondition.notify_all();
+        delete request;
+    }
+}
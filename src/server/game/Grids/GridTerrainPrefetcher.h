@@ -0,0 +1,92 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_GRID_TERRAIN_PREFETCHER_H
+#define ACORE_GRID_TERRAIN_PREFETCHER_H
+
+#include "Define.h"
+#include "PCQueue.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class GridTerrainData;
+
+/// Reads grid terrain (.map) files on background threads, ahead of the grid being created by its map.
+/// Maps collect the loaded terrain at the start of their update, MapGridManager::CreateGrid falls back to
+/// loading the file itself when nothing was prefetched.
+class GridTerrainPrefetcher
+{
+public:
+    struct LoadedTerrain
+    {
+        uint16 X;
+        uint16 Y;
+        std::shared_ptr<GridTerrainData> Terrain;   // nullptr if the file could not be loaded
+    };
+
+    static GridTerrainPrefetcher* instance();
+
+    void Activate(std::size_t numThreads);
+    void Deactivate();
+    bool IsActivated() const { return !_workerThreads.empty(); }
+
+    void Prefetch(uint32 mapId, uint16 x, uint16 y);
+
+    /// Moves the terrain loaded so far for the map into loaded
+    void TakeLoaded(uint32 mapId, std::vector<LoadedTerrain>& loaded);
+
+    /// Waits for a load which is already running, a request which has not been started yet is dropped.
+    /// Returns nullptr if the caller has to load the terrain itself.
+    std::shared_ptr<GridTerrainData> WaitFor(uint32 mapId, uint16 x, uint16 y);
+
+private:
+    GridTerrainPrefetcher() = default;
+    ~GridTerrainPrefetcher();
+
+    struct Request
+    {
+        uint32 MapId;
+        uint16 X;
+        uint16 Y;
+    };
+
+    enum class RequestState
+    {
+        Queued,
+        Loading
+    };
+
+    static uint64 MakeKey(uint32 mapId, uint16 x, uint16 y) { return (uint64(mapId) << 32) | (uint32(x) << 16) | y; }
+
+    void WorkerThread();
+
+    ProducerConsumerQueue<Request*> _queue;
+    std::vector<std::thread> _workerThreads;
+
+    std::mutex _lock;
+    std::condition_variable _loadedCondition;
+    std::unordered_map<uint64, RequestState> _requests;
+    std::unordered_map<uint32, std::vector<LoadedTerrain>> _loaded;
+};
+
+#define sGridTerrainPrefetcher GridTerrainPrefetcher::instance()
+
+#endif
@@ -1,6 +1,16 @@
 #include "MapGridManager.h"
+#include "GameTime.h"
 #include "GridObjectLoader.h"
 #include "GridTerrainLoader.h"
+#include "GridTerrainPrefetcher.h"
+#include "Map.h"
+#include "Metric.h"
+
+namespace
+{
+    // Prefetched terrain of grids the player turned away from is dropped again after this time
+    constexpr Milliseconds PREFETCHED_TERRAIN_EXPIRE_TIME = 5min;
+}
 
 void MapGridManager::CreateGrid(uint16 const x, uint16 const y)
 {
@@ -11,8 +21,31 @@ void MapGridManager::CreateGrid(uint16 const x, uint16 const y)
     std::unique_ptr<MapGridType> grid = std::make_unique<MapGridType>(x, y);
     grid->link(_map);
 
+    std::shared_ptr<GridTerrainData> prefetchedTerrain;
+    if (_map->GetInstanceId() == 0 && sGridTerrainPrefetcher->IsActivated())
+    {
+        uint32 const gridId = MakeGridId(x, y);
+        char const* result = "miss";
+
+        auto itr = _prefetchedTerrain.find(gridId);
+        if (itr != _prefetchedTerrain.end())
+        {
+            prefetchedTerrain = std::move(itr->second.Terrain);
+            _prefetchedTerrain.erase(itr);
+            result = "hit";
+        }
+        else if (_requestedTerrain.erase(gridId))
+        {
+            METRIC_TIMER("grid_terrain_prefetch_stall", METRIC_TAG("map_id", std::to_string(_map->GetId())));
+            prefetchedTerrain = sGridTerrainPrefetcher->WaitFor(_map->GetId(), x, y);
+            result = prefetchedTerrain ? "stall" : "miss";
+        }
+
+        METRIC_VALUE("grid_terrain_prefetch", 1, METRIC_TAG("map_id", std::to_string(_map->GetId())), METRIC_TAG("result", result));
+    }
+
     GridTerrainLoader loader(*grid, _map);
-    loader.LoadTerrain();
+    loader.LoadTerrain(std::move(prefetchedTerrain));
 
     _mapGrid[x][y] = std::move(grid);
 
@@ -61,6 +94,48 @@ void MapGridManager::UnloadGrid(uint16 const x, uint16 const y)
     _mapGrid[x][y] = nullptr;
 }
 
+void MapGridManager::PrefetchTerrain(uint16 const x, uint16 const y)
+{
+    if (!MapGridManager::IsValidGridCoordinates(x, y))
+        return;
+
+    std::lock_guard<std::mutex> guard(_gridLock);
+    if (IsGridCreated(x, y))
+        return;
+
+    uint32 const gridId = MakeGridId(x, y);
+    if (_prefetchedTerrain.count(gridId) || !_requestedTerrain.insert(gridId).second)
+        return;
+
+    sGridTerrainPrefetcher->Prefetch(_map->GetId(), x, y);
+}
+
+void MapGridManager::CollectPrefetchedTerrain()
+{
+    std::vector<GridTerrainPrefetcher::LoadedTerrain> loaded;
+    sGridTerrainPrefetcher->TakeLoaded(_map->GetId(), loaded);
+
+    std::lock_guard<std::mutex> guard(_gridLock);
+    Milliseconds const now = GameTime::GetGameTimeMS();
+
+    for (GridTerrainPrefetcher::LoadedTerrain& terrain : loaded)
+    {
+        uint32 const gridId = MakeGridId(terrain.X, terrain.Y);
+        if (!_requestedTerrain.erase(gridId) || !terrain.Terrain || IsGridCreated(terrain.X, terrain.Y))
+            continue;
+
+        _prefetchedTerrain[gridId] = { std::move(terrain.Terrain), now };
+    }
+
+    for (auto itr = _prefetchedTerrain.begin(); itr != _prefetchedTerrain.end();)
+    {
+        if (now - itr->second.LoadTime > PREFETCHED_TERRAIN_EXPIRE_TIME)
+            itr = _prefetchedTerrain.erase(itr);
+        else
+            ++itr;
+    }
+}
+
 bool MapGridManager::IsGridCreated(uint16 const x, uint16 const y) const
 {
     if (!MapGridManager::IsValidGridCoordinates(x, y))
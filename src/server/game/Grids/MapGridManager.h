@@ -19,12 +19,16 @@
 #define MAP_GRID_MANAGER_H
 
 #include "Common.h"
+#include "Duration.h"
 #include "GridDefines.h"
 #include "MapDefines.h"
 #include "MapGrid.h"
 
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
+class GridTerrainData;
 class Map;
 
 class MapGridManager
@@ -39,6 +43,10 @@ public:
     bool IsGridLoaded(uint16 const x, uint16 const y) const;
     MapGridType* GetGrid(uint16 const x, uint16 const y);
 
+    // Background terrain loading, see GridTerrainPrefetcher
+    void PrefetchTerrain(uint16 const x, uint16 const y);
+    void CollectPrefetchedTerrain();
+
     static bool IsValidGridCoordinates(uint16 const x, uint16 const y) { return (x < MAX_NUMBER_OF_GRIDS && y < MAX_NUMBER_OF_GRIDS); }
 
     uint32 GetCreatedGridsCount();
@@ -57,6 +65,17 @@ private:
 
     std::mutex _gridLock;
     std::unique_ptr<MapGridType> _mapGrid[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+
+    static uint32 MakeGridId(uint16 const x, uint16 const y) { return (uint32(x) << 16) | y; }
+
+    struct PrefetchedTerrain
+    {
+        std::shared_ptr<GridTerrainData> Terrain;
+        Milliseconds LoadTime;
+    };
+
+    std::unordered_map<uint32 /*gridId*/, PrefetchedTerrain> _prefetchedTerrain;
+    std::unordered_set<uint32 /*gridId*/> _requestedTerrain;
 };
 
 #endif
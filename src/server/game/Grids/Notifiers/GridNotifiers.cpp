@@ -199,7 +199,47 @@ void MessageDistDeliverer::Visit(VisiblePlayersMap const& m)
         if (skipped_receiver == target)
             continue;
 
-        target->SendDirectMessage(i_message);
+        target->GetSession()->SendSharedPacket(i_message, i_sharedMessage);
+    }
+}
+
+MovementDistDeliverer::MovementDistDeliverer(Unit const* src, WorldPacket const* msg, Player const* skipped, bool coalescable)
+    : i_source(src), i_sourcePlayer(src->GetCharmerOrOwnerPlayerOrPlayerItself()), i_message(msg), skipped_receiver(skipped), i_coalescable(coalescable), i_relayedBytes()
+{
+    float nearDist = sWorld->getFloatConfig(CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE);
+    float farDist = sWorld->getFloatConfig(CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE);
+    i_nearDistSq = nearDist * nearDist;
+    i_farDistSq = farDist * farDist;
+}
+
+MovementDistDeliverer::~MovementDistDeliverer()
+{
+    for (uint8 tier = 0; tier < MAX_MOVEMENT_INTEREST_TIERS; ++tier)
+        if (i_relayedBytes[tier])
+            WorldSession::AddMovementRelayBytes(MovementInterestTier(tier), i_relayedBytes[tier]);
+}
+
+void MovementDistDeliverer::Visit(VisiblePlayersMap const& m)
+{
+    for (auto const& kvPair : m)
+    {
+        Player const* target = kvPair.second;
+        if (skipped_receiver == target)
+            continue;
+
+        float distSq = target->m_seer->GetExactDist2dSq(i_source);
+        MovementInterestTier tier = distSq <= i_nearDistSq ? MOVEMENT_INTEREST_TIER_NEAR : (distSq <= i_farDistSq ? MOVEMENT_INTEREST_TIER_MID : MOVEMENT_INTEREST_TIER_FAR);
+
+        // group members always see each other move at full rate
+        if (!i_coalescable || tier == MOVEMENT_INTEREST_TIER_NEAR || (i_sourcePlayer && target->IsInSameRaidWith(i_sourcePlayer)))
+        {
+            i_relayedBytes[tier] += i_message->size();
+            target->GetSession()->SendSharedPacket(i_message, i_sharedMessage);
+            target->GetSession()->DiscardCoalescedMovement(i_source->GetGUID());
+            continue;
+        }
+
+        target->GetSession()->SendCoalescedMovement(i_message, i_source->GetGUID(), tier);
     }
 }
 
@@ -105,6 +105,7 @@ namespace Acore
         TeamId teamId;
         Player const* skipped_receiver;
         bool required3dDist;
+        std::shared_ptr<SharedWorldPacket> i_sharedMessage; // body shared by all receivers, created on first send
         MessageDistDeliverer(WorldObject const* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = nullptr, bool req3dDist = false)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , teamId((own_team_only && src->IsPlayer()) ? src->ToPlayer()->GetTeamId() : TEAM_NEUTRAL)
@@ -126,16 +127,34 @@ namespace Acore
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            player->GetSession()->SendSharedPacket(i_message, i_sharedMessage);
         }
     };
 
+    // Relays movement of a mover controlled by a client, see Network.MovementInterest.Enabled
+    struct MovementDistDeliverer
+    {
+        Unit const* i_source;
+        Player const* i_sourcePlayer;
+        WorldPacket const* i_message;
+        Player const* skipped_receiver;
+        bool i_coalescable;
+        float i_nearDistSq;
+        float i_farDistSq;
+        std::shared_ptr<SharedWorldPacket> i_sharedMessage;
+        std::array<uint64, MAX_MOVEMENT_INTEREST_TIERS> i_relayedBytes;
+        MovementDistDeliverer(Unit const* src, WorldPacket const* msg, Player const* skipped, bool coalescable);
+        ~MovementDistDeliverer();
+        void Visit(VisiblePlayersMap const& m);
+    };
+
     struct MessageDistDelivererToHostile
     {
         Unit* i_source;
         WorldPacket* i_message;
         uint32 i_phaseMask;
         float i_distSq;
+        std::shared_ptr<SharedWorldPacket> i_sharedMessage; // body shared by all receivers, created on first send
         MessageDistDelivererToHostile(Unit* src, WorldPacket* msg, float dist)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
         {
@@ -151,7 +170,7 @@ namespace Acore
             if (player == i_source || !player->HaveAtClient(i_source) || player->IsFriendlyTo(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            player->GetSession()->SendSharedPacket(i_message, i_sharedMessage);
         }
     };
 
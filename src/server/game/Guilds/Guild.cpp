@@ -33,6 +33,7 @@
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "SocialMgr.h"
+#include "WhoListCacheMgr.h"
 #include "World.h"
 #include "WorldSession.h"
 #include <boost/iterator/counting_iterator.hpp>
@@ -1049,7 +1050,7 @@ Guild::~Guild()
 bool Guild::Create(Player* pLeader, std::string_view name)
 {
     // Check if guild with such name already exists
-    if (sGuildMgr->GetGuildByName(name))
+    if (sGuildMgr->HasGuildWithName(name))
         return false;
 
     WorldSession* pLeaderSession = pLeader->GetSession();
@@ -1197,6 +1198,7 @@ bool Guild::SetName(std::string_view const& name)
     stmt->SetData(0, m_name);
     stmt->SetData(1, GetId());
     CharacterDatabase.Execute(stmt);
+    sWhoListCacheMgr->UpdateGuildName(GetId(), m_name);
     return true;
 }
 
@@ -1951,7 +1953,10 @@ bool Guild::LoadMemberFromDB(Field* fields)
         return false;
     }
 
-    sCharacterCache->UpdateCharacterGuildId(playerGuid, GetId());
+    // the guild directory filled the membership of lazily loaded guilds at startup already
+    if (!sGuildMgr->IsLazyLoadEnabled())
+        sCharacterCache->UpdateCharacterGuildId(playerGuid, GetId());
+
     return true;
 }
 
@@ -2936,3 +2941,23 @@ void Guild::ResetTimes()
 
     _BroadcastEvent(GE_BANK_TAB_AND_MONEY_UPDATED, ObjectGuid::Empty);
 }
+
+bool Guild::HasOnlineMembers() const
+{
+    for (auto const& [guid, member] : m_members)
+        if (member.FindPlayer())
+            return true;
+
+    return false;
+}
+
+uint32 Guild::GetBankItemCount() const
+{
+    uint32 count = 0;
+    for (BankTab const& tab : m_bankTabs)
+        for (uint8 slotId = 0; slotId < GUILD_BANK_MAX_SLOTS; ++slotId)
+            if (tab.GetItem(slotId))
+                ++count;
+
+    return count;
+}
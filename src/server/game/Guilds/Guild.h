@@ -778,6 +778,8 @@ public:
 
     [[nodiscard]] bool ModifyBankMoney(CharacterDatabaseTransaction trans, const uint64& amount, bool add) { return _ModifyBankMoney(trans, amount, add); }
     [[nodiscard]] uint32 GetMemberSize() const { return m_members.size(); }
+    [[nodiscard]] bool HasOnlineMembers() const;
+    [[nodiscard]] uint32 GetBankItemCount() const;
 
 protected:
     uint32 m_id;
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GuildDirectory.h"
+#include "Util.h"
+#include <algorithm>
+
+void GuildDirectory::Set(uint32 guildId, std::string_view name, ObjectGuid leaderGuid)
+{
+    Entry& entry = _entries[guildId];
+    entry.Name = name;
+    entry.LeaderGuid = leaderGuid;
+}
+
+std::string const* GuildDirectory::GetName(uint32 guildId) const
+{
+    auto itr = _entries.find(guildId);
+    return itr != _entries.end() ? &itr->second.Name : nullptr;
+}
+
+uint32 GuildDirectory::FindByName(std::string_view guildName, std::function<bool(uint32)> const& skip) const
+{
+    for (auto const& [guildId, entry] : _entries)
+        if (StringEqualI(entry.Name, guildName) && !skip(guildId))
+            return guildId;
+
+    return 0;
+}
+
+uint32 GuildDirectory::FindByLeader(ObjectGuid leaderGuid, std::function<bool(uint32)> const& skip) const
+{
+    for (auto const& [guildId, entry] : _entries)
+        if (entry.LeaderGuid == leaderGuid && !skip(guildId))
+            return guildId;
+
+    return 0;
+}
+
+void GuildDirectory::Touch(uint32 guildId, uint32 now) const
+{
+    auto itr = _entries.find(guildId);
+    if (itr != _entries.end())
+        itr->second.LastUsed.store(now, std::memory_order_relaxed);
+}
+
+std::vector<uint32> GuildDirectory::SelectIdleGuilds(std::vector<UnloadCandidate> const& candidates, uint32 now, uint32 idleTime, std::size_t maxCount) const
+{
+    // last use and id of the guilds that may go
+    std::vector<std::pair<uint32, uint32>> idleGuilds;
+    for (UnloadCandidate const& candidate : candidates)
+    {
+        if (candidate.HasOnlineMembers || candidate.LoadPending)
+            continue;
+
+        auto itr = _entries.find(candidate.GuildId);
+        if (itr == _entries.end())
+            continue;
+
+        uint32 lastUsed = itr->second.LastUsed.load(std::memory_order_relaxed);
+        if (lastUsed + idleTime <= now)
+            idleGuilds.emplace_back(lastUsed, candidate.GuildId);
+    }
+
+    std::size_t count = std::min(idleGuilds.size(), maxCount);
+    std::partial_sort(idleGuilds.begin(), idleGuilds.begin() + count, idleGuilds.end());
+
+    std::vector<uint32> guildIds;
+    guildIds.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        guildIds.push_back(idleGuilds[i].second);
+
+    return guildIds;
+}
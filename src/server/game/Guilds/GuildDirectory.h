@@ -0,0 +1,78 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GUILDDIRECTORY_H
+#define _GUILDDIRECTORY_H
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// idle guilds unloaded per sweep at most, the rest waits for the next one
+static constexpr std::size_t MAX_GUILD_UNLOADS_PER_SWEEP = 100;
+
+/**
+ * @brief Name, leader and last use of every guild, loaded or not, kept by GuildMgr when guilds are loaded lazily.
+ *
+ * Names and leaders of loaded guilds are only refreshed when they are unloaded, lookups have to skip those.
+ * Not thread safe, GuildMgr guards it with its store lock. Touch may run under a shared lock.
+ */
+class GuildDirectory
+{
+public:
+    struct UnloadCandidate
+    {
+        uint32 GuildId = 0;
+        bool HasOnlineMembers = false;
+        bool LoadPending = false;   // a background load is in flight, its result would be dropped
+    };
+
+    // Adds the guild or refreshes its name and leader, the last use is kept
+    void Set(uint32 guildId, std::string_view name, ObjectGuid leaderGuid);
+    void Remove(uint32 guildId) { _entries.erase(guildId); }
+
+    [[nodiscard]] bool Contains(uint32 guildId) const { return _entries.contains(guildId); }
+    [[nodiscard]] std::size_t GetSize() const { return _entries.size(); }
+    // nullptr if the guild is unknown
+    [[nodiscard]] std::string const* GetName(uint32 guildId) const;
+
+    // Id of the guild with that name (case insensitive) or leader, 0 if there is none. Guilds skip returns true for are ignored
+    [[nodiscard]] uint32 FindByName(std::string_view guildName, std::function<bool(uint32)> const& skip) const;
+    [[nodiscard]] uint32 FindByLeader(ObjectGuid leaderGuid, std::function<bool(uint32)> const& skip) const;
+
+    void Touch(uint32 guildId, uint32 now) const;
+
+    // At most maxCount candidates not used for idleTime, without online members or a pending load, least recently used first
+    [[nodiscard]] std::vector<uint32> SelectIdleGuilds(std::vector<UnloadCandidate> const& candidates, uint32 now, uint32 idleTime, std::size_t maxCount) const;
+
+private:
+    struct Entry
+    {
+        std::string Name;
+        ObjectGuid LeaderGuid;
+        mutable std::atomic<uint32> LastUsed{0};  // game time of the last lookup
+    };
+
+    std::unordered_map<uint32, Entry> _entries;
+};
+
+#endif
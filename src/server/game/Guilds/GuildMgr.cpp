@@ -16,10 +16,16 @@
  */
 
 #include "GuildMgr.h"
+#include "CharacterCache.h"
 #include "Common.h"
+#include "GameTime.h"
+#include "StringFormat.h"
+#include "WhoListCacheMgr.h"
 
 GuildMgr::GuildMgr() : NextGuildId(1)
-{ }
+{
+    _sweepTimer.SetInterval(MINUTE * IN_MILLISECONDS);
+}
 
 GuildMgr::~GuildMgr()
 {
@@ -35,12 +41,29 @@ GuildMgr* GuildMgr::instance()
 
 void GuildMgr::AddGuild(Guild* guild)
 {
+    StoreGuild(guild);
+
+    // members of a new guild joined before it was added here, /who could not know its name yet
+    sWhoListCacheMgr->UpdateGuildName(guild->GetId(), guild->GetName());
+}
+
+void GuildMgr::StoreGuild(Guild* guild) const
+{
+    std::unique_lock<std::shared_mutex> lock(_storeLock);
     GuildStore[guild->GetId()] = guild;
+
+    if (_lazyLoad)
+    {
+        _directory.Set(guild->GetId(), guild->GetName(), guild->GetLeaderGUID());
+        _directory.Touch(guild->GetId(), GameTime::GetGameTime().count());
+    }
 }
 
 void GuildMgr::RemoveGuild(uint32 guildId)
 {
+    std::unique_lock<std::shared_mutex> lock(_storeLock);
     GuildStore.erase(guildId);
+    _directory.Remove(guildId);
 }
 
 uint32 GuildMgr::GenerateGuildId()
@@ -56,48 +79,142 @@ uint32 GuildMgr::GenerateGuildId()
 // Guild collection
 Guild* GuildMgr::GetGuildById(uint32 guildId) const
 {
-    GuildContainer::const_iterator itr = GuildStore.find(guildId);
-    if (itr != GuildStore.end())
-        return itr->second;
+    {
+        std::shared_lock<std::shared_mutex> lock(_storeLock);
+        GuildContainer::const_iterator itr = GuildStore.find(guildId);
+        if (itr != GuildStore.end())
+        {
+            if (_lazyLoad)
+                _directory.Touch(guildId, GameTime::GetGameTime().count());
 
-    return nullptr;
+            return itr->second;
+        }
+
+        if (!_lazyLoad || !_directory.Contains(guildId))
+            return nullptr;
+    }
+
+    return GetUnloadedGuild(guildId);
 }
 
 Guild* GuildMgr::GetGuildByName(std::string_view guildName) const
 {
-    for (auto const& [id, guild] : GuildStore)
-        if (StringEqualI(guild->GetName(), guildName))
-            return guild;
+    uint32 guildId = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(_storeLock);
+        for (auto const& [id, guild] : GuildStore)
+            if (StringEqualI(guild->GetName(), guildName))
+                return guild;
 
-    return nullptr;
+        guildId = FindUnloadedGuildByName(guildName);
+    }
+
+    return guildId ? GetGuildById(guildId) : nullptr;
 }
 
 std::string GuildMgr::GetGuildNameById(uint32 guildId) const
 {
-    if (Guild* guild = GetGuildById(guildId))
-        return guild->GetName();
+    std::shared_lock<std::shared_mutex> lock(_storeLock);
+    GuildContainer::const_iterator itr = GuildStore.find(guildId);
+    if (itr != GuildStore.end())
+        return itr->second->GetName();
+
+    // no need to load the guild just for its name
+    if (std::string const* name = _directory.GetName(guildId))
+        return *name;
 
     return "";
 }
 
 Guild* GuildMgr::GetGuildByLeader(ObjectGuid guid) const
 {
+    uint32 guildId = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(_storeLock);
+        for (GuildContainer::const_iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
+            if (itr->second->GetLeaderGUID() == guid)
+                return itr->second;
+
+        guildId = FindUnloadedGuildByLeader(guid);
+    }
+
+    return guildId ? GetGuildById(guildId) : nullptr;
+}
+
+bool GuildMgr::HasGuildWithName(std::string_view guildName) const
+{
+    std::shared_lock<std::shared_mutex> lock(_storeLock);
+    for (auto const& [id, guild] : GuildStore)
+        if (StringEqualI(guild->GetName(), guildName))
+            return true;
+
+    return FindUnloadedGuildByName(guildName) != 0;
+}
+
+bool GuildMgr::IsGuildLeader(ObjectGuid guid) const
+{
+    std::shared_lock<std::shared_mutex> lock(_storeLock);
     for (GuildContainer::const_iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
         if (itr->second->GetLeaderGUID() == guid)
-            return itr->second;
+            return true;
 
-    return nullptr;
+    return FindUnloadedGuildByLeader(guid) != 0;
+}
+
+uint32 GuildMgr::FindUnloadedGuildByName(std::string_view guildName) const
+{
+    return _directory.FindByName(guildName, [this](uint32 guildId) { return GuildStore.contains(guildId); });
+}
+
+uint32 GuildMgr::FindUnloadedGuildByLeader(ObjectGuid guid) const
+{
+    return _directory.FindByLeader(guid, [this](uint32 guildId) { return GuildStore.contains(guildId); });
+}
+
+void GuildMgr::DeleteOrphanedGuildData()
+{
+    CharacterDatabase.DirectExecute("DELETE g FROM guild g LEFT JOIN guild_member gm ON g.guildid = gm.guildid WHERE gm.guildid IS NULL");
+
+    // Delete orphaned guild rank entries before loading the valid ones
+    CharacterDatabase.DirectExecute("DELETE gr FROM guild_rank gr LEFT JOIN guild g ON gr.guildId = g.guildId WHERE g.guildId IS NULL");
+
+    // Delete orphaned guild member entries before loading the valid ones
+    CharacterDatabase.DirectExecute("DELETE gm FROM guild_member gm LEFT JOIN guild g ON gm.guildId = g.guildId WHERE g.guildId IS NULL");
+    CharacterDatabase.DirectExecute("DELETE gm FROM guild_member_withdraw gm LEFT JOIN guild_member g ON gm.guid = g.guid WHERE g.guid IS NULL");
+
+    // Delete orphaned guild bank right entries before loading the valid ones
+    CharacterDatabase.DirectExecute("DELETE gbr FROM guild_bank_right gbr LEFT JOIN guild g ON gbr.guildId = g.guildId WHERE g.guildId IS NULL");
+
+    CharacterDatabase.DirectExecute("DELETE FROM guild_eventlog WHERE LogGuid > {}", sWorld->getIntConfig(CONFIG_GUILD_EVENT_LOG_COUNT));
+
+    // Remove log entries that exceed the number of allowed entries per guild
+    CharacterDatabase.DirectExecute("DELETE FROM guild_bank_eventlog WHERE LogGuid > {}", sWorld->getIntConfig(CONFIG_GUILD_BANK_EVENT_LOG_COUNT));
+
+    // Delete orphaned guild bank tab entries before loading the valid ones
+    CharacterDatabase.DirectExecute("DELETE gbt FROM guild_bank_tab gbt LEFT JOIN guild g ON gbt.guildId = g.guildId WHERE g.guildId IS NULL");
+
+    // Delete orphan guild bank items
+    CharacterDatabase.DirectExecute("DELETE gbi FROM guild_bank_item gbi LEFT JOIN guild g ON gbi.guildId = g.guildId WHERE g.guildId IS NULL");
 }
 
 void GuildMgr::LoadGuilds()
 {
+    _lazyLoad = sWorld->getBoolConfig(CONFIG_GUILD_LAZY_LOAD);
+    _worldThreadId = std::this_thread::get_id();
+
+    DeleteOrphanedGuildData();
+
+    if (_lazyLoad)
+    {
+        LoadGuildDirectory();
+        return;
+    }
+
     // 1. Load all guilds
     LOG_INFO("server.loading", "Loading Guilds Definitions...");
     {
         uint32 oldMSTime = getMSTime();
 
-        CharacterDatabase.DirectExecute("DELETE g FROM guild g LEFT JOIN guild_member gm ON g.guildid = gm.guildid WHERE gm.guildid IS NULL");
-
         //          0          1       2             3              4              5              6
         QueryResult result = CharacterDatabase.Query("SELECT g.guildid, g.name, g.leaderguid, g.EmblemStyle, g.EmblemColor, g.BorderStyle, g.BorderColor, "
                              //   7                  8       9       10            11           12
@@ -138,9 +255,6 @@ void GuildMgr::LoadGuilds()
     {
         uint32 oldMSTime = getMSTime();
 
-        // Delete orphaned guild rank entries before loading the valid ones
-        CharacterDatabase.DirectExecute("DELETE gr FROM guild_rank gr LEFT JOIN guild g ON gr.guildId = g.guildId WHERE g.guildId IS NULL");
-
         //                                                         0    1      2       3                4
         QueryResult result = CharacterDatabase.Query("SELECT guildid, rid, rname, rights, BankMoneyPerDay FROM guild_rank ORDER BY guildid ASC, rid ASC");
 
@@ -173,10 +287,6 @@ void GuildMgr::LoadGuilds()
     {
         uint32 oldMSTime = getMSTime();
 
-        // Delete orphaned guild member entries before loading the valid ones
-        CharacterDatabase.DirectExecute("DELETE gm FROM guild_member gm LEFT JOIN guild g ON gm.guildId = g.guildId WHERE g.guildId IS NULL");
-        CharacterDatabase.DirectExecute("DELETE gm FROM guild_member_withdraw gm LEFT JOIN guild_member g ON gm.guid = g.guid WHERE g.guid IS NULL");
-
         //           0        1         2     3      4        5       6       7       8       9       10
         QueryResult result = CharacterDatabase.Query("SELECT guildid, gm.guid, `rank`, pnote, offnote, w.tab0, w.tab1, w.tab2, w.tab3, w.tab4, w.tab5, "
                           // 11        12      13       14       15        16      17         18
@@ -215,9 +325,6 @@ void GuildMgr::LoadGuilds()
     {
         uint32 oldMSTime = getMSTime();
 
-        // Delete orphaned guild bank right entries before loading the valid ones
-        CharacterDatabase.DirectExecute("DELETE gbr FROM guild_bank_right gbr LEFT JOIN guild g ON gbr.guildId = g.guildId WHERE g.guildId IS NULL");
-
         //      0        1      2    3        4
         QueryResult result = CharacterDatabase.Query("SELECT guildid, TabId, rid, gbright, SlotPerDay FROM guild_bank_right ORDER BY guildid ASC, TabId ASC");
 
@@ -250,8 +357,6 @@ void GuildMgr::LoadGuilds()
     {
         uint32 oldMSTime = getMSTime();
 
-        CharacterDatabase.DirectExecute("DELETE FROM guild_eventlog WHERE LogGuid > {}", sWorld->getIntConfig(CONFIG_GUILD_EVENT_LOG_COUNT));
-
         //          0        1        2          3            4            5        6
         QueryResult result = CharacterDatabase.Query("SELECT guildid, LogGuid, EventType, PlayerGuid1, PlayerGuid2, NewRank, TimeStamp FROM guild_eventlog ORDER BY TimeStamp DESC, LogGuid DESC");
 
@@ -284,9 +389,6 @@ void GuildMgr::LoadGuilds()
     {
         uint32 oldMSTime = getMSTime();
 
-        // Remove log entries that exceed the number of allowed entries per guild
-        CharacterDatabase.DirectExecute("DELETE FROM guild_bank_eventlog WHERE LogGuid > {}", sWorld->getIntConfig(CONFIG_GUILD_BANK_EVENT_LOG_COUNT));
-
         //          0        1      2        3          4           5            6               7          8
         QueryResult result = CharacterDatabase.Query("SELECT guildid, TabId, LogGuid, EventType, PlayerGuid, ItemOrMoney, ItemStackCount, DestTabId, TimeStamp FROM guild_bank_eventlog ORDER BY TimeStamp DESC, LogGuid DESC");
 
@@ -319,9 +421,6 @@ void GuildMgr::LoadGuilds()
     {
         uint32 oldMSTime = getMSTime();
 
-        // Delete orphaned guild bank tab entries before loading the valid ones
-        CharacterDatabase.DirectExecute("DELETE gbt FROM guild_bank_tab gbt LEFT JOIN guild g ON gbt.guildId = g.guildId WHERE g.guildId IS NULL");
-
         //         0        1      2        3        4
         QueryResult result = CharacterDatabase.Query("SELECT guildid, TabId, TabName, TabIcon, TabText FROM guild_bank_tab ORDER BY guildid ASC, TabId ASC");
 
@@ -354,9 +453,6 @@ void GuildMgr::LoadGuilds()
     {
         uint32 oldMSTime = getMSTime();
 
-        // Delete orphan guild bank items
-        CharacterDatabase.DirectExecute("DELETE gbi FROM guild_bank_item gbi LEFT JOIN guild g ON gbi.guildId = g.guildId WHERE g.guildId IS NULL");
-
         //          0            1                2      3         4        5      6             7                 8           9           10
         QueryResult result = CharacterDatabase.Query("SELECT creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, playedTime, text, "
                              //   11       12     13      14         15
@@ -404,8 +500,300 @@ void GuildMgr::LoadGuilds()
     }
 }
 
+// same columns as the queries of LoadGuilds, limited to one guild
+std::string GuildMgr::GetGuildLoadQuery(GuildLoadQuery query, uint32 guildId)
+{
+    switch (query)
+    {
+        case GUILD_LOAD_QUERY_GUILD:
+            return Acore::StringFormat("SELECT g.guildid, g.name, g.leaderguid, g.EmblemStyle, g.EmblemColor, g.BorderStyle, g.BorderColor, "
+                "g.BackgroundColor, g.info, g.motd, g.createdate, g.BankMoney, COUNT(gbt.guildid) "
+                "FROM guild g LEFT JOIN guild_bank_tab gbt ON g.guildid = gbt.guildid WHERE g.guildid = {} GROUP BY g.guildid", guildId);
+        case GUILD_LOAD_QUERY_RANKS:
+            return Acore::StringFormat("SELECT guildid, rid, rname, rights, BankMoneyPerDay FROM guild_rank WHERE guildid = {} ORDER BY rid ASC", guildId);
+        case GUILD_LOAD_QUERY_MEMBERS:
+            return Acore::StringFormat("SELECT guildid, gm.guid, `rank`, pnote, offnote, w.tab0, w.tab1, w.tab2, w.tab3, w.tab4, w.tab5, "
+                "w.money, c.name, c.level, c.class, c.gender, c.zone, c.account, c.logout_time "
+                "FROM guild_member gm "
+                "LEFT JOIN guild_member_withdraw w ON gm.guid = w.guid "
+                "LEFT JOIN characters c ON c.guid = gm.guid WHERE guildid = {}", guildId);
+        case GUILD_LOAD_QUERY_BANK_RIGHTS:
+            return Acore::StringFormat("SELECT guildid, TabId, rid, gbright, SlotPerDay FROM guild_bank_right WHERE guildid = {} ORDER BY TabId ASC", guildId);
+        case GUILD_LOAD_QUERY_EVENTLOG:
+            return Acore::StringFormat("SELECT guildid, LogGuid, EventType, PlayerGuid1, PlayerGuid2, NewRank, TimeStamp FROM guild_eventlog "
+                "WHERE guildid = {} ORDER BY TimeStamp DESC, LogGuid DESC", guildId);
+        case GUILD_LOAD_QUERY_BANK_EVENTLOG:
+            return Acore::StringFormat("SELECT guildid, TabId, LogGuid, EventType, PlayerGuid, ItemOrMoney, ItemStackCount, DestTabId, TimeStamp FROM guild_bank_eventlog "
+                "WHERE guildid = {} ORDER BY TimeStamp DESC, LogGuid DESC", guildId);
+        case GUILD_LOAD_QUERY_BANK_TABS:
+            return Acore::StringFormat("SELECT guildid, TabId, TabName, TabIcon, TabText FROM guild_bank_tab WHERE guildid = {} ORDER BY TabId ASC", guildId);
+        case GUILD_LOAD_QUERY_BANK_ITEMS:
+            return Acore::StringFormat("SELECT creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, playedTime, text, "
+                "guildid, TabId, SlotId, item_guid, itemEntry FROM guild_bank_item gbi INNER JOIN item_instance ii ON gbi.item_guid = ii.guid WHERE guildid = {}", guildId);
+        default:
+            ABORT();
+    }
+}
+
+void GuildMgr::LoadGuildDirectory()
+{
+    LOG_INFO("server.loading", "Loading Guild Directory...");
+    uint32 oldMSTime = getMSTime();
+
+    //                                                      0       1        2
+    QueryResult result = CharacterDatabase.Query("SELECT guildid, name, leaderguid FROM guild");
+    if (!result)
+    {
+        LOG_WARN("server.loading", ">> Loaded 0 guild directory entries. DB table `guild` is empty.");
+        LOG_INFO("server.loading", " ");
+        return;
+    }
+
+    do
+    {
+        Field* fields = result->Fetch();
+        _directory.Set(fields[0].Get<uint32>(), fields[1].Get<std::string>(), ObjectGuid::Create<HighGuid::Player>(fields[2].Get<uint32>()));
+    } while (result->NextRow());
+
+    // the character cache learns the guild of a character from the member loading, which skips it for lazily loaded guilds
+    if (QueryResult members = CharacterDatabase.Query("SELECT guildid, guid FROM guild_member"))
+    {
+        do
+        {
+            Field* fields = members->Fetch();
+            sCharacterCache->UpdateCharacterGuildId(ObjectGuid::Create<HighGuid::Player>(fields[1].Get<uint32>()), fields[0].Get<uint32>());
+        } while (members->NextRow());
+    }
+
+    LOG_INFO("server.loading", ">> Loaded {} guild directory entries in {} ms", _directory.GetSize(), GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
+Guild* GuildMgr::GetUnloadedGuild(uint32 guildId) const
+{
+    // blocking queries, the character cache and disbanding broken guilds are world thread business
+    if (std::this_thread::get_id() == _worldThreadId)
+        return LoadGuild(guildId);
+
+    std::lock_guard<std::mutex> guard(_requestLock);
+    _requestedLoads.insert(guildId);
+    return nullptr;
+}
+
+Guild* GuildMgr::LoadGuild(uint32 guildId) const
+{
+    // scripts called while disbanding a broken guild must not start loading it again
+    if (_loadingGuilds.contains(guildId))
+        return nullptr;
+
+    GuildLoadResults results;
+    for (uint8 i = 0; i < MAX_GUILD_LOAD_QUERIES; ++i)
+        results[i] = CharacterDatabase.Query(GetGuildLoadQuery(GuildLoadQuery(i), guildId));
+
+    return CreateGuildFromDB(guildId, results);
+}
+
+Guild* GuildMgr::CreateGuildFromDB(uint32 guildId, GuildLoadResults const& results) const
+{
+    // scripts called while disbanding a broken guild must not start loading it again
+    if (!_loadingGuilds.insert(guildId).second)
+        return nullptr;
+
+    Guild* guild = nullptr;
+    if (QueryResult const& result = results[GUILD_LOAD_QUERY_GUILD])
+    {
+        guild = new Guild();
+        if (!guild->LoadFromDB(result->Fetch()))
+        {
+            delete guild;
+            guild = nullptr;
+        }
+    }
+
+    if (guild)
+    {
+        auto loadRows = [guild, &results](GuildLoadQuery query, auto loader)
+        {
+            if (QueryResult const& result = results[query])
+            {
+                do
+                {
+                    (guild->*loader)(result->Fetch());
+                } while (result->NextRow());
+            }
+        };
+
+        loadRows(GUILD_LOAD_QUERY_RANKS, &Guild::LoadRankFromDB);
+        loadRows(GUILD_LOAD_QUERY_MEMBERS, &Guild::LoadMemberFromDB);
+        loadRows(GUILD_LOAD_QUERY_BANK_RIGHTS, &Guild::LoadBankRightFromDB);
+        loadRows(GUILD_LOAD_QUERY_EVENTLOG, &Guild::LoadEventLogFromDB);
+        loadRows(GUILD_LOAD_QUERY_BANK_EVENTLOG, &Guild::LoadBankEventLogFromDB);
+        loadRows(GUILD_LOAD_QUERY_BANK_TABS, &Guild::LoadBankTabFromDB);
+        loadRows(GUILD_LOAD_QUERY_BANK_ITEMS, &Guild::LoadBankItemFromDB);
+
+        // a guild that fails validation disbands itself, which also removes it from the directory
+        if (guild->Validate())
+        {
+            StoreGuild(guild);
+            ++_loadCount;
+        }
+        else
+        {
+            delete guild;
+            guild = nullptr;
+        }
+    }
+    else
+    {
+        // skipped by the full loading as well, do not try again on every lookup
+        LOG_ERROR("guild", "Guild {} is listed in the guild directory but could not be loaded.", guildId);
+        std::unique_lock<std::shared_mutex> lock(_storeLock);
+        _directory.Remove(guildId);
+    }
+
+    _loadingGuilds.erase(guildId);
+    return guild;
+}
+
+void GuildMgr::PrefetchGuild(uint32 guildId)
+{
+    if (!_lazyLoad || _pendingLoads.contains(guildId))
+        return;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_storeLock);
+        if (GuildStore.contains(guildId) || !_directory.Contains(guildId))
+            return;
+    }
+
+    _pendingLoads.insert(guildId);
+
+    struct PendingGuildLoad
+    {
+        GuildLoadResults Results;
+        uint8 Received = 0;
+    };
+
+    // the queries are independent, let them run on as many connections as there are
+    std::shared_ptr<PendingGuildLoad> load = std::make_shared<PendingGuildLoad>();
+    for (uint8 i = 0; i < MAX_GUILD_LOAD_QUERIES; ++i)
+    {
+        _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(GetGuildLoadQuery(GuildLoadQuery(i), guildId))
+            .WithCallback([this, guildId, load, i](QueryResult result)
+        {
+            load->Results[i] = std::move(result);
+            if (++load->Received < MAX_GUILD_LOAD_QUERIES)
+                return;
+
+            _pendingLoads.erase(guildId);
+
+            {
+                // loaded meanwhile by a lookup that could not wait, or disbanded
+                std::shared_lock<std::shared_mutex> lock(_storeLock);
+                if (GuildStore.contains(guildId) || !_directory.Contains(guildId))
+                    return;
+            }
+
+            CreateGuildFromDB(guildId, load->Results);
+        }));
+    }
+}
+
+void GuildMgr::Update(uint32 diff)
+{
+    std::unordered_set<uint32> requestedLoads;
+    {
+        std::lock_guard<std::mutex> guard(_requestLock);
+        requestedLoads.swap(_requestedLoads);
+    }
+
+    for (uint32 guildId : requestedLoads)
+        PrefetchGuild(guildId);
+
+    _queryProcessor.ProcessReadyCallbacks();
+
+    _sweepTimer.Update(diff);
+    if (!_sweepTimer.Passed())
+        return;
+
+    _sweepTimer.Reset();
+
+    if (_lazyLoad)
+        UnloadIdleGuilds();
+
+    UpdateStats();
+}
+
+void GuildMgr::UnloadIdleGuilds()
+{
+    uint32 idleTime = sWorld->getIntConfig(CONFIG_GUILD_IDLE_UNLOAD_TIME);
+    if (!idleTime)
+        return;
+
+    std::vector<uint32> idleGuilds;
+    {
+        std::shared_lock<std::shared_mutex> lock(_storeLock);
+
+        std::vector<GuildDirectory::UnloadCandidate> candidates;
+        candidates.reserve(GuildStore.size());
+        for (auto const& [guildId, guild] : GuildStore)
+            candidates.push_back({ guildId, guild->HasOnlineMembers(), _pendingLoads.contains(guildId) });
+
+        idleGuilds = _directory.SelectIdleGuilds(candidates, GameTime::GetGameTime().count(), idleTime, MAX_GUILD_UNLOADS_PER_SWEEP);
+    }
+
+    if (idleGuilds.empty())
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(_storeLock);
+    for (uint32 guildId : idleGuilds)
+    {
+        GuildContainer::iterator itr = GuildStore.find(guildId);
+        if (itr == GuildStore.end())
+            continue;
+
+        // everything else is written to the database as it changes
+        Guild* guild = itr->second;
+        _directory.Set(guildId, guild->GetName(), guild->GetLeaderGUID());
+
+        GuildStore.erase(itr);
+        delete guild;
+        ++_unloadCount;
+    }
+
+    LOG_DEBUG("guild", "Unloaded {} idle guilds, {} guilds are still loaded.", idleGuilds.size(), GuildStore.size());
+}
+
+void GuildMgr::UpdateStats()
+{
+    Stats stats;
+    {
+        std::shared_lock<std::shared_mutex> lock(_storeLock);
+        stats.Guilds = _lazyLoad ? _directory.GetSize() : GuildStore.size();
+        stats.LoadedGuilds = GuildStore.size();
+        for (auto const& [guildId, guild] : GuildStore)
+        {
+            stats.LoadedMembers += guild->GetMemberCount();
+            stats.LoadedBankItems += guild->GetBankItemCount();
+        }
+    }
+
+    stats.Loads = _loadCount;
+    stats.Unloads = _unloadCount;
+
+    std::lock_guard<std::mutex> guard(_statsLock);
+    _stats = stats;
+}
+
+GuildMgr::Stats GuildMgr::GetStats() const
+{
+    std::lock_guard<std::mutex> guard(_statsLock);
+    return _stats;
+}
+
 void GuildMgr::ResetTimes()
 {
+    // unloaded guilds read the cleared withdraw table when they are loaded again
     for (GuildContainer::const_iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
         if (Guild* guild = itr->second)
             guild->ResetTimes();
@@ -18,8 +18,30 @@
 #ifndef _GUILDMGR_H
 #define _GUILDMGR_H
 
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
 #include "Guild.h"
+#include "GuildDirectory.h"
+#include "QueryCallback.h"
+#include "Timer.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_set>
 
+/**
+ * With Guild.LazyLoad enabled only a directory of guild ids, names and leaders is loaded at startup.
+ * A guild is loaded in the background when one of its members logs in. Any other lookup of a guild
+ * that is not loaded yet loads it right away on the world thread, lookups from other threads get
+ * nullptr and only queue a background load. Name and leader existence checks never load a guild.
+ * Loaded guilds without online members are unloaded again once they have not been used for
+ * Guild.IdleUnloadTime.
+ *
+ * Lookups may come from map threads, the stores are guarded by a shared mutex. Loading, background
+ * loads and unloading only happen on the world thread.
+ */
 class GuildMgr
 {
 private:
@@ -27,6 +49,16 @@ private:
     ~GuildMgr();
 
 public:
+    struct Stats
+    {
+        uint32 Guilds = 0;          // all guilds, loaded or not
+        uint32 LoadedGuilds = 0;
+        uint32 LoadedMembers = 0;
+        uint32 LoadedBankItems = 0;
+        uint32 Loads = 0;           // guilds loaded on demand since startup
+        uint32 Unloads = 0;         // idle guilds unloaded since startup
+    };
+
     static GuildMgr* instance();
 
     Guild* GetGuildByLeader(ObjectGuid guid) const;
@@ -34,10 +66,23 @@ public:
     Guild* GetGuildByName(std::string_view guildName) const;
     std::string GetGuildNameById(uint32 guildId) const;
 
+    // Existence checks, answered from the guild directory without loading the guild
+    [[nodiscard]] bool HasGuildWithName(std::string_view guildName) const;
+    [[nodiscard]] bool IsGuildLeader(ObjectGuid guid) const;
+
+    [[nodiscard]] bool IsLazyLoadEnabled() const { return _lazyLoad; }
+
     void LoadGuilds();
     void AddGuild(Guild* guild);
     void RemoveGuild(uint32 guildId);
 
+    // Starts loading the guild in the background, does nothing if it is loaded already or lazy loading is disabled
+    void PrefetchGuild(uint32 guildId);
+    // Handles finished background loads, unloads idle guilds and refreshes the stats, called every world update
+    void Update(uint32 diff);
+
+    [[nodiscard]] Stats GetStats() const;
+
     uint32 GenerateGuildId();
     void SetNextGuildId(uint32 Id) { NextGuildId = Id; }
 
@@ -45,7 +90,58 @@ public:
 protected:
     typedef std::unordered_map<uint32, Guild*> GuildContainer;
     uint32 NextGuildId;
-    GuildContainer GuildStore;
+    mutable GuildContainer GuildStore;  // lookups add lazily loaded guilds
+
+private:
+    enum GuildLoadQuery : uint8
+    {
+        GUILD_LOAD_QUERY_GUILD,
+        GUILD_LOAD_QUERY_RANKS,
+        GUILD_LOAD_QUERY_MEMBERS,
+        GUILD_LOAD_QUERY_BANK_RIGHTS,
+        GUILD_LOAD_QUERY_EVENTLOG,
+        GUILD_LOAD_QUERY_BANK_EVENTLOG,
+        GUILD_LOAD_QUERY_BANK_TABS,
+        GUILD_LOAD_QUERY_BANK_ITEMS,
+
+        MAX_GUILD_LOAD_QUERIES
+    };
+
+    typedef std::array<QueryResult, MAX_GUILD_LOAD_QUERIES> GuildLoadResults;
+
+    static std::string GetGuildLoadQuery(GuildLoadQuery query, uint32 guildId);
+
+    void DeleteOrphanedGuildData();
+    void LoadGuildDirectory();
+
+    // Loads a guild of the directory on the world thread, other threads only queue a background load
+    Guild* GetUnloadedGuild(uint32 guildId) const;
+    Guild* LoadGuild(uint32 guildId) const;
+    Guild* CreateGuildFromDB(uint32 guildId, GuildLoadResults const& results) const;
+    void StoreGuild(Guild* guild) const;
+    // ids of loaded guilds are ignored, their directory entries may be outdated
+    uint32 FindUnloadedGuildByName(std::string_view guildName) const;
+    uint32 FindUnloadedGuildByLeader(ObjectGuid guid) const;
+    void UnloadIdleGuilds();
+    void UpdateStats();
+
+    bool _lazyLoad = false;
+    std::thread::id _worldThreadId;           // the thread of LoadGuilds and Update
+    mutable GuildDirectory _directory;
+    mutable std::shared_mutex _storeLock;     // GuildStore and _directory
+
+    mutable std::unordered_set<uint32> _loadingGuilds;  // guilds being built, world thread only
+
+    QueryCallbackProcessor _queryProcessor;
+    std::unordered_set<uint32> _pendingLoads;   // background loads in flight, world thread only
+    mutable std::mutex _requestLock;
+    mutable std::unordered_set<uint32> _requestedLoads;  // guilds looked up from other threads, turned into background loads by Update
+    IntervalTimer _sweepTimer;
+
+    mutable std::atomic<uint32> _loadCount{0};
+    std::atomic<uint32> _unloadCount{0};
+    mutable std::mutex _statsLock;
+    Stats _stats;
 };
 
 #define sGuildMgr GuildMgr::instance()
@@ -22,6 +22,7 @@
 #include "Battleground.h"
 #include "CalendarMgr.h"
 #include "CharacterCache.h"
+#include "CharacterEnumCache.h"
 #include "CharacterPackets.h"
 #include "Chat.h"
 #include "Common.h"
@@ -55,6 +56,7 @@
 #include "Tokenize.h"
 #include "Transport.h"
 #include "Util.h"
+#include "WhoListCacheMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -65,12 +67,14 @@ class LoginQueryHolder : public CharacterDatabaseQueryHolder
 private:
     uint32 m_accountId;
     ObjectGuid m_guid;
+    TimePoint m_createTime;
 public:
     LoginQueryHolder(uint32 accountId, ObjectGuid guid)
-        : m_accountId(accountId), m_guid(guid) { }
+        : m_accountId(accountId), m_guid(guid), m_createTime(std::chrono::steady_clock::now()) { }
 
     ObjectGuid GetGuid() const { return m_guid; }
     uint32 GetAccountId() const { return m_accountId; }
+    TimePoint GetCreateTime() const { return m_createTime; }
     bool Initialize();
 };
 
@@ -221,10 +225,19 @@ bool LoginQueryHolder::Initialize()
     stmt->SetData(0, lowGuid);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_OFFLINE_ACHIEVEMENTS_UPDATES, stmt);
 
+    // rows that pile up with play time, they dominate the login when the holder is run in parallel
+    for (PlayerLoginQueryIndex index : { PLAYER_LOGIN_QUERY_LOAD_INVENTORY, PLAYER_LOGIN_QUERY_LOAD_ACHIEVEMENTS, PLAYER_LOGIN_QUERY_LOAD_CRITERIA_PROGRESS,
+        PLAYER_LOGIN_QUERY_LOAD_QUEST_STATUS_REW, PLAYER_LOGIN_QUERY_LOAD_SPELLS, PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS })
+        SetQueryWeight(index, 4);
+
+    for (PlayerLoginQueryIndex index : { PLAYER_LOGIN_QUERY_LOAD_QUEST_STATUS, PLAYER_LOGIN_QUERY_LOAD_REPUTATION, PLAYER_LOGIN_QUERY_LOAD_ACTIONS,
+        PLAYER_LOGIN_QUERY_LOAD_MAILS, PLAYER_LOGIN_QUERY_LOAD_SKILLS, PLAYER_LOGIN_QUERY_LOAD_TALENTS, PLAYER_LOGIN_QUERY_LOAD_AURAS })
+        SetQueryWeight(index, 2);
+
     return res;
 }
 
-void WorldSession::HandleCharEnum(PreparedQueryResult result)
+void WorldSession::HandleCharEnum(uint32 cacheTicket, PreparedQueryResult result)
 {
     WorldPacket data(SMSG_CHAR_ENUM, 100);                  // we guess size
 
@@ -249,11 +262,22 @@ void WorldSession::HandleCharEnum(PreparedQueryResult result)
 
     data.put<uint8>(0, num);
 
+    sCharacterEnumCache->Store(GetAccountId(), cacheTicket, data.contents(), data.size(), _legitCharacters);
+
     SendPacket(&data);
 }
 
 void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recvData*/)
 {
+    std::vector<uint8> cachedEnum;
+    if (sCharacterEnumCache->Get(GetAccountId(), cachedEnum, _legitCharacters))
+    {
+        WorldPacket data(SMSG_CHAR_ENUM, cachedEnum.size());
+        data.append(cachedEnum.data(), cachedEnum.size());
+        SendPacket(&data);
+        return;
+    }
+
     CharacterDatabasePreparedStatement* stmt = nullptr;
 
     /// get all the data necessary for loading all characters (along with their pets) on the account
@@ -266,7 +290,7 @@ void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recvData*/)
     stmt->SetData(0, PET_SAVE_AS_CURRENT);
     stmt->SetData(1, GetAccountId());
 
-    _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::HandleCharEnum, this, std::placeholders::_1)));
+    _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(std::bind(&WorldSession::HandleCharEnum, this, sCharacterEnumCache->BeginQuery(GetAccountId()), std::placeholders::_1)));
 }
 
 void WorldSession::HandleCharCreateOpcode(WorldPacket& recvData)
@@ -625,7 +649,7 @@ void WorldSession::HandleCharDeleteOpcode(WorldPacket& recvData)
     std::string name;
 
     // is guild leader
-    if (sGuildMgr->GetGuildByLeader(guid))
+    if (sGuildMgr->IsGuildLeader(guid))
     {
         sScriptMgr->OnPlayerFailedDelete(guid, initAccountId);
         SendCharDelete(CHAR_DELETE_FAILED_GUILD_LEADER);
@@ -778,15 +802,24 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
     if (!holder->Initialize())
         return;
 
+    // with lazy guild loading the guild is loaded alongside the character instead of during login
+    if (uint32 guildId = sCharacterCache->GetCharacterGuildIdByGuid(playerGuid))
+        sGuildMgr->PrefetchGuild(guildId);
+
     m_playerLoading = true;
-    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder)).AfterComplete([this](SQLQueryHolderBase const& holder)
+    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder, sWorld->getIntConfig(CONFIG_LOGIN_QUERY_PARALLELISM))).AfterComplete([this](SQLQueryHolderBase const& holder)
     {
-        HandlePlayerLoginFromDB(static_cast<LoginQueryHolder const&>(holder));
+        LoginQueryHolder const& loginHolder = static_cast<LoginQueryHolder const&>(holder);
+        // queue wait and query time, up to the session update that picked up the results
+        METRIC_VALUE("player_login_time", std::chrono::steady_clock::now() - loginHolder.GetCreateTime(), METRIC_TAG("phase", "db"));
+        HandlePlayerLoginFromDB(loginHolder);
     });
 }
 
 void WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder const& holder)
 {
+    METRIC_TIMER("player_login_time", METRIC_TAG("phase", "processing"));
+
     ObjectGuid playerGuid = holder.GetGuid();
 
     Player* pCurrChar = new Player(this);
@@ -1057,6 +1090,8 @@ void WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder const& holder)
 
     m_playerLoading = false;
 
+    sWhoListCacheMgr->AddPlayer(pCurrChar);
+
     // Handle Login-Achievements (should be handled after loading)
     _player->UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_ON_LOGIN, 1);
 
@@ -1255,6 +1290,8 @@ void WorldSession::HandlePlayerLoginToCharInWorld(Player* pCurrChar)
         ChatHandler(pCurrChar->GetSession()).SendNotification(LANG_GM_ON);
 
     m_playerLoading = false;
+
+    sWhoListCacheMgr->AddPlayer(pCurrChar);
 }
 
 void WorldSession::HandlePlayerLoginToCharOutOfWorld(Player* /*pCurrChar*/)
@@ -1402,21 +1439,25 @@ void WorldSession::HandleCharRenameCallBack(std::shared_ptr<CharacterRenameInfo>
         return;
     }
 
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
     // Update name and at_login flag in the db
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHAR_NAME_AT_LOGIN);
     stmt->SetData(0, renameInfo->Name);
     stmt->SetData(1, atLoginFlags);
     stmt->SetData(2, guidLow);
-    CharacterDatabase.Execute(stmt);
+    trans->Append(stmt);
 
     // Removed declined name from db
     if (sWorld->getBoolConfig(CONFIG_DECLINED_NAMES_USED))
     {
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_DECLINED_NAME);
         stmt->SetData(0, guidLow);
-        CharacterDatabase.Execute(stmt);
+        trans->Append(stmt);
     }
 
+    sCharacterEnumCache->CommitTransaction(GetAccountId(), trans);
+
     LOG_INFO("entities.player.character", "Account: {} (IP: {}), Character [{}] (guid: {}) Changed name to: {}", GetAccountId(), GetRemoteAddress(), oldName, guidLow, renameInfo->Name);
 
     SendCharRename(RESPONSE_SUCCESS, renameInfo.get());
@@ -1737,7 +1778,7 @@ void WorldSession::HandleCharCustomizeCallback(std::shared_ptr<CharacterCustomiz
         }
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    sCharacterEnumCache->CommitTransaction(GetAccountId(), trans);
 
     sCharacterCache->UpdateCharacterData(customizeInfo->Guid, customizeInfo->Name, customizeInfo->Gender);
 
@@ -2567,7 +2608,7 @@ void WorldSession::HandleCharFactionOrRaceChangeCallback(std::shared_ptr<Charact
     stmt->SetData(1, lowGuid);
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    sCharacterEnumCache->CommitTransaction(GetAccountId(), trans);
 
     LOG_DEBUG("entities.player", "{} (IP: {}) changed race from {} to {}", GetPlayerInfo(), GetRemoteAddress(), oldRace, factionChangeInfo->Race);
 
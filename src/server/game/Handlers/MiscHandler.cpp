@@ -216,7 +216,7 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     uint32 matchCount = 0;
 
     uint32 levelMin, levelMax, racemask, classmask, zonesCount, strCount;
-    std::array<uint32, 10> zoneids = {};                    // 10 is client limit
+    std::vector<uint32> zoneids;                            // 10 is client limit
     std::string packetPlayerName, packetGuildName;
 
     recvData >> levelMin;                                   // maximal player level, default 0
@@ -236,7 +236,7 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     {
         uint32 temp;
         recvData >> temp;                                   // zone id, 0 if zone is unknown...
-        zoneids[i] = temp;
+        zoneids.push_back(temp);
         LOG_DEBUG("network.who", "Zone {}: {}", i, zoneids[i]);
     }
 
@@ -285,20 +285,21 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     data << uint32(matchCount);         // placeholder, count of players matching criteria
     data << uint32(displaycount);       // placeholder, count of players displayed
 
-    for (auto const& target : sWhoListCacheMgr->GetWhoList())
+    // candidates already match the level range and zone list
+    sWhoListCacheMgr->Visit(levelMin, levelMax, zoneids, [&](WhoListPlayerInfo const& target)
     {
         if (AccountMgr::IsPlayerAccount(security))
         {
             // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
             if (target.GetTeamId() != team && !allowTwoSideWhoList)
             {
-                continue;
+                return;
             }
 
             // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
             if (target.GetSecurity() > AccountTypes(gmLevelInWhoList))
             {
-                continue;
+                return;
             }
         }
 
@@ -306,60 +307,38 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
         if ((_player->GetGUID() != target.GetGuid() && !target.IsVisible()) &&
             (AccountMgr::IsPlayerAccount(_player->GetSession()->GetSecurity()) || target.GetSecurity() > _player->GetSession()->GetSecurity()))
         {
-            continue;
+            return;
         }
 
-        // check if target's level is in level range
         uint8 lvl = target.GetLevel();
-        if (lvl < levelMin || lvl > levelMax)
-        {
-            continue;
-        }
 
         // check if class matches classmask
         uint8 class_ = target.GetClass();
         if (!(classmask & (1 << class_)))
         {
-            continue;
+            return;
         }
 
         // check if race matches racemask
         uint32 race = target.GetRace();
         if (!(racemask & (1 << race)))
         {
-            continue;
+            return;
         }
 
         uint32 playerZoneId = target.GetZoneId();
         uint8 gender = target.GetGender();
 
-        bool showZones = true;
-        for (uint32 i = 0; i < zonesCount; ++i)
-        {
-            if (zoneids[i] == playerZoneId)
-            {
-                showZones = true;
-                break;
-            }
-
-            showZones = false;
-        }
-
-        if (!showZones)
-        {
-            continue;
-        }
-
         std::wstring const& wideplayername = target.GetWidePlayerName();
         if (!(wpacketPlayerName.empty() || wideplayername.find(wpacketPlayerName) != std::wstring::npos))
         {
-            continue;
+            return;
         }
 
         std::wstring const& wideguildname = target.GetWideGuildName();
         if (!(wpacketGuildName.empty() || wideguildname.find(wpacketGuildName) != std::wstring::npos))
         {
-            continue;
+            return;
         }
 
         std::string aname;
@@ -387,14 +366,14 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
 
         if (!s_show)
         {
-            continue;
+            return;
         }
 
         // 49 is maximum player count sent to client - can be overridden
         // through config, but is unstable
         if ((matchCount++) >= sWorld->getIntConfig(CONFIG_MAX_WHO_LIST_RETURN))
         {
-            continue;
+            return;
         }
 
         data << target.GetPlayerName();                   // player name
@@ -406,7 +385,7 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
         data << uint32(playerZoneId);                     // player zone id
 
         ++displaycount;
-    }
+    });
 
     data.put(0, displaycount);                            // insert right count, count displayed
     data.put(4, matchCount);                              // insert right count, count of matches
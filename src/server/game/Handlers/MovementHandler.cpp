@@ -24,6 +24,7 @@
 #include "Corpse.h"
 #include "GameGraveyard.h"
 #include "GameTime.h"
+#include "GridNotifiers.h"
 #include "InstanceSaveMgr.h"
 #include "Log.h"
 #include "MapMgr.h"
@@ -392,6 +393,21 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recvData)
     /* process position-change */
     WorldPacket data(opcode, recvData.size());
     WriteMovementInfo(&data, &movementInfo);
+
+    if (sWorld->getBoolConfig(CONFIG_MOVEMENT_INTEREST_ENABLED))
+    {
+        // a mind controlled player still sees its own movement
+        if (plrMover && plrMover != _player)
+            plrMover->SendDirectMessage(&data);
+
+        // only periodic state updates may be coalesced, starts, stops and jumps are always relayed
+        bool coalescable = opcode == MSG_MOVE_HEARTBEAT || opcode == MSG_MOVE_SET_FACING || opcode == MSG_MOVE_SET_PITCH;
+
+        Acore::MovementDistDeliverer notifier(mover, &data, _player, coalescable);
+        notifier.Visit(mover->GetObjectVisibilityContainer().GetVisiblePlayersMap());
+        return;
+    }
+
     mover->SendMessageToSet(&data, _player);
 }
 
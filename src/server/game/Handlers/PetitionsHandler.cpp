@@ -130,7 +130,7 @@ void WorldSession::HandlePetitionBuyOpcode(WorldPacket& recvData)
 
     if (type == GUILD_CHARTER_TYPE)
     {
-        if (sGuildMgr->GetGuildByName(name))
+        if (sGuildMgr->HasGuildWithName(name))
         {
             Guild::SendCommandResult(this, GUILD_COMMAND_CREATE, ERR_GUILD_NAME_EXISTS_S, name);
             return;
@@ -349,7 +349,7 @@ void WorldSession::HandlePetitionRenameOpcode(WorldPacket& recvData)
 
     if (petition->petitionType == GUILD_CHARTER_TYPE)
     {
-        if (sGuildMgr->GetGuildByName(newName))
+        if (sGuildMgr->HasGuildWithName(newName))
         {
             Guild::SendCommandResult(this, GUILD_COMMAND_CREATE, ERR_GUILD_NAME_EXISTS_S, newName);
             return;
@@ -688,7 +688,7 @@ void WorldSession::HandleTurnInPetitionOpcode(WorldPacket& recvData)
         }
 
         // Check if guild name is already taken
-        if (sGuildMgr->GetGuildByName(name))
+        if (sGuildMgr->HasGuildWithName(name))
         {
             Guild::SendCommandResult(this, GUILD_COMMAND_CREATE, ERR_GUILD_NAME_EXISTS_S, name);
             return;
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_LOOTCHANCETABLE_H
+#define ACORE_LOOTCHANCETABLE_H
+
+#include "Define.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Cumulative chances of the explicitly chanced entries of a loot group.
+ *
+ * A group roll draws a number in [0, 100) and walks the entries subtracting their
+ * chances, the first entry that takes the roll below zero drops and an entry with
+ * a chance of 100 or more drops as soon as it is reached. Summing the chances up
+ * front turns that walk into a binary search with the same outcome.
+ */
+class LootChanceTable
+{
+public:
+    LootChanceTable() = default;
+
+    void Clear() { _cumulativeChances.clear(); }
+
+    // Appends an entry, entries must be added in roll order
+    void Add(float chance)
+    {
+        float total = _cumulativeChances.empty() ? 0.0f : _cumulativeChances.back();
+        _cumulativeChances.push_back(chance >= 100.0f ? std::numeric_limits<float>::infinity() : total + chance);
+    }
+
+    [[nodiscard]] std::size_t GetSize() const { return _cumulativeChances.size(); }
+
+    // Index of the entry that drops for roll, -1 if the roll misses every entry
+    [[nodiscard]] int32 Select(float roll) const
+    {
+        auto itr = std::upper_bound(_cumulativeChances.begin(), _cumulativeChances.end(), roll);
+        if (itr == _cumulativeChances.end())
+            return -1;
+
+        return int32(itr - _cumulativeChances.begin());
+    }
+
+private:
+    std::vector<float> _cumulativeChances;
+};
+
+#endif
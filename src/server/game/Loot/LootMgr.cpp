@@ -21,6 +21,7 @@
 #include "Group.h"
 #include "ItemEnchantmentMgr.h"
 #include "Log.h"
+#include "LootChanceTable.h"
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "ScriptMgr.h"
@@ -108,14 +109,19 @@ public:
     void Verify(LootStore const& lootstore, uint32 id, uint8 group_id) const;
     void CollectLootIds(LootIdSet& set) const;
     void CheckLootRefs(LootStore const& lootstore, uint32 Id, LootIdSet* ref_set) const;
-    LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
-    LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
+    LootStoreItemVector* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
+    LootStoreItemVector* GetEqualChancedItemList() { return &EqualChanced; }
     void CopyConditions(ConditionList conditions);
+    void LinkReferences();
 private:
-    LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
-    LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+    LootStoreItemVector ExplicitlyChanced;              // Entries with chances defined in DB
+    LootStoreItemVector EqualChanced;                   // Zero chances - every entry takes the same chance
+    LootChanceTable ExplicitChances;                    // Cumulative chances of ExplicitlyChanced
+    uint16 CommonLootMode{0xFFFF};                      // Loot mode bits set on every entry
+    uint8 GroupId{0};
 
     LootStoreItem const* Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const;   // Rolls an item from the group, returns nullptr if all miss their chances
+    bool MayHaveInvalidEntries(Loot const& loot, uint16 lootMode) const;   // False if LootGroupInvalidSelector cannot reject any entry
 
     // This class must never be copied - storing pointers
     LootGroup(LootGroup const&);
@@ -211,6 +217,7 @@ uint32 LootStore::LoadLootTable()
     } while (result->NextRow());
 
     Verify();                                           // Checks validity of the loot store
+    LinkReferences();
 
     return count;
 }
@@ -235,6 +242,12 @@ bool LootStore::HaveQuestLootForPlayer(uint32 loot_id, Player const* player) con
     return false;
 }
 
+void LootStore::LinkReferences()
+{
+    for (LootTemplateMap::const_iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
+        itr->second->LinkReferences();
+}
+
 void LootStore::ResetConditions()
 {
     for (LootTemplateMap::iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
@@ -523,10 +536,9 @@ void Loot::AddItem(LootStoreItem const& item)
 
     for (uint32 i = 0; i < stacks && lootItems.size() < limit; ++i)
     {
-        LootItem generatedLoot(item);
+        LootItem& generatedLoot = lootItems.emplace_back(item);
         generatedLoot.count = std::min(count, proto->GetMaxStackSize());
-        generatedLoot.itemIndex = lootItems.size();
-        lootItems.push_back(generatedLoot);
+        generatedLoot.itemIndex = lootItems.size() - 1;
         count -= proto->GetMaxStackSize();
 
         // In some cases, a dropped item should be visible/lootable only for some players in group
@@ -585,8 +597,8 @@ bool Loot::FillLoot(uint32 lootId, LootStore const& store, Player* lootOwner, bo
         return false;
     }
 
+    // quest items are rare, their storage is only allocated when one drops
     items.reserve(MAX_NR_LOOT_ITEMS);
-    quest_items.reserve(MAX_NR_QUEST_ITEMS);
 
     // Initial group is 0, top level set to True
     tab->Process(*this, store, lootMode, lootOwner, 0, true);          // Processing is done there, callback via Loot::AddItem()
@@ -1283,22 +1295,59 @@ LootTemplate::LootGroup::~LootGroup()
 void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
 {
     if (item->chance != 0)
+    {
         ExplicitlyChanced.push_back(item);
+        ExplicitChances.Add(item->chance);
+    }
     else
         EqualChanced.push_back(item);
+
+    CommonLootMode &= item->lootmode;
+    GroupId = item->groupid;
+}
+
+// LootGroupInvalidSelector rejects entries of another loot mode and duplicates of items this group already dropped
+bool LootTemplate::LootGroup::MayHaveInvalidEntries(Loot const& loot, uint16 lootMode) const
+{
+    if (!(CommonLootMode & lootMode))
+        return true;
+
+    for (LootItem const& item : loot.items)
+        if (item.groupid == GroupId)
+            return true;
+
+    return false;
 }
 
 // Rolls an item from the group, returns nullptr if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const
 {
-    LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    // Without filtered entries and roll hooks the walk below is a lookup in the cumulative chances
+    if (!sScriptMgr->HasLootRollHooks() && !MayHaveInvalidEntries(loot, lootMode))
+    {
+        if (!ExplicitlyChanced.empty())
+        {
+            int32 index = ExplicitChances.Select((float)rand_chance());
+            if (index >= 0)
+                return ExplicitlyChanced[index];
+        }
+
+        if (!EqualChanced.empty())
+            return EqualChanced[urand(0, EqualChanced.size() - 1)];
+
+        return nullptr;
+    }
+
+    LootGroupInvalidSelector isInvalid(loot, lootMode);
+    LootStoreItemVector possibleLoot;
+    possibleLoot.reserve(std::max(ExplicitlyChanced.size(), EqualChanced.size()));
+    std::remove_copy_if(ExplicitlyChanced.begin(), ExplicitlyChanced.end(), std::back_inserter(possibleLoot), isInvalid);
 
     if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
     {
         float roll = (float)rand_chance();
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
+        for (LootStoreItemVector::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
         {
             LootStoreItem* item = *itr;
             float chance = item->chance;
@@ -1315,11 +1364,11 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* pla
         }
     }
 
-    if (!sScriptMgr->OnBeforeLootEqualChanced(player, EqualChanced, loot, store))
+    if (!sScriptMgr->OnBeforeLootEqualChanced(player, LootStoreItemList(EqualChanced.begin(), EqualChanced.end()), loot, store))
         return nullptr;
 
-    possibleLoot = EqualChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    possibleLoot.clear();
+    std::remove_copy_if(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(possibleLoot), isInvalid);
     if (!possibleLoot.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
         return Acore::Containers::SelectRandomContainerElement(possibleLoot);
 
@@ -1329,7 +1378,7 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* pla
 // True if group includes at least 1 quest drop entry
 bool LootTemplate::LootGroup::HasQuestDrop(LootTemplateMap const& store) const
 {
-    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
     {
         LootStoreItem* item = *i;
         if (item->reference) // References
@@ -1351,7 +1400,7 @@ bool LootTemplate::LootGroup::HasQuestDrop(LootTemplateMap const& store) const
         }
     }
 
-    for (LootStoreItemList::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
     {
         LootStoreItem* item = *i;
         if (item->reference) // References
@@ -1379,7 +1428,7 @@ bool LootTemplate::LootGroup::HasQuestDrop(LootTemplateMap const& store) const
 // True if group includes at least 1 quest drop entry for active quests of the player
 bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player, LootTemplateMap const& store) const
 {
-    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
     {
         LootStoreItem* item = *i;
         if (item->reference)                        // References processing
@@ -1401,7 +1450,7 @@ bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player, LootTe
         }
     }
 
-    for (LootStoreItemList::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
     {
         LootStoreItem* item = *i;
         if (item->reference)                        // References processing
@@ -1428,13 +1477,22 @@ bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player, LootTe
 
 void LootTemplate::LootGroup::CopyConditions(ConditionList /*conditions*/)
 {
-    for (LootStoreItemList::iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+    for (LootStoreItemVector::iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
         (*i)->conditions.clear();
 
-    for (LootStoreItemList::iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
+    for (LootStoreItemVector::iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
         (*i)->conditions.clear();
 }
 
+void LootTemplate::LootGroup::LinkReferences()
+{
+    for (LootStoreItem* item : ExplicitlyChanced)
+        item->referencedLoot = item->reference ? LootTemplates_Reference.GetLootFor(std::abs(item->reference)) : nullptr;
+
+    for (LootStoreItem* item : EqualChanced)
+        item->referencedLoot = item->reference ? LootTemplates_Reference.GetLootFor(std::abs(item->reference)) : nullptr;
+}
+
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
 void LootTemplate::LootGroup::Process(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode, uint16 nonRefIterationsLeft) const
 {
@@ -1444,7 +1502,7 @@ void LootTemplate::LootGroup::Process(Loot& loot, Player const* player, LootStor
 
         if (item->reference) // References processing
         {
-            if (LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(std::abs(item->reference)))
+            if (LootTemplate const* Referenced = item->referencedLoot)
             {
                 uint32 maxcount = uint32(float(item->maxcount) * sWorld->getRate(RATE_DROP_ITEM_REFERENCED_AMOUNT));
                 sScriptMgr->OnAfterRefCount(player, loot, rate, lootMode, const_cast<LootStoreItem*>(item), maxcount, store);
@@ -1476,7 +1534,7 @@ float LootTemplate::LootGroup::RawTotalChance() const
 {
     float result = 0;
 
-    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
         if (!(*i)->needs_quest)
             result += (*i)->chance;
 
@@ -1510,7 +1568,7 @@ void LootTemplate::LootGroup::Verify(LootStore const& lootstore, uint32 id, uint
 
 void LootTemplate::LootGroup::CheckLootRefs(LootStore const& lootstore, uint32 Id, LootIdSet* ref_set) const
 {
-    for (LootStoreItemList::const_iterator ieItr = ExplicitlyChanced.begin(); ieItr != ExplicitlyChanced.end(); ++ieItr)
+    for (LootStoreItemVector::const_iterator ieItr = ExplicitlyChanced.begin(); ieItr != ExplicitlyChanced.end(); ++ieItr)
     {
         LootStoreItem* item = *ieItr;
         if (item->reference)
@@ -1525,7 +1583,7 @@ void LootTemplate::LootGroup::CheckLootRefs(LootStore const& lootstore, uint32 I
         }
     }
 
-    for (LootStoreItemList::const_iterator ieItr = EqualChanced.begin(); ieItr != EqualChanced.end(); ++ieItr)
+    for (LootStoreItemVector::const_iterator ieItr = EqualChanced.begin(); ieItr != EqualChanced.end(); ++ieItr)
     {
         LootStoreItem* item = *ieItr;
         if (item->reference)
@@ -1583,7 +1641,7 @@ void LootTemplate::AddEntry(LootStoreItem* item)
 
 void LootTemplate::CopyConditions(ConditionList conditions)
 {
-    for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
+    for (LootStoreItemVector::iterator i = Entries.begin(); i != Entries.end(); ++i)
         (*i)->conditions.clear();
 
     for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
@@ -1591,14 +1649,25 @@ void LootTemplate::CopyConditions(ConditionList conditions)
             group->CopyConditions(conditions);
 }
 
+// Resolves the reference templates once so rolls do not have to look them up
+void LootTemplate::LinkReferences()
+{
+    for (LootStoreItem* item : Entries)
+        item->referencedLoot = item->reference ? LootTemplates_Reference.GetLootFor(std::abs(item->reference)) : nullptr;
+
+    for (LootGroup* group : Groups)
+        if (group)
+            group->LinkReferences();
+}
+
 bool LootTemplate::CopyConditions(LootItem* li, uint32 conditionLootId) const
 {
-    for (LootStoreItemList::const_iterator _iter = Entries.begin(); _iter != Entries.end(); ++_iter)
+    for (LootStoreItemVector::const_iterator _iter = Entries.begin(); _iter != Entries.end(); ++_iter)
     {
         LootStoreItem* item = *_iter;
         if (item->reference)
         {
-            if (LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(std::abs(item->reference)))
+            if (LootTemplate const* Referenced = item->referencedLoot)
             {
                 if (Referenced->CopyConditions(li, conditionLootId))
                 {
@@ -1629,13 +1698,13 @@ bool LootTemplate::CopyConditions(LootItem* li, uint32 conditionLootId) const
         if (!group)
             continue;
 
-        LootStoreItemList* itemList = group->GetExplicitlyChancedItemList();
-        for (LootStoreItemList::iterator i = itemList->begin(); i != itemList->end(); ++i)
+        LootStoreItemVector* itemList = group->GetExplicitlyChancedItemList();
+        for (LootStoreItemVector::iterator i = itemList->begin(); i != itemList->end(); ++i)
         {
             LootStoreItem* item = *i;
             if (item->reference)
             {
-                if (LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(std::abs(item->reference)))
+                if (LootTemplate const* Referenced = item->referencedLoot)
                 {
                     if (Referenced->CopyConditions(li, conditionLootId))
                     {
@@ -1661,12 +1730,12 @@ bool LootTemplate::CopyConditions(LootItem* li, uint32 conditionLootId) const
         }
 
         itemList = group->GetEqualChancedItemList();
-        for (LootStoreItemList::iterator i = itemList->begin(); i != itemList->end(); ++i)
+        for (LootStoreItemVector::iterator i = itemList->begin(); i != itemList->end(); ++i)
         {
             LootStoreItem* item = *i;
             if (item->reference)
             {
-                if (LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(std::abs(item->reference)))
+                if (LootTemplate const* Referenced = item->referencedLoot)
                 {
                     if (Referenced->CopyConditions(li, conditionLootId))
                     {
@@ -1721,7 +1790,7 @@ void LootTemplate::Process(Loot& loot, LootStore const& store, uint16 lootMode,
     }
 
     // Rolling non-grouped items
-    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
     {
         LootStoreItem* item = *i;
         if (!(item->lootmode & lootMode))                         // Do not add if mode mismatch
@@ -1731,7 +1800,7 @@ void LootTemplate::Process(Loot& loot, LootStore const& store, uint16 lootMode,
 
         if (item->reference)                                    // References processing
         {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(std::abs(item->reference));
+            LootTemplate const* Referenced = item->referencedLoot;
             if (!Referenced)
                 continue;                                       // Error message already printed at loading stage
 
@@ -1781,7 +1850,7 @@ bool LootTemplate::HasQuestDrop(LootTemplateMap const& store, uint8 groupId) con
         return Groups[groupId - 1]->HasQuestDrop(store);
     }
 
-    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
     {
         LootStoreItem* item = *i;
         if (item->reference)                                // References
@@ -1827,7 +1896,7 @@ bool LootTemplate::HasQuestDropForPlayer(LootTemplateMap const& store, Player co
     }
 
     // Checking non-grouped entries
-    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
+    for (LootStoreItemVector::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
     {
         LootStoreItem* item = *i;
         if (item->reference)                                // References processing
@@ -1870,7 +1939,7 @@ void LootTemplate::Verify(LootStore const& lootstore, uint32 id) const
 
 void LootTemplate::CheckLootRefs(LootStore const& lootstore, uint32 Id, LootIdSet* ref_set) const
 {
-    for (LootStoreItemList::const_iterator ieItr = Entries.begin(); ieItr != Entries.end(); ++ieItr)
+    for (LootStoreItemVector::const_iterator ieItr = Entries.begin(); ieItr != Entries.end(); ++ieItr)
     {
         LootStoreItem* item = *ieItr;
         if (item->reference)
@@ -1900,7 +1969,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
 
     if (!Entries.empty())
     {
-        for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
+        for (LootStoreItemVector::iterator i = Entries.begin(); i != Entries.end(); ++i)
         {
             if ((*i)->itemid == uint32(cond->SourceEntry))
             {
@@ -1918,10 +1987,10 @@ bool LootTemplate::addConditionItem(Condition* cond)
             if (!group)
                 continue;
 
-            LootStoreItemList* itemList = group->GetExplicitlyChancedItemList();
+            LootStoreItemVector* itemList = group->GetExplicitlyChancedItemList();
             if (!itemList->empty())
             {
-                for (LootStoreItemList::iterator i = itemList->begin(); i != itemList->end(); ++i)
+                for (LootStoreItemVector::iterator i = itemList->begin(); i != itemList->end(); ++i)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
@@ -1934,7 +2003,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
             itemList = group->GetEqualChancedItemList();
             if (!itemList->empty())
             {
-                for (LootStoreItemList::iterator i = itemList->begin(); i != itemList->end(); ++i)
+                for (LootStoreItemVector::iterator i = itemList->begin(); i != itemList->end(); ++i)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
@@ -1950,7 +2019,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
 
 bool LootTemplate::isReference(uint32 id) const
 {
-    for (LootStoreItemList::const_iterator ieItr = Entries.begin(); ieItr != Entries.end(); ++ieItr)
+    for (LootStoreItemVector::const_iterator ieItr = Entries.begin(); ieItr != Entries.end(); ++ieItr)
     {
         if ((*ieItr)->itemid == id && (*ieItr)->reference)
         {
@@ -2368,6 +2437,20 @@ void LoadLootTemplates_Reference()
     // output error for any still listed ids (not referenced from any loot table)
     LootTemplates_Reference.ReportUnusedIds(lootIdSet);
 
+    // the templates the other stores pointed to are gone
+    LootTemplates_Creature.LinkReferences();
+    LootTemplates_Fishing.LinkReferences();
+    LootTemplates_Gameobject.LinkReferences();
+    LootTemplates_Item.LinkReferences();
+    LootTemplates_Milling.LinkReferences();
+    LootTemplates_Pickpocketing.LinkReferences();
+    LootTemplates_Skinning.LinkReferences();
+    LootTemplates_Disenchant.LinkReferences();
+    LootTemplates_Prospecting.LinkReferences();
+    LootTemplates_Mail.LinkReferences();
+    LootTemplates_Spell.LinkReferences();
+    LootTemplates_Player.LinkReferences();
+
     LOG_INFO("server.loading", ">> Loaded reference loot templates in {} ms", GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
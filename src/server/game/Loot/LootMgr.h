@@ -120,6 +120,7 @@ enum LootSlotType
 
 class Player;
 class LootStore;
+class LootTemplate;
 class ConditionMgr;
 class GameObject;
 struct Loot;
@@ -135,6 +136,7 @@ struct LootStoreItem
     uint8   mincount;                           // mincount for drop items
     uint8   maxcount;                           // max drop count for the item mincount or Ref multiplicator
     ConditionList conditions;                   // additional loot condition
+    LootTemplate const* referencedLoot{nullptr}; // template of the reference, linked by LootStore::LinkReferences
 
     // Constructor
     // displayid is filled in IsValid() which must be called after
@@ -199,6 +201,7 @@ typedef std::vector<QuestItem> QuestItemList;
 typedef std::vector<LootItem> LootItemList;
 typedef std::map<ObjectGuid, QuestItemList*> QuestItemMap;
 typedef std::list<LootStoreItem*> LootStoreItemList;
+typedef std::vector<LootStoreItem*> LootStoreItemVector;
 typedef std::unordered_map<uint32, LootTemplate*> LootTemplateMap;
 
 typedef std::set<uint32> LootIdSet;
@@ -213,6 +216,7 @@ public:
 
     uint32 LoadAndCollectLootIds(LootIdSet& ids_set);
     void ResetConditions();
+    void LinkReferences();
 
     void Verify() const;
     void CheckLootRefs(LootIdSet* ref_set = nullptr) const; // check existence reference and remove it from ref_set
@@ -265,11 +269,12 @@ public:
     // Checks integrity of the template
     void Verify(LootStore const& store, uint32 Id) const;
     void CheckLootRefs(LootStore const& lootstore, uint32 Id, LootIdSet* ref_set) const;
+    void LinkReferences();
     bool addConditionItem(Condition* cond);
     [[nodiscard]] bool isReference(uint32 id) const;
 
 private:
-    LootStoreItemList Entries;                          // not grouped only
+    LootStoreItemVector Entries;                        // not grouped only
     LootGroups        Groups;                           // groups have own (optimised) processing, grouped entries go there
 
     // Objects of this class must never be copied, we are storing pointers in container
@@ -0,0 +1,254 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ExpiredMailMgr.h"
+#include "CharacterCache.h"
+#include "DatabaseEnv.h"
+#include "GameTime.h"
+#include "Log.h"
+#include "Metric.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "World.h"
+#include <unordered_map>
+
+ExpiredMailMgr* ExpiredMailMgr::instance()
+{
+    static ExpiredMailMgr instance;
+    return &instance;
+}
+
+void ExpiredMailMgr::Start()
+{
+    if (_running)
+        return;
+
+    _running = true;
+    _pageQueried = false;
+    _expireTime = uint32(GameTime::GetGameTime().count());
+    _lastMailId = 0;
+    _startTime = std::chrono::steady_clock::now();
+    _deletedCount = 0;
+    _returnedCount = 0;
+    _skippedCount = 0;
+
+    LOG_INFO("mail", "Returning and deleting mail expired before {}", _expireTime);
+}
+
+void ExpiredMailMgr::Update()
+{
+    _queryProcessor.ProcessReadyCallbacks();
+
+    if (_running && !_pageQueried)
+        QueryNextPage();
+}
+
+void ExpiredMailMgr::QueryNextPage()
+{
+    _pageQueried = true;
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
+    stmt->SetData(0, _expireTime);
+    stmt->SetData(1, _lastMailId);
+    stmt->SetData(2, std::max<uint32>(sWorld->getIntConfig(CONFIG_EXPIRED_MAIL_BATCH_SIZE), 1));
+
+    _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(stmt)
+        .WithChainingPreparedCallback([this](QueryCallback& callback, PreparedQueryResult result) { HandlePage(callback, std::move(result)); })
+        .WithPreparedCallback([this](PreparedQueryResult result) { HandlePageItems(std::move(result)); }));
+}
+
+void ExpiredMailMgr::HandlePage(QueryCallback& callback, PreparedQueryResult result)
+{
+    if (!result)
+    {
+        Finish();
+        return;
+    }
+
+    _page.clear();
+    _page.reserve(result->GetRowCount());
+
+    bool hasItems = false;
+    do
+    {
+        Field* fields = result->Fetch();
+
+        ExpiredMail& mail = _page.emplace_back();
+        mail.Data.messageID      = fields[0].Get<uint32>();
+        mail.Data.messageType    = fields[1].Get<uint8>();
+        mail.Data.sender         = fields[2].Get<uint32>();
+        mail.Data.receiver       = fields[3].Get<uint32>();
+        mail.HasItems            = fields[4].Get<bool>();
+        mail.Data.expire_time    = time_t(fields[5].Get<uint32>());
+        mail.Data.deliver_time   = time_t(0);
+        mail.Data.stationery     = fields[6].Get<uint8>();
+        mail.Data.checked        = fields[7].Get<uint8>();
+        mail.Data.mailTemplateId = fields[8].Get<int16>();
+
+        hasItems |= mail.HasItems;
+    } while (result->NextRow());
+
+    uint32 firstMailId = _page.front().Data.messageID;
+    _lastMailId = _page.back().Data.messageID;
+
+    if (!hasItems)
+    {
+        ProcessPage();
+        return;
+    }
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
+    stmt->SetData(0, _expireTime);
+    stmt->SetData(1, firstMailId);
+    stmt->SetData(2, _lastMailId);
+    callback.SetNextQuery(CharacterDatabase.AsyncQuery(stmt));
+}
+
+void ExpiredMailMgr::HandlePageItems(PreparedQueryResult result)
+{
+    if (result)
+    {
+        std::unordered_map<uint32 /*messageId*/, MailItemInfoVec> items;
+        do
+        {
+            Field* fields = result->Fetch();
+            MailItemInfo item;
+            item.item_guid = fields[0].Get<uint32>();
+            item.item_template = fields[1].Get<uint32>();
+            items[fields[2].Get<uint32>()].push_back(item);
+        } while (result->NextRow());
+
+        for (ExpiredMail& mail : _page)
+        {
+            auto itr = items.find(mail.Data.messageID);
+            if (itr != items.end())
+                mail.Data.items.swap(itr->second);
+        }
+    }
+
+    ProcessPage();
+}
+
+void ExpiredMailMgr::ProcessPage()
+{
+    uint32 const curTime = uint32(GameTime::GetGameTime().count());
+    uint32 deletedCount = 0;
+    uint32 returnedCount = 0;
+    uint32 skippedCount = 0;
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    CharacterDatabasePreparedStatement* stmt = nullptr;
+
+    for (ExpiredMail const& expiredMail : _page)
+    {
+        Mail const& m = expiredMail.Data;
+
+        // don't modify mails of a logged in player
+        if (ObjectAccessor::FindPlayerByLowGUID(m.receiver))
+        {
+            ++skippedCount;
+            continue;
+        }
+
+        // Delete or return mail
+        if (expiredMail.HasItems)
+        {
+            // If it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+            if (!m.IsSentByPlayer() || m.IsSentByGM() || (m.IsCODPayment() || m.IsReturnedMail()))
+            {
+                for (auto const& mailedItem : m.items)
+                {
+                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
+                    stmt->SetData(0, mailedItem.item_guid);
+                    trans->Append(stmt);
+                }
+
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
+                stmt->SetData(0, m.messageID);
+                trans->Append(stmt);
+            }
+            else
+            {
+                // Mail will be returned
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
+                stmt->SetData(0, m.receiver);
+                stmt->SetData(1, m.sender);
+                stmt->SetData(2, uint32(curTime + 30 * DAY));
+                stmt->SetData(3, curTime);
+                stmt->SetData(4, uint8(MAIL_CHECK_MASK_RETURNED));
+                stmt->SetData(5, m.messageID);
+                trans->Append(stmt);
+                for (auto const& mailedItem : m.items)
+                {
+                    // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
+                    stmt->SetData(0, m.sender);
+                    stmt->SetData(1, mailedItem.item_guid);
+                    trans->Append(stmt);
+
+                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
+                    stmt->SetData(0, m.sender);
+                    stmt->SetData(1, mailedItem.item_guid);
+                    trans->Append(stmt);
+                }
+
+                // xinef: update global data
+                sCharacterCache->IncreaseCharacterMailCount(ObjectGuid(HighGuid::Player, m.sender));
+                sCharacterCache->DecreaseCharacterMailCount(ObjectGuid(HighGuid::Player, m.receiver));
+
+                ++returnedCount;
+                continue;
+            }
+        }
+
+        sCharacterCache->DecreaseCharacterMailCount(ObjectGuid(HighGuid::Player, m.receiver));
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
+        stmt->SetData(0, m.messageID);
+        trans->Append(stmt);
+        ++deletedCount;
+    }
+
+    // a page of online players' mails only leaves an empty transaction behind
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
+
+    _page.clear();
+
+    _deletedCount += deletedCount;
+    _returnedCount += returnedCount;
+    _skippedCount += skippedCount;
+
+    METRIC_VALUE("expired_mail", uint64(deletedCount), METRIC_TAG("result", "deleted"));
+    METRIC_VALUE("expired_mail", uint64(returnedCount), METRIC_TAG("result", "returned"));
+    METRIC_VALUE("expired_mail", uint64(skippedCount), METRIC_TAG("result", "skipped"));
+
+    // next page is requested by the next update
+    _pageQueried = false;
+}
+
+void ExpiredMailMgr::Finish()
+{
+    _running = false;
+    _pageQueried = false;
+
+    Milliseconds duration = std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - _startTime);
+    METRIC_VALUE("expired_mail_time", uint64(duration.count()));
+
+    LOG_INFO("mail", "Processed {} expired mails: {} deleted, {} returned and {} of online players kept in {} ms",
+        _deletedCount + _returnedCount + _skippedCount, _deletedCount, _returnedCount, _skippedCount, duration.count());
+}
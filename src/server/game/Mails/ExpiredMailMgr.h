@@ -0,0 +1,85 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _EXPIREDMAILMGR_H
+#define _EXPIREDMAILMGR_H
+
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
+#include "Duration.h"
+#include "Mail.h"
+#include "QueryCallback.h"
+#include <vector>
+
+/**
+ * @brief Returns or deletes expired mail in the background.
+ *
+ * A pass walks the mail table by id in pages of ExpiredMail.BatchSize mails. Each page (and the
+ * items of its mails) is read with async queries and handled once the results are back on the world
+ * thread, all returns and deletes of a page are written in a single transaction. Only one page is
+ * in flight at a time, so a pass never costs a tick more than one page of work.
+ *
+ * Mails of players who are online are left alone, like before.
+ */
+class ExpiredMailMgr
+{
+public:
+    static ExpiredMailMgr* instance();
+
+    // Starts a pass over all mail that is expired now, does nothing while a pass is running
+    void Start();
+    // Handles finished queries and requests the next page, called every world update
+    void Update();
+
+    [[nodiscard]] bool IsRunning() const { return _running; }
+
+private:
+    ExpiredMailMgr() = default;
+    ~ExpiredMailMgr() = default;
+
+    ExpiredMailMgr(ExpiredMailMgr const&) = delete;
+    ExpiredMailMgr& operator=(ExpiredMailMgr const&) = delete;
+
+    struct ExpiredMail
+    {
+        Mail Data;
+        bool HasItems;
+    };
+
+    void QueryNextPage();
+    void HandlePage(QueryCallback& callback, PreparedQueryResult result);
+    void HandlePageItems(PreparedQueryResult result);
+    void ProcessPage();
+    void Finish();
+
+    QueryCallbackProcessor _queryProcessor;
+    bool _running = false;
+    bool _pageQueried = false;
+
+    uint32 _expireTime = 0;     // mails expiring before that time are handled by the current pass
+    uint32 _lastMailId = 0;     // the next page starts after this one
+    std::vector<ExpiredMail> _page;
+
+    TimePoint _startTime;
+    uint32 _deletedCount = 0;
+    uint32 _returnedCount = 0;
+    uint32 _skippedCount = 0;
+};
+
+#define sExpiredMailMgr ExpiredMailMgr::instance()
+
+#endif
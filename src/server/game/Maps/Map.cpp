@@ -24,6 +24,7 @@
 #include "GameTime.h"
 #include "Geometry.h"
 #include "GridNotifiers.h"
+#include "GridTerrainPrefetcher.h"
 #include "Group.h"
 #include "InstanceScript.h"
 #include "IVMapMgr.h"
@@ -429,10 +430,31 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
         ++_zonePlayerCountMap[newZone];
 }
 
+void Map::PrefetchTerrainAhead(Player* player)
+{
+    if (!player->isMoving() && !player->IsInFlight())
+        return;
+
+    bool const flying = player->IsFlying() || player->IsInFlight();
+    float const distance = player->GetSpeed(flying ? MOVE_FLIGHT : MOVE_RUN) * sWorld->getIntConfig(CONFIG_GRID_TERRAIN_PREFETCH_LOOKAHEAD) / float(IN_MILLISECONDS);
+
+    float const x = player->GetPositionX() + distance * std::cos(player->GetOrientation());
+    float const y = player->GetPositionY() + distance * std::sin(player->GetOrientation());
+    if (!Acore::IsValidMapCoord(x, y))
+        return;
+
+    GridCoord const current = Acore::ComputeGridCoord(player->GetPositionX(), player->GetPositionY());
+    GridCoord const ahead = Acore::ComputeGridCoord(x, y);
+    if (current == ahead)
+        return;
+
+    _mapGridManager.PrefetchTerrain(ahead.x_coord, ahead.y_coord);
+}
+
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
     if (t_diff)
-        _dynamicTree.update(t_diff);
+        _pathQueryBatch.BeginUpdate();
 
     // Update world sessions and players
     for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
@@ -462,6 +484,10 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     _updatableObjectListRecheckTimer.Update(t_diff);
     resetMarkedCells();
 
+    bool const prefetchTerrain = GetInstanceId() == 0 && sGridTerrainPrefetcher->IsActivated();
+    if (prefetchTerrain)
+        _mapGridManager.CollectPrefetchedTerrain();
+
     // Update players
     for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
     {
@@ -472,6 +498,9 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
         player->Update(s_diff);
 
+        if (prefetchTerrain)
+            PrefetchTerrainAhead(player);
+
         if (_updatableObjectListRecheckTimer.Passed())
         {
             MarkNearbyCellsOf(player);
@@ -517,6 +546,20 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         METRIC_TAG("map_id", std::to_string(GetId())),
         METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    PathQueryBatch::Stats const& pathStats = _pathQueryBatch.GetStats();
+    if (pathStats.Computed || pathStats.Reused || pathStats.Deferred)
+    {
+        METRIC_VALUE("map_paths", uint64(pathStats.Computed),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("result", "computed"));
+        METRIC_VALUE("map_paths", uint64(pathStats.Reused),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("result", "reused"));
+        METRIC_VALUE("map_paths", uint64(pathStats.Deferred),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("result", "deferred"));
+    }
 }
 
 void Map::UpdateNonPlayerObjects(uint32 const diff)
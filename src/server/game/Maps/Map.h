@@ -32,6 +32,7 @@
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include "PathGenerator.h"
+#include "PathQueryBatch.h"
 #include "Position.h"
 #include "SharedDefines.h"
 #include "Timer.h"
@@ -390,8 +391,11 @@ public:
     void Balance() { _dynamicTree.balance(); }
     void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
     void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
+    void MoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.move(model); }
+    void InvalidateGameObjectModel() { _dynamicTree.invalidate(); }
     [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
+    PathQueryBatch& GetPathQueryBatch() { return _pathQueryBatch; }
     bool GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
     [[nodiscard]] float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
     {
@@ -537,6 +541,7 @@ private:
     std::vector<DynamicObject*> _dynamicObjectsToMove;
 
     bool EnsureGridLoaded(Cell const& cell);
+    void PrefetchTerrainAhead(Player* player);
     MapGridType* GetMapGrid(uint16 const x, uint16 const y);
 
     void ScriptsProcess();
@@ -558,6 +563,7 @@ protected:
     uint32 m_unloadTimer;
     float m_VisibleDistance;
     DynamicMapTree _dynamicTree;
+    PathQueryBatch _pathQueryBatch;
     time_t _instanceResetPeriod; // pussywizard
 
     MapRefMgr m_mapRefMgr;
@@ -20,6 +20,7 @@
 #include "DatabaseEnv.h"
 #include "GridDefines.h"
 #include "GridTerrainLoader.h"
+#include "GridTerrainPrefetcher.h"
 #include "Group.h"
 #include "InstanceSaveMgr.h"
 #include "LFGMgr.h"
@@ -59,6 +60,9 @@ void MapMgr::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 prefetchThreads = sWorld->getIntConfig(CONFIG_GRID_TERRAIN_PREFETCH_THREADS))
+        sGridTerrainPrefetcher->Activate(prefetchThreads);
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -326,6 +330,8 @@ bool MapMgr::IsValidMAP(uint32 mapid, bool startUp)
 
 void MapMgr::UnloadAll()
 {
+    sGridTerrainPrefetcher->Deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end();)
     {
         iter->second->UnloadAll();
@@ -17,6 +17,7 @@
 
 #include "BanMgr.h"
 #include "AccountMgr.h"
+#include "CharacterEnumCache.h"
 #include "Chat.h"
 #include "DatabaseEnv.h"
 #include "GameTime.h"
@@ -237,17 +238,21 @@ BanReturn BanMgr::BanCharacter(std::string const& CharacterName, std::string con
     else
         TargetGUID = target->GetGUID();
 
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
     // make sure there is only one active ban
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHARACTER_BAN);
     stmt->SetData(0, TargetGUID.GetCounter());
-    CharacterDatabase.Execute(stmt);
+    trans->Append(stmt);
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_BAN);
     stmt->SetData(0, TargetGUID.GetCounter());
     stmt->SetData(1, DurationSecs);
     stmt->SetData(2, Author);
     stmt->SetData(3, Reason);
-    CharacterDatabase.Execute(stmt);
+    trans->Append(stmt);
+
+    sCharacterEnumCache->CommitTransaction(sCharacterCache->GetCharacterAccountIdByGuid(TargetGUID), trans);
 
     if (target)
         target->GetSession()->KickPlayer("Ban");
@@ -325,6 +330,6 @@ bool BanMgr::RemoveBanCharacter(std::string const& CharacterName)
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHARACTER_BAN);
     stmt->SetData(0, guid.GetCounter());
-    CharacterDatabase.Execute(stmt);
+    sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(guid), nullptr, stmt);
     return true;
 }
@@ -24,13 +24,14 @@
 #include "MMapMgr.h"
 #include "Map.h"
 #include "Metric.h"
+#include "PathQueryBatch.h"
 
  ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false), _forceDestination(false),
     _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _navMeshQuery(nullptr), _queryBatch(nullptr)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
@@ -85,7 +86,19 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     UpdateFilter();
 
+    Map* map = _source->FindMap();
+    _queryBatch = map ? &map->GetPathQueryBatch() : nullptr;
+
+    auto const startTime = std::chrono::steady_clock::now();
+
     BuildPolyPath(start, dest);
+
+    if (_queryBatch)
+    {
+        _queryBatch->AddCalculationTime(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - startTime));
+        _queryBatch = nullptr;
+    }
+
     return true;
 }
 
@@ -320,6 +333,9 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         _polyLength = pathEndIndex - pathStartIndex + 1;
         memmove(_pathPolyRefs, _pathPolyRefs + pathStartIndex, _polyLength * sizeof(dtPolyRef));
+
+        if (_queryBatch)
+            _queryBatch->AddReused();
     }
     else if (startPolyFound && !endPolyFound)
     {
@@ -369,14 +385,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                 suffixStartPoly,    // start polygon
                 endPoly,            // end polygon
                 suffixEndPoint,     // start position
                 endPoint,           // end position
-                &_filter,            // polygon search filter
                 _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                (int*)&suffixPolyLength,
+                &suffixPolyLength,
                 MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
         }
 
@@ -472,14 +487,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                 startPoly,          // start polygon
                 endPoly,            // end polygon
                 startPoint,         // start position
                 endPoint,           // end position
-                &_filter,           // polygon search filter
                 _pathPolyRefs,     // [out] path
-                (int*)&_polyLength,
+                &_polyLength,
                 MAX_PATH_LENGTH);   // max number of polygons in output path
         }
 
@@ -517,6 +531,16 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathGenerator::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                                     dtPolyRef* path, uint32* pathSize, uint32 maxPathSize)
+{
+    // units of the same map heading from and to the same polygons share the corridor, only the point path is their own
+    if (_queryBatch)
+        return _queryBatch->FindPath(_navMeshQuery, &_filter, startPoly, endPoly, startPoint, endPoint, path, pathSize, maxPathSize);
+
+    return _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter, path, (int*)pathSize, maxPathSize);
+}
+
 void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
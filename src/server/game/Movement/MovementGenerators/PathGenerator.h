@@ -26,6 +26,7 @@
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
 
+class PathQueryBatch;
 class Unit;
 class WorldObject;
 
@@ -150,6 +151,8 @@ class PathGenerator
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
+        PathQueryBatch* _queryBatch;            // corridors shared by the source's map during the current calculation, may be null
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
@@ -164,6 +167,8 @@ class PathGenerator
         [[nodiscard]] bool HaveTile(G3D::Vector3 const& p) const;
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        dtStatus FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                              dtPolyRef* path, uint32* pathSize, uint32 maxPathSize);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathQueryBatch.h"
+#include "PathGenerator.h"
+#include "World.h"
+#include <algorithm>
+
+// upper bound of corridors kept per map update, a few hundred chasers is already a lot
+static constexpr std::size_t MAX_BATCHED_CORRIDORS = 512;
+
+std::size_t PathQueryBatch::CorridorKeyHash::operator()(CorridorKey const& key) const
+{
+    std::size_t hash = std::hash<dtPolyRef>()(key.StartPoly);
+    hash ^= std::hash<dtPolyRef>()(key.EndPoly) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<uint32>()((uint32(key.IncludeFlags) << 16) | key.ExcludeFlags) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+void PathQueryBatch::BeginUpdate()
+{
+    _corridors.clear();
+    _stats = Stats();
+    _elapsed = Microseconds::zero();
+    _budget = Microseconds(sWorld->getIntConfig(CONFIG_MMAP_PATH_BUDGET));
+    _shareCorridors = sWorld->getBoolConfig(CONFIG_MMAP_SHARE_PATHS);
+}
+
+dtStatus PathQueryBatch::FindPath(dtNavMeshQuery const* query, dtQueryFilter const* filter, dtPolyRef startPoly, dtPolyRef endPoly,
+    float const* startPos, float const* endPos, dtPolyRef* path, uint32* pathCount, uint32 maxPath)
+{
+    CorridorKey key{ startPoly, endPoly, filter->getIncludeFlags(), filter->getExcludeFlags() };
+
+    if (_shareCorridors)
+    {
+        auto itr = _corridors.find(key);
+        if (itr != _corridors.end() && itr->second.Polys.size() <= maxPath)
+        {
+            std::copy(itr->second.Polys.begin(), itr->second.Polys.end(), path);
+            *pathCount = uint32(itr->second.Polys.size());
+            ++_stats.Reused;
+            return itr->second.Status;
+        }
+    }
+
+    dtStatus status = query->findPath(startPoly, endPoly, startPos, endPos, filter, path, (int*)pathCount, maxPath);
+    ++_stats.Computed;
+
+    // suffix requests are cut short by the caller's prefix, they are not what others would get
+    if (_shareCorridors && maxPath == MAX_PATH_LENGTH && dtStatusSucceed(status) && *pathCount && _corridors.size() < MAX_BATCHED_CORRIDORS)
+        _corridors[key] = Corridor{ status, std::vector<dtPolyRef>(path, path + *pathCount) };
+
+    return status;
+}
+
+bool PathQueryBatch::DeferRecalculation()
+{
+    if (_budget == Microseconds::zero() || _elapsed < _budget)
+        return false;
+
+    ++_stats.Deferred;
+    return true;
+}
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PATH_QUERY_BATCH_H
+#define _PATH_QUERY_BATCH_H
+
+#include "Define.h"
+#include "DetourNavMeshQuery.h"
+#include "Duration.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Per map pathfinding state shared by all PathGenerators of one map update.
+ *
+ * Units chasing the same target usually end up asking detour for the very same
+ * poly corridor (same start poly, same end poly) within one tick. The batch keeps
+ * the corridors computed during the current update so those requests only pay for
+ * their own point path, and it tracks the time spent pathfinding so movement
+ * generators that already follow a path can postpone a refresh to the next tick
+ * once the configured budget is used up.
+ *
+ * Maps are updated by a single thread, so no locking is done here.
+ */
+class PathQueryBatch
+{
+public:
+    struct Stats
+    {
+        uint32 Computed = 0;    // corridors built by detour findPath
+        uint32 Reused = 0;      // corridors taken from the batch or from the generator's previous path
+        uint32 Deferred = 0;    // path refreshes postponed because the budget was used up
+    };
+
+    PathQueryBatch() = default;
+
+    // Starts a new map update: drops the corridors of the previous one, resets the budget and reloads the settings
+    void BeginUpdate();
+
+    // Forgets all stored corridors, e.g. after navmesh tiles were unloaded
+    void Clear() { _corridors.clear(); }
+
+    /**
+     * @brief Finds the poly corridor from startPoly to endPoly, reusing a corridor built earlier in this update when possible.
+     *
+     * Behaves like dtNavMeshQuery::findPath. Only full length requests are stored for reuse,
+     * requests with a shorter maxPath (path suffixes) may still be served from the batch.
+     */
+    dtStatus FindPath(dtNavMeshQuery const* query, dtQueryFilter const* filter, dtPolyRef startPoly, dtPolyRef endPoly,
+        float const* startPos, float const* endPos, dtPolyRef* path, uint32* pathCount, uint32 maxPath);
+
+    // Time spent by PathGenerator::CalculatePath, counted against the budget
+    void AddCalculationTime(Microseconds elapsed) { _elapsed += elapsed; }
+
+    // Counts a corridor that was cut from a generator's previous path instead of being built again
+    void AddReused() { ++_stats.Reused; }
+
+    /**
+     * @brief Asks whether a unit that still follows a valid path should keep it for now.
+     *
+     * Returns true (and counts the deferral) once the pathfinding budget of this update
+     * is used up. Callers must retry on a later update.
+     */
+    bool DeferRecalculation();
+
+    [[nodiscard]] Stats const& GetStats() const { return _stats; }
+
+private:
+    struct CorridorKey
+    {
+        dtPolyRef StartPoly;
+        dtPolyRef EndPoly;
+        uint16 IncludeFlags;
+        uint16 ExcludeFlags;
+
+        bool operator==(CorridorKey const& right) const
+        {
+            return StartPoly == right.StartPoly && EndPoly == right.EndPoly
+                && IncludeFlags == right.IncludeFlags && ExcludeFlags == right.ExcludeFlags;
+        }
+    };
+
+    struct CorridorKeyHash
+    {
+        std::size_t operator()(CorridorKey const& key) const;
+    };
+
+    struct Corridor
+    {
+        dtStatus Status;
+        std::vector<dtPolyRef> Polys;
+    };
+
+    std::unordered_map<CorridorKey, Corridor, CorridorKeyHash> _corridors;
+    Stats _stats;
+    Microseconds _elapsed = Microseconds::zero();
+    Microseconds _budget = Microseconds::zero();
+    bool _shareCorridors = false;
+};
+
+#endif
@@ -284,6 +284,13 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
                 return true;
             }
 
+            // the map used up its pathfinding time for this update, keep following the current path and retry next update
+            if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && !owner->movespline->Finalized() && owner->GetMap()->GetPathQueryBatch().DeferRecalculation())
+            {
+                _lastTargetPosition.reset();
+                return true;
+            }
+
             // figure out which way we want to move
             float x, y, z;
             target->GetPosition(x, y, z);
@@ -577,6 +584,10 @@ bool FollowMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     }
     else
     {
+        // the map used up its pathfinding time for this update, keep following the current path and retry next update
+        if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE) && !owner->movespline->Finalized() && owner->GetMap()->GetPathQueryBatch().DeferRecalculation())
+            return true;
+
         Position targetPosition = target->GetPosition();
         _lastTargetPosition = targetPosition;
 
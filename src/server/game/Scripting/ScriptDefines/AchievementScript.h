@@ -20,7 +20,6 @@
 
 #include "Duration.h"
 #include "ScriptObject.h"
-#include <list>
 #include <vector>
 
 enum AchievementHook
@@ -48,7 +47,7 @@ public:
 
     [[nodiscard]] virtual bool IsRealmCompleted(AchievementGlobalMgr const* /*globalmgr*/, AchievementEntry const* /*achievement*/, SystemTimePoint /*completionTime*/) { return true; }
 
-    virtual void OnBeforeCheckCriteria(AchievementMgr* /*mgr*/, std::list<AchievementCriteriaEntry const*> const* /*achievementCriteriaList*/) { }
+    virtual void OnBeforeCheckCriteria(AchievementMgr* /*mgr*/, std::vector<AchievementCriteriaEntry const*> const* /*achievementCriteriaList*/) { }
 
     [[nodiscard]] virtual bool CanCheckCriteria(AchievementMgr* /*mgr*/, AchievementCriteriaEntry const* /*achievementCriteria*/) { return true; }
 };
@@ -59,6 +59,12 @@ bool ScriptMgr::OnBeforeLootEqualChanced(Player const* player, LootStoreItemList
     CALL_ENABLED_BOOLEAN_HOOKS(GlobalScript, GLOBALHOOK_ON_BEFORE_LOOT_EQUAL_CHANCED, !script->OnBeforeLootEqualChanced(player, equalChanced, loot, store));
 }
 
+bool ScriptMgr::HasLootRollHooks() const
+{
+    return !ScriptRegistry<GlobalScript>::EnabledHooks[GLOBALHOOK_ON_ITEM_ROLL].empty()
+        || !ScriptRegistry<GlobalScript>::EnabledHooks[GLOBALHOOK_ON_BEFORE_LOOT_EQUAL_CHANCED].empty();
+}
+
 void ScriptMgr::OnInitializeLockedDungeons(Player* player, uint8& level, uint32& lockData, lfg::LFGDungeonData const* dungeon)
 {
     CALL_ENABLED_HOOKS(GlobalScript, GLOBALHOOK_ON_INITIALIZE_LOCKED_DUNGEONS, script->OnInitializeLockedDungeons(player, level, lockData, dungeon));
@@ -41,6 +41,7 @@
 #include "PacketUtilities.h"
 #include "Pet.h"
 #include "Player.h"
+#include "PlayerSaveScheduler.h"
 #include "QueryHolder.h"
 #include "ScriptMgr.h"
 #include "SocialMgr.h"
@@ -48,6 +49,7 @@
 #include "Tokenize.h"
 #include "Vehicle.h"
 #include "WardenWin.h"
+#include "WhoListCacheMgr.h"
 #include "World.h"
 #include "WorldGlobals.h"
 #include "WorldPacket.h"
@@ -254,6 +256,29 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if (!m_Socket)
         return;
 
+    if (!CanSendPacket(packet))
+        return;
+
+    m_Socket->SendPacket(*packet);
+}
+
+void WorldSession::SendSharedPacket(WorldPacket const* packet, std::shared_ptr<SharedWorldPacket>& sharedPacket)
+{
+    if (!m_Socket)
+        return;
+
+    if (!CanSendPacket(packet))
+        return;
+
+    if (!sharedPacket)
+        sharedPacket = std::make_shared<SharedWorldPacket>(*packet);
+
+    m_Socket->SendPacket(sharedPacket);
+}
+
+/// Updates the network statistics and asks the scripts whether the packet may be sent
+bool WorldSession::CanSendPacket(WorldPacket const* packet)
+{
 #if defined(ACORE_DEBUG)
     // Code for network use statistic
     static uint64 sendPacketCount = 0;
@@ -290,12 +315,79 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     }
 #endif                                                      // !ACORE_DEBUG
 
-    if (!sScriptMgr->CanPacketSend(this, *packet))
+    return sScriptMgr->CanPacketSend(this, *packet);
+}
+
+std::array<std::atomic<uint64>, MAX_MOVEMENT_INTEREST_TIERS> WorldSession::_movementRelayBytes = { };
+
+static Milliseconds GetMovementInterestInterval(MovementInterestTier tier)
+{
+    return Milliseconds(sWorld->getIntConfig(tier == MOVEMENT_INTEREST_TIER_FAR ? CONFIG_MOVEMENT_INTEREST_FAR_INTERVAL : CONFIG_MOVEMENT_INTEREST_MID_INTERVAL));
+}
+
+/// Sends the movement packet now if the tier interval for this mover elapsed, otherwise keeps it until the next flush
+void WorldSession::SendCoalescedMovement(WorldPacket const* packet, ObjectGuid moverGuid, MovementInterestTier tier)
+{
+    Milliseconds now = GameTime::GetGameTimeMS();
+    CoalescedMovement& movement = _coalescedMovement[moverGuid];
+    movement.Tier = tier;
+
+    if (now >= movement.NextSendTime)
     {
+        movement.Pending = false;
+        movement.NextSendTime = now + GetMovementInterestInterval(tier);
+        AddMovementRelayBytes(tier, packet->size());
+        SendPacket(packet);
         return;
     }
 
-    m_Socket->SendPacket(*packet);
+    // latest state wins
+    movement.Packet = *packet;
+    movement.Pending = true;
+}
+
+/// A newer movement packet of this mover was sent at full rate, the kept one is outdated
+void WorldSession::DiscardCoalescedMovement(ObjectGuid moverGuid)
+{
+    auto itr = _coalescedMovement.find(moverGuid);
+    if (itr != _coalescedMovement.end())
+        itr->second.Pending = false;
+}
+
+void WorldSession::FlushCoalescedMovement()
+{
+    if (_coalescedMovement.empty())
+        return;
+
+    Milliseconds now = GameTime::GetGameTimeMS();
+    std::array<uint64, MAX_MOVEMENT_INTEREST_TIERS> bytes = { };
+
+    for (auto itr = _coalescedMovement.begin(); itr != _coalescedMovement.end();)
+    {
+        CoalescedMovement& movement = itr->second;
+        if (now < movement.NextSendTime)
+        {
+            ++itr;
+            continue;
+        }
+
+        // nothing kept since the last send, or the mover left the visibility range meanwhile
+        if (!movement.Pending || !_player || !_player->HaveAtClient(itr->first))
+        {
+            itr = _coalescedMovement.erase(itr);
+            continue;
+        }
+
+        bytes[movement.Tier] += movement.Packet.size();
+        SendPacket(&movement.Packet);
+        movement.Pending = false;
+        movement.NextSendTime = now + GetMovementInterestInterval(movement.Tier);
+        ++itr;
+    }
+
+    for (uint8 tier = 0; tier < MAX_MOVEMENT_INTEREST_TIERS; ++tier)
+        if (bytes[tier])
+            AddMovementRelayBytes(MovementInterestTier(tier), bytes[tier]);
 }
 
 /// Add an incoming packet to the queue
@@ -757,6 +849,9 @@ void WorldSession::LogoutPlayer(bool save)
         LOG_INFO("entities.player", "Account: {} (IP: {}) Logout Character:[{}] ({}) Level: {}",
             GetAccountId(), GetRemoteAddress(), _player->GetName(), _player->GetGUID().ToString(), _player->GetLevel());
 
+        sWhoListCacheMgr->RemovePlayer(_player->GetGUID());
+        sPlayerSaveScheduler->Forget(_player->GetGUID());
+
         //! Remove the player from the world
         // the player may not be in the world when logging out
         // e.g if he got disconnected during a transfer to another map
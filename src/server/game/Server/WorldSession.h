@@ -32,8 +32,11 @@
 #include "Packet.h"
 #include "SharedDefines.h"
 #include "World.h"
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 
 class Creature;
@@ -49,6 +52,7 @@ class Quest;
 class SpellCastTargets;
 class Unit;
 class Warden;
+class SharedWorldPacket;
 class WorldPacket;
 class WorldSocket;
 class AsynchPetSummon;
@@ -270,6 +274,16 @@ enum CharterTypes
     ARENA_TEAM_CHARTER_5v5_TYPE                   = 5
 };
 
+// Distance tiers used to relay movement when Network.MovementInterest.Enabled is set
+enum MovementInterestTier : uint8
+{
+    MOVEMENT_INTEREST_TIER_NEAR                   = 0,  // every packet
+    MOVEMENT_INTEREST_TIER_MID                    = 1,  // coalesced, Network.MovementInterest.MidInterval
+    MOVEMENT_INTEREST_TIER_FAR                    = 2,  // coalesced, Network.MovementInterest.FarInterval
+
+    MAX_MOVEMENT_INTEREST_TIERS
+};
+
 //class to deal with packet processing
 //allows to determine if next packet is safe to be processed
 class PacketFilter
@@ -400,6 +414,15 @@ public:
     bool ProcessMovementInfo(MovementInfo& movementInfo, Unit* mover, Player* plrMover, WorldPacket& recvData);
 
     void SendPacket(WorldPacket const* packet);
+    // Sends a packet broadcast to several sessions, its body is copied to sharedPacket by the first one and shared by all their sockets
+    void SendSharedPacket(WorldPacket const* packet, std::shared_ptr<SharedWorldPacket>& sharedPacket);
+
+    // Movement interest management, movement of far away movers is sent at a reduced rate and only the latest state is kept
+    void SendCoalescedMovement(WorldPacket const* packet, ObjectGuid moverGuid, MovementInterestTier tier);
+    void DiscardCoalescedMovement(ObjectGuid moverGuid);
+    void FlushCoalescedMovement();
+    static void AddMovementRelayBytes(MovementInterestTier tier, uint64 bytes) { _movementRelayBytes[tier].fetch_add(bytes, std::memory_order_relaxed); }
+    static uint64 GetMovementRelayBytes(MovementInterestTier tier) { return _movementRelayBytes[tier].load(std::memory_order_relaxed); }
     void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName* declinedName);
     void SendPartyResult(PartyOperation operation, std::string const& member, PartyResult res, uint32 val = 0);
 
@@ -614,7 +637,7 @@ public:                                                 // opcodes handlers
     void HandleCharDeleteOpcode(WorldPacket& recvPacket);
     void HandleCharCreateOpcode(WorldPacket& recvPacket);
     void HandlePlayerLoginOpcode(WorldPacket& recvPacket);
-    void HandleCharEnum(PreparedQueryResult result);
+    void HandleCharEnum(uint32 cacheTicket, PreparedQueryResult result);
     void HandlePlayerLoginFromDB(LoginQueryHolder const& holder);
     void HandlePlayerLoginToCharInWorld(Player* pCurrChar);
     void HandlePlayerLoginToCharOutOfWorld(Player* pCurrChar);
@@ -1147,6 +1170,7 @@ public:                                                 // opcodes handlers
 
 private:
     void ProcessQueryCallbacks();
+    bool CanSendPacket(WorldPacket const* packet);
 
     QueryCallbackProcessor _queryProcessor;
     AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
@@ -1257,6 +1281,17 @@ private:
 
     uint32 _orderCounter;
 
+    struct CoalescedMovement
+    {
+        WorldPacket Packet;
+        Milliseconds NextSendTime = 0ms;
+        MovementInterestTier Tier = MOVEMENT_INTEREST_TIER_NEAR;
+        bool Pending = false;
+    };
+
+    std::unordered_map<ObjectGuid, CoalescedMovement> _coalescedMovement;
+    static std::array<std::atomic<uint64>, MAX_MOVEMENT_INTEREST_TIERS> _movementRelayBytes;
+
     WorldSession(WorldSession const& right) = delete;
     WorldSession& operator=(WorldSession const& right) = delete;
 };
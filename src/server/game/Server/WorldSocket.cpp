@@ -94,26 +94,50 @@ void compressBuff(void* dst, uint32* dst_size, void* src, int src_size)
     *dst_size = c_stream.total_out;
 }
 
-void EncryptableAndCompressiblePacket::CompressIfNeeded()
+bool EncryptableAndCompressiblePacket::Compress(WorldPacket const& packet, WorldPacket& compressed)
 {
-    if (!NeedsCompression())
-        return;
+    if (!NeedsCompression(packet))
+        return false;
 
-    uint32 pSize = size();
+    uint32 pSize = packet.size();
 
     uint32 destsize = compressBound(pSize);
     ByteBuffer buf(destsize + sizeof(uint32));
     buf.resize(destsize + sizeof(uint32));
 
     buf.put<uint32>(0, pSize);
-    compressBuff(const_cast<uint8*>(buf.contents()) + sizeof(uint32), &destsize, (void*)contents(), pSize);
+    compressBuff(const_cast<uint8*>(buf.contents()) + sizeof(uint32), &destsize, const_cast<uint8*>(packet.contents()), pSize);
     if (destsize == 0)
-        return;
+        return false;
 
     buf.resize(destsize + sizeof(uint32));
 
-    ByteBuffer::operator=(std::move(buf));
-    SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+    compressed.ByteBuffer::operator=(std::move(buf));
+    compressed.SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+    return true;
+}
+
+WorldPacket const& EncryptableAndCompressiblePacket::GetPacketToSend()
+{
+    if (_sharedPacket)
+        return _sharedPacket->GetPacketToSend();
+
+    WorldPacket compressed;
+    if (Compress(*this, compressed))
+        WorldPacket::operator=(std::move(compressed));
+
+    return *this;
+}
+
+WorldPacket const& SharedWorldPacket::GetPacketToSend()
+{
+    // sockets are updated by several network threads, only the first one compresses
+    std::call_once(_compressOnce, [this]()
+    {
+        _compressed = EncryptableAndCompressiblePacket::Compress(_packet, _compressedPacket);
+    });
+
+    return _compressed ? _compressedPacket : _packet;
 }
 
 WorldSocket::WorldSocket(tcp::socket&& socket)
@@ -171,12 +195,12 @@ bool WorldSocket::Update()
         std::size_t currentPacketSize;
         do
         {
-            queued->CompressIfNeeded();
-            ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+            WorldPacket const& packet = queued->GetPacketToSend();
+            ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
             if (queued->NeedsEncryption())
                 _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-            currentPacketSize = queued->size() + header.getHeaderLength();
+            currentPacketSize = packet.size() + header.getHeaderLength();
 
             if (buffer.GetRemainingSpace() < currentPacketSize)
             {
@@ -187,8 +211,8 @@ bool WorldSocket::Update()
             if (buffer.GetRemainingSpace() >= currentPacketSize)
             {
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
             else    // Single packet larger than current buffer size
             {
@@ -200,8 +224,8 @@ bool WorldSocket::Update()
                     _sendBufferSize = currentPacketSize;
 
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
 
             delete queued;
@@ -526,6 +550,17 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<SharedWorldPacket> const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+        sPacketLog->LogPacket(packet->GetPacket(), SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
+}
+
 void WorldSocket::HandleAuthSession(WorldPacket & recvPacket)
 {
     std::shared_ptr<AuthSession> authSession = std::make_shared<AuthSession>();
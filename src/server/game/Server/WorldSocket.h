@@ -26,9 +26,29 @@
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include <boost/asio/ip/tcp.hpp>
+#include <memory>
+#include <mutex>
 
 using boost::asio::ip::tcp;
 
+/// Packet body broadcast to several sockets, never modified after construction.
+/// Update packets are compressed once, by the first socket sending it.
+class SharedWorldPacket
+{
+public:
+    explicit SharedWorldPacket(WorldPacket const& packet) : _packet(packet), _compressed(false) { }
+
+    WorldPacket const& GetPacket() const { return _packet; }
+
+    WorldPacket const& GetPacketToSend();
+
+private:
+    WorldPacket _packet;
+    WorldPacket _compressedPacket;
+    bool _compressed;
+    std::once_flag _compressOnce;
+};
+
 class EncryptableAndCompressiblePacket : public WorldPacket
 {
 public:
@@ -37,15 +57,24 @@ public:
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    EncryptableAndCompressiblePacket(std::shared_ptr<SharedWorldPacket> packet, bool encrypt) : _sharedPacket(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
     bool NeedsEncryption() const { return _encrypt; }
 
-    bool NeedsCompression() const { return GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
+    static bool NeedsCompression(WorldPacket const& packet) { return packet.GetOpcode() == SMSG_UPDATE_OBJECT && packet.size() > 100; }
+
+    static bool Compress(WorldPacket const& packet, WorldPacket& compressed);
 
-    void CompressIfNeeded();
+    // Compresses unshared packets in place, shared ones are compressed only once for all sockets
+    WorldPacket const& GetPacketToSend();
 
     std::atomic<EncryptableAndCompressiblePacket*> SocketQueueLink;
 
 private:
+    std::shared_ptr<SharedWorldPacket> _sharedPacket;
     bool _encrypt;
 };
 
@@ -82,6 +111,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<SharedWorldPacket> const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
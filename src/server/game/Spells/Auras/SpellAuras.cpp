@@ -34,6 +34,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "WorldPacket.h"
+#include <limits>
 
 /// @todo: this import is not necessary for compilation and marked as unused by the IDE
 //  however, for some reasons removing it would cause a damn linking issue
@@ -350,7 +351,7 @@ Aura::Aura(SpellInfo const* spellproto, WorldObject* owner, Unit* caster, Item*
     m_castItemGuid(itemGUID ? itemGUID : castItem ? castItem->GetGUID() : ObjectGuid::Empty), m_castItemEntry(castItem ? castItem->GetEntry() : 0), m_applyTime(GameTime::GetGameTime().count()),
     m_owner(owner), m_timeCla(0), m_updateTargetMapInterval(0),
     m_casterLevel(caster ? caster->GetLevel() : m_spellInfo->SpellLevel), m_procCharges(0), m_stackAmount(1),
-    m_isRemoved(false), m_isSingleTarget(false), m_isUsingCharges(false), m_triggeredByAuraSpellInfo(nullptr)
+    m_isRemoved(false), m_isSingleTarget(false), m_isUsingCharges(false), m_triggeredByAuraSpellInfo(nullptr), m_procCandidateFlags(0)
 {
     if ((m_spellInfo->ManaPerSecond || m_spellInfo->ManaPerSecondPerLevel) && !m_spellInfo->HasAttribute(SPELL_ATTR2_NO_TARGET_PER_SECOND_COST))
         m_timeCla = 1 * IN_MILLISECONDS;
@@ -2294,6 +2295,27 @@ void Aura::LoadScripts()
         (*itr)->Register();
         ++itr;
     }
+
+    m_procCandidateFlags = CalcProcCandidateFlags();
+}
+
+uint32 Aura::CalcProcCandidateFlags() const
+{
+    // proc check hooks are called for every event, whatever the proc flags are
+    for (AuraScript* script : m_loadedScripts)
+        if (script->DoCheckProc.size() || script->DoAfterCheckProc.size())
+            return std::numeric_limits<uint32>::max();
+
+    // new proc system, see SpellMgr::CanSpellTriggerProcOnEvent
+    if (SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(GetId()))
+        return procEntry->ProcFlags;
+
+    // old proc system, see Unit::IsTriggeredAtSpellProcEvent
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr->GetSpellProcEvent(GetId());
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return m_spellInfo->ProcFlags;
 }
 
 bool Aura::CallScriptCheckAreaTargetHandlers(Unit* target)
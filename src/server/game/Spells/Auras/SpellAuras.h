@@ -204,6 +204,8 @@ public:
     bool IsProcTriggeredOnEvent(AuraApplication* aurApp, ProcEventInfo& eventInfo) const;
     float CalcProcChance(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo) const;
     void TriggerProcOnEvent(AuraApplication* aurApp, ProcEventInfo& eventInfo);
+    // proc flags this aura can react to (old and new proc system), 0 if it can never proc
+    uint32 GetProcCandidateFlags() const { return m_procCandidateFlags; }
 
     // AuraScript
     void LoadScripts();
@@ -245,6 +247,7 @@ public:
 
 private:
     void _DeleteRemovedApplications();
+    uint32 CalcProcCandidateFlags() const;
 
 protected:
     SpellInfo const* const m_spellInfo;
@@ -274,6 +277,7 @@ private:
     Unit::AuraApplicationList m_removedApplications;
 
     SpellInfo const* m_triggeredByAuraSpellInfo;
+    uint32 m_procCandidateFlags;                        // calculated once scripts are loaded
 };
 
 class UnitAura : public Aura
@@ -275,6 +275,8 @@ struct TargetInfo
     int32  damage;
 };
 
+typedef std::vector<TargetInfo> TargetInfoContainer;
+
 static const uint32 SPELL_INTERRUPT_NONPLAYER = 32747;
 
 struct TriggeredByAuraSpellData
@@ -299,6 +301,10 @@ public:
     Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, bool skipCheck = false);
     ~Spell();
 
+    // spells are short lived and created at a high rate, released memory is kept in a small per thread cache
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     void EffectNULL(SpellEffIndex effIndex);
     void EffectUnused(SpellEffIndex effIndex);
     void EffectDistract(SpellEffIndex effIndex);
@@ -596,7 +602,7 @@ public:
 
     // xinef: moved to public
     void LoadScripts();
-    std::list<TargetInfo>* GetUniqueTargetInfo() { return &m_UniqueTargetInfo; }
+    TargetInfoContainer* GetUniqueTargetInfo() { return &m_UniqueTargetInfo; }
 
     [[nodiscard]] uint32 GetTriggeredByAuraTickNumber() const { return m_triggeredByAuraSpell.tickNumber; }
 
@@ -694,7 +700,7 @@ public:
     // *****************************************
     // Spell target subsystem
     // *****************************************
-    std::list<TargetInfo> m_UniqueTargetInfo;
+    TargetInfoContainer m_UniqueTargetInfo;
     uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
 
     struct GOTargetInfo
@@ -704,14 +710,16 @@ public:
         uint8  effectMask: 8;
         bool   processed: 1;
     };
-    std::list<GOTargetInfo> m_UniqueGOTargetInfo;
+    typedef std::vector<GOTargetInfo> GOTargetInfoContainer;
+    GOTargetInfoContainer m_UniqueGOTargetInfo;
 
     struct ItemTargetInfo
     {
         Item*  item;
         uint8 effectMask;
     };
-    std::list<ItemTargetInfo> m_UniqueItemInfo;
+    typedef std::vector<ItemTargetInfo> ItemTargetInfoContainer;
+    ItemTargetInfoContainer m_UniqueItemInfo;
 
     SpellDestination m_destTargets[MAX_SPELL_EFFECTS];
 
@@ -33,6 +33,7 @@
 #include "Channel.h"
 #include "ChannelMgr.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterEnumCache.h"
 #include "Chat.h"
 #include "ChatPackets.h"
 #include "Common.h"
@@ -45,6 +46,7 @@
 #include "DatabaseEnv.h"
 #include "DisableMgr.h"
 #include "DynamicVisibility.h"
+#include "ExpiredMailMgr.h"
 #include "GameEventMgr.h"
 #include "GameGraveyard.h"
 #include "GameTime.h"
@@ -70,6 +72,7 @@
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
+#include "PlayerSaveScheduler.h"
 #include "PoolMgr.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
@@ -90,7 +93,6 @@
 #include "WardenCheckMgr.h"
 #include "WaypointMovementGenerator.h"
 #include "WeatherMgr.h"
-#include "WhoListCacheMgr.h"
 #include "WorldGlobals.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -291,6 +293,8 @@ void World::LoadConfigSettings(bool reload)
 
     VMAP::VMapFactory::createOrGetVMapMgr()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapMgr()->setEnableHeightCalc(enableHeight);
+    VMAP::VMapFactory::createOrGetVMapMgr()->SetQueryCacheSettings(sConfigMgr->GetOption<bool>("vmap.QueryCache.Enable", false),
+        sConfigMgr->GetOption<uint32>("vmap.QueryCache.Size", 4096));
     LOG_INFO("server.loading", "WORLD: VMap support included. LineOfSight:{}, getHeight:{}, indoorCheck:{} PetLOS:{}", enableLOS, enableHeight, enableIndoor, enablePetLOS);
 
     MMAP::MMapFactory::InitializeDisabledMaps();
@@ -833,7 +837,7 @@ void World::SetInitialWorldSettings()
     ///- Handle outdated emails (delete/return)
     LOG_INFO("server.loading", "Returning Old Mails...");
     LOG_INFO("server.loading", " ");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    sExpiredMailMgr->Start();
 
     ///- Load AutoBroadCast
     LOG_INFO("server.loading", "Loading Autobroadcasts...");
@@ -899,7 +903,6 @@ void World::SetInitialWorldSettings()
     // our speed up
     _timers[WUPDATE_5_SECS].SetInterval(5 * IN_MILLISECONDS);
 
-    _timers[WUPDATE_WHO_LIST].SetInterval(5 * IN_MILLISECONDS); // update who list cache every 5 seconds
 
     _mail_expire_check_timer = GameTime::GetGameTime() + 6h;
 
@@ -1123,14 +1126,6 @@ void World::Update(uint32 diff)
         CharacterDatabase.Execute(stmt);
     }
 
-    ///- Update Who List Cache
-    if (_timers[WUPDATE_WHO_LIST].Passed())
-    {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update who list"));
-        _timers[WUPDATE_WHO_LIST].Reset();
-        sWhoListCacheMgr->Update();
-    }
-
     {
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Check quest reset times"));
 
@@ -1179,10 +1174,20 @@ void World::Update(uint32 diff)
 
     if (currentGameTime > _mail_expire_check_timer)
     {
-        sObjectMgr->ReturnOrDeleteOldMails(true);
+        sExpiredMailMgr->Start();
         _mail_expire_check_timer = currentGameTime + 6h;
     }
 
+    {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update expired mails"));
+        sExpiredMailMgr->Update();
+    }
+
+    {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update guilds"));
+        sGuildMgr->Update(diff);
+    }
+
     {
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update sessions"));
         sWorldSessionMgr->UpdateSessions(diff);
@@ -1209,6 +1214,11 @@ void World::Update(uint32 diff)
         sLFGMgr->Update(diff, 0); // pussywizard: remove obsolete stuff before finding compatibility during map update
     }
 
+    {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update player save scheduler"));
+        sPlayerSaveScheduler->Update(diff); // grants are used by the map update below
+    }
+
     {
         ///- Update objects when the timer has passed (maps, transport, creatures, ...)
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update maps"));
@@ -1254,6 +1264,7 @@ void World::Update(uint32 diff)
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Process query callbacks"));
         // execute callbacks from sql queries that were queued recently
         ProcessQueryCallbacks();
+        sCharacterEnumCache->ProcessSaveCallbacks();
     }
 
     /// <li> Update uptime table
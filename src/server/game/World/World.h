@@ -65,7 +65,6 @@ enum WorldTimers
     WUPDATE_MAILBOXQUEUE,
     WUPDATE_PINGDB,
     WUPDATE_5_SECS,
-    WUPDATE_WHO_LIST,
     WUPDATE_COUNT
 };
 
@@ -161,8 +161,11 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_PRESERVE_CUSTOM_CHANNELS, "PreserveCustomChannels", false);
     SetConfigValue<uint32>(CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION, "PreserveCustomChannelDuration", 14);
     SetConfigValue<uint32>(CONFIG_INTERVAL_SAVE, "PlayerSaveInterval", 900000);
+    SetConfigValue<uint32>(CONFIG_LOGIN_QUERY_PARALLELISM, "CharacterDatabase.LoginQueryParallelism", 4);
+    SetConfigValue<uint32>(CONFIG_PLAYER_SAVE_MAX_PER_SECOND, "PlayerSave.MaxPerSecond", 0);
     SetConfigValue<uint32>(CONFIG_INTERVAL_DISCONNECT_TOLERANCE, "DisconnectToleranceInterval", 0);
     SetConfigValue<bool>(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
+    SetConfigValue<bool>(CONFIG_PLAYER_SAVE_DIFFERENTIAL, "PlayerSave.Differential", true);
     SetConfigValue<bool>(CONFIG_VALIDATE_SKILL_LEARNED_BY_SPELLS, "ValidateSkillLearnedBySpells", true);
 
     SetConfigValue<uint32>(CONFIG_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value < MAX_LEVEL; }, "< MAX_LEVEL");
@@ -294,6 +297,7 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_OBJECT_QUEST_MARKERS, "Visibility.ObjectQuestMarkers", true);
 
     SetConfigValue<uint32>(CONFIG_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
+    SetConfigValue<uint32>(CONFIG_EXPIRED_MAIL_BATCH_SIZE, "ExpiredMail.BatchSize", 500);
 
     SetConfigValue<uint32>(CONFIG_UPTIME_UPDATE, "UpdateUptimeInterval", 10, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value > 0; }, "> 0");
 
@@ -378,6 +382,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<uint32>(CONFIG_GUILD_BANK_TAB_COST_5, "Guild.BankTabCost5", 50000000);
 
     SetConfigValue<uint32>(CONFIG_GUILD_MEMBER_LIMIT, "Guild.MemberLimit", 0);
+    SetConfigValue<bool>(CONFIG_GUILD_LAZY_LOAD, "Guild.LazyLoad", false, ConfigValueCache::Reloadable::No);
+    SetConfigValue<uint32>(CONFIG_GUILD_IDLE_UNLOAD_TIME, "Guild.IdleUnloadTime", 3600);
 
     SetConfigValue<bool>(CONFIG_DETECT_POS_COLLISION, "DetectPosCollision", true);
 
@@ -478,6 +484,7 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<uint32>(CONFIG_CHARDELETE_METHOD, "CharDelete.Method", 0);
     SetConfigValue<uint32>(CONFIG_CHARDELETE_MIN_LEVEL, "CharDelete.MinLevel", 0);
     SetConfigValue<uint32>(CONFIG_CHARDELETE_KEEP_DAYS, "CharDelete.KeepDays", 30);
+    SetConfigValue<uint32>(CONFIG_CHAR_ENUM_CACHE_LIFETIME, "CharEnumCache.Lifetime", 300);
 
     ///- Load the ItemDelete related config options
     SetConfigValue<bool>(CONFIG_ITEMDELETE_METHOD, "ItemDelete.Method", 0);
@@ -543,6 +550,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_SHOW_MUTE_IN_WORLD, "ShowMuteInWorld", false);
     SetConfigValue<bool>(CONFIG_SHOW_BAN_IN_WORLD, "ShowBanInWorld", false);
     SetConfigValue<uint32>(CONFIG_NUMTHREADS, "MapUpdate.Threads", 1);
+    SetConfigValue<uint32>(CONFIG_GRID_TERRAIN_PREFETCH_THREADS, "MapTerrainPrefetch.Threads", 0, ConfigValueCache::Reloadable::No);
+    SetConfigValue<uint32>(CONFIG_GRID_TERRAIN_PREFETCH_LOOKAHEAD, "MapTerrainPrefetch.LookAhead", 10000);
     SetConfigValue<uint32>(CONFIG_MAX_RESULTS_LOOKUP_COMMANDS, "Command.LookupMaxResults", 0);
 
     // Warden
@@ -579,6 +588,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_PDUMP_NO_PATHS, "PlayerDump.DisallowPaths", true);
     SetConfigValue<bool>(CONFIG_PDUMP_NO_OVERWRITE, "PlayerDump.DisallowOverwrite", true);
     SetConfigValue<bool>(CONFIG_ENABLE_MMAPS, "MoveMaps.Enable", true);
+    SetConfigValue<bool>(CONFIG_MMAP_SHARE_PATHS, "MoveMaps.SharePaths", true);
+    SetConfigValue<uint32>(CONFIG_MMAP_PATH_BUDGET, "MoveMaps.PathBudget", 0);
 
     // Wintergrasp
     SetConfigValue<uint32>(CONFIG_WINTERGRASP_ENABLE, "Wintergrasp.Enable", 1);
@@ -664,6 +675,13 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_SPELL_QUEUE_ENABLED, "SpellQueue.Enabled", true);
     SetConfigValue<uint32>(CONFIG_SPELL_QUEUE_WINDOW, "SpellQueue.Window", 400);
 
+    // Movement interest management
+    SetConfigValue<bool>(CONFIG_MOVEMENT_INTEREST_ENABLED, "Network.MovementInterest.Enabled", false);
+    SetConfigValue<float>(CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE, "Network.MovementInterest.NearDistance", 50.0f);
+    SetConfigValue<float>(CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE, "Network.MovementInterest.FarDistance", 100.0f, ConfigValueCache::Reloadable::Yes, [this](float const& value) { return value >= GetConfigValue<float>(CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE); }, ">= Network.MovementInterest.NearDistance");
+    SetConfigValue<uint32>(CONFIG_MOVEMENT_INTEREST_MID_INTERVAL, "Network.MovementInterest.MidInterval", 500);
+    SetConfigValue<uint32>(CONFIG_MOVEMENT_INTEREST_FAR_INTERVAL, "Network.MovementInterest.FarInterval", 1000);
+
     // World State
     SetConfigValue<uint32>(CONFIG_SUNSREACH_COUNTER_MAX, "Sunsreach.CounterMax", 10000);
     SetConfigValue<uint32>(CONFIG_SCOURGEINVASION_COUNTER_FIRST, "ScourgeInvasion.CounterFirst", 50);
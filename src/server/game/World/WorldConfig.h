@@ -27,6 +27,7 @@ enum ServerConfigs
     CONFIG_ALLOW_PLAYER_COMMANDS,
     CONFIG_CLEAN_CHARACTER_DB,
     CONFIG_STATS_SAVE_ONLY_ON_LOGOUT,
+    CONFIG_PLAYER_SAVE_DIFFERENTIAL,
     CONFIG_ALLOW_TWO_SIDE_ACCOUNTS,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CALENDAR,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CHAT,
@@ -166,6 +167,8 @@ enum ServerConfigs
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
     CONFIG_INTERVAL_SAVE,
+    CONFIG_LOGIN_QUERY_PARALLELISM,
+    CONFIG_PLAYER_SAVE_MAX_PER_SECOND,
     CONFIG_PORT_WORLD,
     CONFIG_SOCKET_TIMEOUTTIME,
     CONFIG_SESSION_ADD_DELAY,
@@ -214,6 +217,7 @@ enum ServerConfigs
     CONFIG_START_GM_LEVEL,
     CONFIG_GROUP_VISIBILITY,
     CONFIG_MAIL_DELIVERY_DELAY,
+    CONFIG_EXPIRED_MAIL_BATCH_SIZE,
     CONFIG_UPTIME_UPDATE,
     CONFIG_SKILL_CHANCE_ORANGE,
     CONFIG_SKILL_CHANCE_YELLOW,
@@ -310,6 +314,7 @@ enum ServerConfigs
     CONFIG_CALENDAR_DELETE_OLD_EVENTS_HOUR,
     CONFIG_GUILD_RESET_HOUR,
     CONFIG_CHARDELETE_KEEP_DAYS,
+    CONFIG_CHAR_ENUM_CACHE_LIFETIME,
     CONFIG_CHARDELETE_METHOD,
     CONFIG_CHARDELETE_MIN_LEVEL,
     CONFIG_AUTOBROADCAST_CENTER,
@@ -367,6 +372,8 @@ enum ServerConfigs
     CONFIG_GUILD_BANK_TAB_COST_4,
     CONFIG_GUILD_BANK_TAB_COST_5,
     CONFIG_GUILD_MEMBER_LIMIT,
+    CONFIG_GUILD_LAZY_LOAD,
+    CONFIG_GUILD_IDLE_UNLOAD_TIME,
     CONFIG_GM_LEVEL_CHANNEL_MODERATION,
     CONFIG_TOGGLE_XP_COST,
     CONFIG_NPC_EVADE_IF_NOT_REACHABLE,
@@ -486,6 +493,15 @@ enum ServerConfigs
     RATE_MISS_CHANCE_MULTIPLIER_TARGET_PLAYER,
     CONFIG_NEW_CHAR_STRING,
     CONFIG_VALIDATE_SKILL_LEARNED_BY_SPELLS,
+    CONFIG_MOVEMENT_INTEREST_ENABLED,
+    CONFIG_MOVEMENT_INTEREST_NEAR_DISTANCE,
+    CONFIG_MOVEMENT_INTEREST_FAR_DISTANCE,
+    CONFIG_MOVEMENT_INTEREST_MID_INTERVAL,
+    CONFIG_MOVEMENT_INTEREST_FAR_INTERVAL,
+    CONFIG_GRID_TERRAIN_PREFETCH_THREADS,
+    CONFIG_GRID_TERRAIN_PREFETCH_LOOKAHEAD,
+    CONFIG_MMAP_SHARE_PATHS,
+    CONFIG_MMAP_PATH_BUDGET,
 
     MAX_NUM_SERVER_CONFIGS
 };
@@ -17,6 +17,7 @@
 
 #include "AccountMgr.h"
 #include "AchievementMgr.h"
+#include "CharacterEnumCache.h"
 #include "Chat.h"
 #include "CommandScript.h"
 #include "DBCStores.h"
@@ -414,7 +415,7 @@ public:
                 CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
                 stmt->SetData(0, uint16(AT_LOGIN_RENAME));
                 stmt->SetData(1, player->GetGUID().GetCounter());
-                CharacterDatabase.Execute(stmt);
+                sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(player->GetGUID()), nullptr, stmt);
             }
         }
 
@@ -469,7 +470,7 @@ public:
             CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
             stmt->SetData(0, static_cast<uint16>(AT_LOGIN_CUSTOMIZE));
             stmt->SetData(1, player->GetGUID().GetCounter());
-            CharacterDatabase.Execute(stmt);
+            sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(player->GetGUID()), nullptr, stmt);
         }
 
         return true;
@@ -493,7 +494,7 @@ public:
             CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
             stmt->SetData(0, uint16(AT_LOGIN_CHANGE_FACTION));
             stmt->SetData(1, player->GetGUID().GetCounter());
-            CharacterDatabase.Execute(stmt);
+            sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(player->GetGUID()), nullptr, stmt);
         }
 
         return true;
@@ -517,7 +518,7 @@ public:
             CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
             stmt->SetData(0, uint16(AT_LOGIN_CHANGE_RACE));
             stmt->SetData(1, player->GetGUID().GetCounter());
-            CharacterDatabase.Execute(stmt);
+            sCharacterEnumCache->ExecuteOrAppend(sCharacterCache->GetCharacterAccountIdByGuid(player->GetGUID()), nullptr, stmt);
         }
 
         return true;
@@ -72,7 +72,7 @@ public:
             return false;
         }
 
-        if (sGuildMgr->GetGuildByName(guildName))
+        if (sGuildMgr->HasGuildWithName(guildName))
         {
             handler->SendErrorMessage(LANG_GUILD_RENAME_ALREADY_EXISTS, guildName);
             return false;
@@ -198,7 +198,7 @@ public:
             return false;
         }
 
-        if (sGuildMgr->GetGuildByName(newGuildStr))
+        if (sGuildMgr->HasGuildWithName(newGuildStr))
         {
             handler->SendErrorMessage(LANG_GUILD_RENAME_ALREADY_EXISTS, newGuildStr);
             return false;
@@ -241,6 +241,10 @@ public:
         handler->PSendSysMessage("CharacterDatabase queue size: {}", CharacterDatabase.QueueSize());
         handler->PSendSysMessage("WorldDatabase queue size: {}", WorldDatabase.QueueSize());
 
+        if (sWorld->getBoolConfig(CONFIG_MOVEMENT_INTEREST_ENABLED))
+            handler->PSendSysMessage("Movement relay bytes (near, mid, far): {}, {}, {}", WorldSession::GetMovementRelayBytes(MOVEMENT_INTEREST_TIER_NEAR),
+                WorldSession::GetMovementRelayBytes(MOVEMENT_INTEREST_TIER_MID), WorldSession::GetMovementRelayBytes(MOVEMENT_INTEREST_TIER_FAR));
+
         if (Acore::Module::GetEnableModulesList().empty())
             handler->PSendSysMessage("No modules are enabled");
         else
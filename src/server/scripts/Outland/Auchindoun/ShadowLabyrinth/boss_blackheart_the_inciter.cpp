@@ -85,8 +85,8 @@ struct boss_blackheart_the_inciter : public BossAI
             DoCastAOE(SPELL_INCITE_CHAOS);
             DoCastSelf(SPELL_LAUGHTER, true);
             uint32 inciteTriggerID = NPC_INCITE_TRIGGER;
-            std::list<HostileReference*> t_list = me->GetThreatMgr().GetThreatList();
-            for (std::list<HostileReference*>::const_iterator itr = t_list.begin(); itr != t_list.end(); ++itr)
+            ThreatContainer::StorageType t_list = me->GetThreatMgr().GetThreatList();
+            for (ThreatContainer::StorageType::const_iterator itr = t_list.begin(); itr != t_list.end(); ++itr)
             {
                 Unit* target = ObjectAccessor::GetUnit(*me, (*itr)->getUnitGuid());
                 if (target && target->IsPlayer())
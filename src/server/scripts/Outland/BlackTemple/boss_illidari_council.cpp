@@ -629,7 +629,7 @@ class spell_illidari_council_empyreal_balance : public SpellScript
         }
 
         auto const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-        for (std::list<TargetInfo>::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+        for (TargetInfoContainer::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
             if (Creature* target = ObjectAccessor::GetCreature(*GetCaster(), ihit->targetGUID))
             {
                 target->SetMaxHealth(GetCaster()->GetMaxHealth() / _targetCount);
@@ -671,7 +671,7 @@ class spell_illidari_council_empyreal_equivalency : public SpellScript
             return;
 
         auto const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-        for (std::list<TargetInfo>::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+        for (TargetInfoContainer::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
             if (Creature* target = ObjectAccessor::GetCreature(*GetCaster(), ihit->targetGUID))
                 target->SetHealth(GetCaster()->GetHealth() / _targetCount);
     }
@@ -495,8 +495,8 @@ class spell_pet_gen_valkyr_guardian_smite : public SpellScript
     {
         if (GetHitUnit() != GetCaster())
         {
-            std::list<TargetInfo>* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-            for (std::list<TargetInfo>::iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+            TargetInfoContainer* targetsInfo = GetSpell()->GetUniqueTargetInfo();
+            for (TargetInfoContainer::iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
                 if (ihit->targetGUID == GetCaster()->GetGUID())
                     ihit->damage = -int32(GetHitDamage() * 0.25f);
         }
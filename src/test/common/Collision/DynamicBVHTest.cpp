@@ -0,0 +1,232 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DynamicBVH.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <set>
+
+using G3D::Vector3;
+
+namespace
+{
+    struct TestModel
+    {
+        G3D::AABox Bounds;
+    };
+
+    // collects every model whose box the ray enters within maxDist, like GameObjectModel::intersectRay does for its mesh
+    struct CollectCallback
+    {
+        std::set<TestModel const*> Hits;
+
+        bool operator()(G3D::Ray const& ray, TestModel const& model, float& maxDist, bool /*stopAtFirstHit*/)
+        {
+            float time = ray.intersectionTime(model.Bounds);
+            if (time > maxDist)
+                return false;
+
+            Hits.insert(&model);
+            return true;
+        }
+
+        void operator()(Vector3 const& point, TestModel const& model)
+        {
+            if (model.Bounds.contains(point))
+                Hits.insert(&model);
+        }
+    };
+
+    std::set<TestModel const*> BruteForceRay(std::vector<TestModel> const& models, std::vector<bool> const& inTree, G3D::Ray const& ray, float maxDist)
+    {
+        std::set<TestModel const*> hits;
+        for (std::size_t i = 0; i < models.size(); ++i)
+            if (inTree[i] && ray.intersectionTime(models[i].Bounds) <= maxDist)
+                hits.insert(&models[i]);
+        return hits;
+    }
+
+    G3D::AABox RandomBox(std::mt19937& rng, float worldSize, float maxSize)
+    {
+        std::uniform_real_distribution<float> coord(-worldSize, worldSize);
+        std::uniform_real_distribution<float> size(0.5f, maxSize);
+        Vector3 low(coord(rng), coord(rng), coord(rng) * 0.05f);
+        return G3D::AABox(low, low + Vector3(size(rng), size(rng), size(rng)));
+    }
+}
+
+template<> struct BoundsTrait<TestModel>
+{
+    static void GetBounds2(TestModel const* model, G3D::AABox& out) { out = model->Bounds; }
+};
+
+TEST(DynamicBVHTest, QueriesMatchBruteForce)
+{
+    std::mt19937 rng(1234);
+    std::vector<TestModel> models(500);
+    std::vector<bool> inTree(models.size(), false);
+    DynamicBVH<TestModel> tree;
+
+    std::uniform_int_distribution<std::size_t> pick(0, models.size() - 1);
+    std::uniform_real_distribution<float> shift(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> coord(-200.0f, 200.0f);
+
+    for (uint32 step = 0; step < 5000; ++step)
+    {
+        std::size_t i = pick(rng);
+        switch (step % 3)
+        {
+            case 0:
+                if (!inTree[i])
+                {
+                    models[i].Bounds = RandomBox(rng, 200.0f, 20.0f);
+                    tree.insert(models[i]);
+                    inTree[i] = true;
+                }
+                break;
+            case 1:
+                if (inTree[i])
+                {
+                    // small moves stay inside the leaf margin, large ones force a reinsert
+                    Vector3 offset = step % 2 ? Vector3(shift(rng), shift(rng), 0.0f) * 0.1f : Vector3(shift(rng), shift(rng), 0.0f) * 20.0f;
+                    models[i].Bounds = G3D::AABox(models[i].Bounds.low() + offset, models[i].Bounds.high() + offset);
+                    tree.move(models[i]);
+                }
+                break;
+            default:
+                if (step % 7 == 0 && inTree[i])
+                {
+                    tree.remove(models[i]);
+                    inTree[i] = false;
+                }
+                break;
+        }
+
+        if (step % 10)
+            continue;
+
+        Vector3 start(coord(rng), coord(rng), coord(rng) * 0.05f);
+        Vector3 end(coord(rng), coord(rng), coord(rng) * 0.05f);
+        float maxDist = (end - start).magnitude();
+        G3D::Ray ray = G3D::Ray::fromOriginAndDirection(start, (end - start) / maxDist);
+
+        CollectCallback callback;
+        float distance = maxDist;
+        tree.intersectRay(ray, callback, distance, false);
+        ASSERT_EQ(callback.Hits, BruteForceRay(models, inTree, ray, maxDist));
+
+        CollectCallback pointCallback;
+        tree.intersectPoint(start, pointCallback);
+        for (std::size_t m = 0; m < models.size(); ++m)
+            ASSERT_EQ(inTree[m] && models[m].Bounds.contains(start), pointCallback.Hits.count(&models[m]) != 0);
+    }
+
+    int count = 0;
+    for (bool member : inTree)
+        count += member;
+    EXPECT_EQ(count, tree.size());
+}
+
+TEST(DynamicBVHTest, StaysBalanced)
+{
+    // sorted inserts degenerate a naive tree into a list
+    std::vector<TestModel> models(4096);
+    DynamicBVH<TestModel> tree;
+    for (std::size_t i = 0; i < models.size(); ++i)
+    {
+        models[i].Bounds = G3D::AABox(Vector3(float(i) * 3.0f, 0.0f, 0.0f), Vector3(float(i) * 3.0f + 1.0f, 1.0f, 1.0f));
+        tree.insert(models[i]);
+    }
+
+    // 1.44 * log2(n) for an AVL tree
+    EXPECT_LE(tree.height(), 18);
+
+    tree.rebuild();
+    EXPECT_EQ(tree.height(), 12);
+    EXPECT_EQ(int(models.size()), tree.size());
+
+    for (TestModel const& model : models)
+        tree.remove(model);
+    EXPECT_EQ(0, tree.size());
+    EXPECT_EQ(0, tree.height());
+}
+
+TEST(DynamicBVHTest, VerticalRays)
+{
+    TestModel floor{ G3D::AABox(Vector3(0.0f, 0.0f, 0.0f), Vector3(10.0f, 10.0f, 1.0f)) };
+    TestModel roof{ G3D::AABox(Vector3(0.0f, 0.0f, 20.0f), Vector3(10.0f, 10.0f, 21.0f)) };
+    DynamicBVH<TestModel> tree;
+    tree.insert(floor);
+    tree.insert(roof);
+
+    // getHeight style ray straight down, axis parallel in x and y
+    G3D::Ray ray = G3D::Ray::fromOriginAndDirection(Vector3(5.0f, 5.0f, 10.0f), Vector3(0.0f, 0.0f, -1.0f));
+    CollectCallback callback;
+    float maxDist = 50.0f;
+    tree.intersectRay(ray, callback, maxDist, false);
+    EXPECT_EQ(1u, callback.Hits.size());
+    EXPECT_EQ(1u, callback.Hits.count(&floor));
+}
+
+// Wintergrasp sized workload: fortress walls and towers that stay put, siege vehicles moving every
+// update and a few hundred line of sight checks per update. The results are checked against a brute
+// force scan.
+TEST(DynamicBVHTest, MovingVehiclesMatchBruteForce)
+{
+    uint32 const staticModels = 300;
+    uint32 const vehicles = 40;
+    uint32 const updates = 20;
+    uint32 const queriesPerUpdate = 100;
+
+    std::mt19937 rng(2024);
+    std::vector<TestModel> models(staticModels + vehicles);
+    std::vector<bool> inTree(models.size(), true);
+    for (TestModel& model : models)
+        model.Bounds = RandomBox(rng, 800.0f, 30.0f);
+
+    DynamicBVH<TestModel> tree;
+    for (TestModel const& model : models)
+        tree.insert(model);
+    tree.rebuild();
+
+    std::uniform_real_distribution<float> step(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> coord(-800.0f, 800.0f);
+
+    for (uint32 update = 0; update < updates; ++update)
+    {
+        for (uint32 i = staticModels; i < models.size(); ++i)
+        {
+            Vector3 offset(step(rng), step(rng), 0.0f);
+            models[i].Bounds = G3D::AABox(models[i].Bounds.low() + offset, models[i].Bounds.high() + offset);
+            tree.move(models[i]);
+        }
+
+        for (uint32 q = 0; q < queriesPerUpdate; ++q)
+        {
+            // players fight close to each other, keep the segments short
+            Vector3 from(coord(rng), coord(rng), 5.0f);
+            Vector3 to = from + Vector3(step(rng), step(rng), 0.5f) * 10.0f;
+            float maxDist = (to - from).magnitude();
+            G3D::Ray ray = G3D::Ray::fromOriginAndDirection(from, (to - from) / maxDist);
+
+            CollectCallback callback;
+            float distance = maxDist;
+            tree.intersectRay(ray, callback, distance, false);
+            ASSERT_EQ(callback.Hits, BruteForceRay(models, inTree, ray, maxDist));
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldModel.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+
+using G3D::Vector3;
+using VMAP::MeshTriangle;
+
+namespace
+{
+    uint32 FloatBits(float value)
+    {
+        uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+// The batched kernel must report exactly the hits and distances of the scalar test
+TEST(TriangleIntersectionTest, BatchedMatchesScalar)
+{
+    std::mt19937 rng(4242);
+    std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+    std::uniform_int_distribution<uint32> countDist(1, 4);
+
+    std::vector<Vector3> vertices;
+    for (uint32 i = 0; i < 512; ++i)
+        vertices.emplace_back(coord(rng), coord(rng), coord(rng) * 0.1f);
+
+    // some degenerate triangles as well
+    std::uniform_int_distribution<uint32> vertexDist(0, uint32(vertices.size() - 1));
+    std::vector<MeshTriangle> triangles;
+    for (uint32 i = 0; i < 1024; ++i)
+    {
+        uint32 first = vertexDist(rng);
+        triangles.emplace_back(first, i % 17 ? vertexDist(rng) : first, vertexDist(rng));
+    }
+
+    std::uniform_int_distribution<uint32> triangleDist(0, uint32(triangles.size() - 1));
+    uint32 hits = 0;
+
+    for (uint32 test = 0; test < 20000; ++test)
+    {
+        Vector3 origin(coord(rng), coord(rng), coord(rng));
+        Vector3 direction = test % 5 ? Vector3(coord(rng), coord(rng), coord(rng)).direction() : Vector3(0.0f, 0.0f, -1.0f);
+        G3D::Ray ray = G3D::Ray::fromOriginAndDirection(origin, direction);
+
+        std::array<uint32, 4> entries;
+        for (uint32& entry : entries)
+            entry = triangleDist(rng);
+
+        uint32 count = countDist(rng);
+        std::array<float, 4> distances;
+        uint32 mask = VMAP::IntersectTriangles(triangles.begin(), entries.data(), count, vertices.begin(), ray, distances);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float distance = G3D::finf();
+            bool hit = VMAP::IntersectTriangle(triangles[entries[i]], vertices.begin(), ray, distance);
+            ASSERT_EQ(hit, ((mask >> i) & 1) != 0 && distances[i] < G3D::finf());
+            if (hit)
+            {
+                ASSERT_EQ(FloatBits(distance), FloatBits(distances[i]));
+                ++hits;
+            }
+        }
+
+        ASSERT_EQ(mask >> count, 0u);
+    }
+
+    EXPECT_GT(hits, 0u);
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "VMapQueryCache.h"
+#include "gtest/gtest.h"
+
+using VMAP::VMapQueryCache;
+
+TEST(VMapQueryCacheTest, OnlyExactPositionsShareResults)
+{
+    VMapQueryCache cache;
+    cache.Configure(16);
+
+    cache.Store(VMapQueryCache::MakeLineOfSightKey(571, 100.1f, 200.1f, 10.1f, 120.0f, 210.0f, 12.0f, 0), 1, 1.0f);
+    cache.Store(VMapQueryCache::MakeHeightKey(571, 100.1f, 200.1f, 10.1f, 50.0f), 1, 8.0f);
+
+    float result = 0.0f;
+    EXPECT_TRUE(cache.Find(VMapQueryCache::MakeLineOfSightKey(571, 100.1f, 200.1f, 10.1f, 120.0f, 210.0f, 12.0f, 0), 1, result));
+    EXPECT_EQ(result, 1.0f);
+    EXPECT_TRUE(cache.Find(VMapQueryCache::MakeHeightKey(571, 100.1f, 200.1f, 10.1f, 50.0f), 1, result));
+    EXPECT_EQ(result, 8.0f);
+
+    // other map, ignore flags or query type
+    EXPECT_FALSE(cache.Find(VMapQueryCache::MakeLineOfSightKey(0, 100.1f, 200.1f, 10.1f, 120.0f, 210.0f, 12.0f, 0), 1, result));
+    EXPECT_FALSE(cache.Find(VMapQueryCache::MakeLineOfSightKey(571, 100.1f, 200.1f, 10.1f, 120.0f, 210.0f, 12.0f, 1), 1, result));
+    EXPECT_FALSE(cache.Find(VMapQueryCache::MakeHeightKey(571, 100.1f, 200.1f, 10.1f, 120.0f), 1, result));
+
+    // a position next to a ledge or wall edge may have another answer
+    EXPECT_FALSE(cache.Find(VMapQueryCache::MakeLineOfSightKey(571, 100.1f, 200.1f, 10.1f, 120.0f, 210.0f, 12.01f, 0), 1, result));
+    EXPECT_FALSE(cache.Find(VMapQueryCache::MakeLineOfSightKey(571, 100.12f, 200.1f, 10.1f, 120.0f, 210.0f, 12.0f, 0), 1, result));
+    EXPECT_FALSE(cache.Find(VMapQueryCache::MakeHeightKey(571, 100.1f, 200.1f, 10.12f, 50.0f), 1, result));
+    EXPECT_FALSE(cache.Find(VMapQueryCache::MakeHeightKey(571, 100.1f, 200.11f, 10.1f, 50.0f), 1, result));
+}
+
+TEST(VMapQueryCacheTest, GenerationChangeInvalidates)
+{
+    VMapQueryCache cache;
+    cache.Configure(16);
+
+    VMapQueryCache::Key key = VMapQueryCache::MakeHeightKey(0, -8949.95f, -132.49f, 83.53f, 50.0f);
+    cache.Store(key, 7, 82.0f);
+
+    float result = 0.0f;
+    EXPECT_FALSE(cache.Find(key, 8, result));
+
+    cache.Store(key, 8, 81.5f);
+    EXPECT_TRUE(cache.Find(key, 8, result));
+    EXPECT_EQ(result, 81.5f);
+    EXPECT_EQ(cache.GetSize(), 1u);
+}
+
+TEST(VMapQueryCacheTest, EvictsLeastRecentlyUsed)
+{
+    VMapQueryCache cache;
+    cache.Configure(2);
+
+    VMapQueryCache::Key first = VMapQueryCache::MakeHeightKey(0, 1.0f, 1.0f, 1.0f, 10.0f);
+    VMapQueryCache::Key second = VMapQueryCache::MakeHeightKey(0, 2.0f, 2.0f, 2.0f, 10.0f);
+    VMapQueryCache::Key third = VMapQueryCache::MakeHeightKey(0, 3.0f, 3.0f, 3.0f, 10.0f);
+
+    cache.Store(first, 0, 1.0f);
+    cache.Store(second, 0, 2.0f);
+
+    float result = 0.0f;
+    EXPECT_TRUE(cache.Find(first, 0, result));
+
+    cache.Store(third, 0, 3.0f);
+    EXPECT_EQ(cache.GetSize(), 2u);
+    EXPECT_TRUE(cache.Find(first, 0, result));
+    EXPECT_FALSE(cache.Find(second, 0, result));
+    EXPECT_TRUE(cache.Find(third, 0, result));
+}
+
+TEST(VMapQueryCacheTest, ConfigureDropsEntries)
+{
+    VMapQueryCache cache;
+    cache.Configure(4);
+    cache.Store(VMapQueryCache::MakeHeightKey(0, 1.0f, 1.0f, 1.0f, 10.0f), 0, 1.0f);
+
+    cache.Configure(4);
+    EXPECT_EQ(cache.GetSize(), 1u);
+
+    cache.Configure(8);
+    EXPECT_EQ(cache.GetSize(), 0u);
+}
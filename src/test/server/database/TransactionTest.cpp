@@ -0,0 +1,90 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MySQLConnection.h"
+#include "PreparedStatement.h"
+#include "Transaction.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    using TestStatement = PreparedStatement<MySQLConnection>;
+    using TestTransaction = Transaction<MySQLConnection>;
+
+    TestStatement* MakeStatement(uint32 index, uint32 guid, std::string const& name)
+    {
+        TestStatement* stmt = new TestStatement(index, 2);
+        stmt->SetData(0, guid);
+        stmt->SetData(1, name);
+        return stmt;
+    }
+}
+
+TEST(TransactionTest, DigestDependsOnStatementsAndValues)
+{
+    TestTransaction first;
+    first.Append(MakeStatement(1, 42, "aura"));
+    first.Append("DELETE FROM t WHERE guid = 42");
+
+    TestTransaction same;
+    same.Append(MakeStatement(1, 42, "aura"));
+    same.Append("DELETE FROM t WHERE guid = 42");
+
+    TestTransaction otherValue;
+    otherValue.Append(MakeStatement(1, 43, "aura"));
+    otherValue.Append("DELETE FROM t WHERE guid = 42");
+
+    TestTransaction otherIndex;
+    otherIndex.Append(MakeStatement(2, 42, "aura"));
+    otherIndex.Append("DELETE FROM t WHERE guid = 42");
+
+    EXPECT_EQ(first.GetDigest(), same.GetDigest());
+    EXPECT_NE(first.GetDigest(), otherValue.GetDigest());
+    EXPECT_NE(first.GetDigest(), otherIndex.GetDigest());
+}
+
+TEST(TransactionTest, DigestAndPayloadStartAtIndex)
+{
+    TestTransaction trans;
+    trans.Append("UPDATE characters SET online = 1");
+    std::size_t const first = trans.GetSize();
+    trans.Append(MakeStatement(1, 42, "aura"));
+
+    TestTransaction tail;
+    tail.Append(MakeStatement(1, 42, "aura"));
+
+    EXPECT_EQ(trans.GetDigest(first), tail.GetDigest());
+
+    // uint32 guid plus the four characters of the name
+    EXPECT_EQ(tail.GetPayloadSize(), sizeof(uint32) + 4);
+    EXPECT_EQ(trans.GetPayloadSize(), std::string("UPDATE characters SET online = 1").size() + sizeof(uint32) + 4);
+}
+
+TEST(TransactionTest, TruncateDropsTail)
+{
+    TestTransaction trans;
+    trans.Append("UPDATE characters SET online = 1");
+    uint64 const digest = trans.GetDigest();
+
+    trans.Append(MakeStatement(1, 42, "aura"));
+    trans.Append("DELETE FROM t WHERE guid = 42");
+    EXPECT_EQ(trans.GetSize(), 3u);
+
+    trans.Truncate(1);
+    EXPECT_EQ(trans.GetSize(), 1u);
+    EXPECT_EQ(trans.GetDigest(), digest);
+}
@@ -0,0 +1,157 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AchievementCriteriaIndex.h"
+#include "DBCStructure.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    AchievementCriteriaEntry MakeCriteria(uint32 id, uint32 achievementId, AchievementCriteriaTypes type, uint32 asset)
+    {
+        AchievementCriteriaEntry criteria{};
+        criteria.ID = id;
+        criteria.referredAchievement = achievementId;
+        criteria.requiredType = type;
+        criteria.kill_creature.creatureID = asset;
+        criteria.kill_creature.creatureCount = 1;
+        return criteria;
+    }
+}
+
+TEST(AchievementCriteriaIndexTest, FindsCriteriaByTypeAndAsset)
+{
+    std::vector<AchievementCriteriaEntry> entries =
+    {
+        MakeCriteria(1, 10, ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100),
+        MakeCriteria(2, 11, ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100),
+        MakeCriteria(3, 12, ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 200),
+        MakeCriteria(4, 13, ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST, 100),
+    };
+
+    AchievementCriteriaIndex index;
+    for (AchievementCriteriaEntry const& entry : entries)
+        index.Add(entry.requiredType, entry.kill_creature.creatureID, &entry);
+
+    AchievementCriteriaEntryList const* kills = index.Find(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100);
+    ASSERT_NE(kills, nullptr);
+    ASSERT_EQ(kills->size(), 2u);
+    EXPECT_EQ((*kills)[0]->ID, 1u);
+    EXPECT_EQ((*kills)[1]->ID, 2u);
+
+    AchievementCriteriaEntryList const* quests = index.Find(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST, 100);
+    ASSERT_NE(quests, nullptr);
+    EXPECT_EQ(quests->front()->ID, 4u);
+
+    EXPECT_EQ(index.Find(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST, 200), nullptr);
+    EXPECT_EQ(index.Find(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 300), nullptr);
+    EXPECT_EQ(index.GetAssetCount(), 3u);
+}
+
+TEST(AchievementCriteriaIndexTest, AddsCriteriaUnderPrimaryAsset)
+{
+    AchievementCriteriaEntry kill = MakeCriteria(1, 10, ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100);
+
+    AchievementCriteriaEntry quest{};
+    quest.ID = 2;
+    quest.requiredType = ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST;
+    quest.complete_quest.questID = 500;
+
+    AchievementCriteriaEntry equipEpic{};
+    equipEpic.ID = 3;
+    equipEpic.requiredType = ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM;
+    equipEpic.equip_epic_item.itemSlot = 4;
+
+    // looked up by type only
+    AchievementCriteriaEntry level{};
+    level.ID = 4;
+    level.requiredType = ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL;
+
+    // indexed under the areas of its overlay by the caller
+    AchievementCriteriaEntry explore{};
+    explore.ID = 5;
+    explore.requiredType = ACHIEVEMENT_CRITERIA_TYPE_EXPLORE_AREA;
+
+    AchievementCriteriaIndex index;
+    EXPECT_TRUE(index.Add(&kill));
+    EXPECT_TRUE(index.Add(&quest));
+    EXPECT_TRUE(index.Add(&equipEpic));
+    EXPECT_FALSE(index.Add(&level));
+    EXPECT_FALSE(index.Add(&explore));
+    EXPECT_EQ(index.GetAssetCount(), 3u);
+
+    ASSERT_NE(index.Find(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100), nullptr);
+    EXPECT_EQ(index.Find(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100)->front(), &kill);
+    ASSERT_NE(index.Find(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST, 500), nullptr);
+    EXPECT_EQ(index.Find(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST, 500)->front(), &quest);
+    ASSERT_NE(index.Find(ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM, 4), nullptr);
+    EXPECT_EQ(index.Find(ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM, 4)->front(), &equipEpic);
+    EXPECT_EQ(index.Find(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL, 0), nullptr);
+}
+
+TEST(AchievementCriteriaIndexTest, FinishedCriteriaAreSkipped)
+{
+    std::vector<AchievementCriteriaEntry> entries =
+    {
+        MakeCriteria(1, 10, ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100),
+        MakeCriteria(2, 11, ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100),
+        MakeCriteria(3, 12, ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100),
+    };
+
+    AchievementCriteriaIndex index;
+    for (AchievementCriteriaEntry const& entry : entries)
+        index.Add(&entry);
+
+    AchievementFinishedCriteria finished;
+    EXPECT_FALSE(finished.Contains(2));
+    finished.Insert(2, 4);
+    EXPECT_TRUE(finished.Contains(2));
+    EXPECT_FALSE(finished.Contains(1));
+    EXPECT_FALSE(finished.Contains(3));
+    EXPECT_FALSE(finished.Contains(1000));
+
+    // ids beyond the expected count still fit
+    finished.Insert(1000, 4);
+    EXPECT_TRUE(finished.Contains(1000));
+
+    // what UpdateAchievementCriteria goes on to check for a kill of creature 100
+    std::vector<uint32> updated;
+    for (AchievementCriteriaEntry const* criteria : *index.Find(ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE, 100))
+        if (!finished.Contains(criteria->ID))
+            updated.push_back(criteria->ID);
+
+    EXPECT_EQ(updated, std::vector<uint32>({ 1, 3 }));
+
+    finished.Clear();
+    EXPECT_FALSE(finished.Contains(2));
+    EXPECT_FALSE(finished.Contains(1000));
+}
+
+TEST(AchievementCriteriaIndexTest, RealmFirstsAreNeverFinished)
+{
+    AchievementEntry achievement{};
+    EXPECT_TRUE(AchievementFinishedCriteria::CanBeFinished(&achievement));
+
+    achievement.flags = ACHIEVEMENT_FLAG_REALM_FIRST_KILL;
+    EXPECT_FALSE(AchievementFinishedCriteria::CanBeFinished(&achievement));
+
+    achievement.flags = ACHIEVEMENT_FLAG_REALM_FIRST_REACH;
+    EXPECT_FALSE(AchievementFinishedCriteria::CanBeFinished(&achievement));
+
+    achievement.flags = ACHIEVEMENT_FLAG_SUMM;
+    EXPECT_TRUE(AchievementFinishedCriteria::CanBeFinished(&achievement));
+}
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BattlegroundQueue.h"
+#include "gtest/gtest.h"
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    typedef BattlegroundQueue::RatedArenaIndex RatedArenaIndex;
+
+    // Reference implementation: the linear list scan previously done by BattlegroundQueue::BattlegroundQueueUpdate
+    GroupQueueInfo* LinearFindFirst(std::list<GroupQueueInfo*> const& queue, uint32 minRating, uint32 maxRating, int32 discardTime,
+        GroupQueueInfo const* from = nullptr, RatedArenaIndex::MatchPredicate const& predicate = nullptr)
+    {
+        auto itr = queue.begin();
+        if (from)
+            while (itr != queue.end() && *itr != from)
+                ++itr;
+
+        for (; itr != queue.end(); ++itr)
+        {
+            GroupQueueInfo* ginfo = *itr;
+            if (!ginfo->IsInvitedToBGInstanceGUID
+                && ((ginfo->ArenaMatchmakerRating >= minRating && ginfo->ArenaMatchmakerRating <= maxRating) || (int32)ginfo->JoinTime < discardTime)
+                && (!predicate || predicate(ginfo)))
+                return ginfo;
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<GroupQueueInfo> MakeGroup(uint32 arenaTeamId, uint32 matchmakerRating, uint32 joinTime, uint32 previousOpponents = 0)
+    {
+        auto ginfo = std::make_unique<GroupQueueInfo>();
+        ginfo->IsRated = true;
+        ginfo->ArenaType = 2;
+        ginfo->ArenaTeamId = arenaTeamId;
+        ginfo->ArenaMatchmakerRating = matchmakerRating;
+        ginfo->JoinTime = joinTime;
+        ginfo->IsInvitedToBGInstanceGUID = 0;
+        ginfo->PreviousOpponentsTeamId = previousOpponents;
+        return ginfo;
+    }
+}
+
+TEST(BattlegroundQueueRatedArenaIndexTest, EmptyIndex)
+{
+    RatedArenaIndex index;
+    EXPECT_EQ(index.FindFirst(0, 5000, 0), nullptr);
+    EXPECT_EQ(index.Size(), 0u);
+}
+
+TEST(BattlegroundQueueRatedArenaIndexTest, PrefersEarliestGroupInRatingWindow)
+{
+    RatedArenaIndex index;
+    auto high = MakeGroup(1, 2400, 100);
+    auto low = MakeGroup(2, 1500, 200);
+    auto mid = MakeGroup(3, 1550, 300);
+
+    index.Insert(high.get());
+    index.Insert(low.get());
+    index.Insert(mid.get());
+
+    EXPECT_EQ(index.FindFirst(1400, 1600, 0), low.get());
+    EXPECT_EQ(index.FindFirst(1400, 1600, 0, low.get(), [&](GroupQueueInfo const* ginfo) { return ginfo->ArenaTeamId != low->ArenaTeamId; }), mid.get());
+
+    // the rating of 'high' is discarded after waiting long enough
+    EXPECT_EQ(index.FindFirst(1400, 1600, 150), high.get());
+}
+
+TEST(BattlegroundQueueRatedArenaIndexTest, InvitedAndRemovedGroupsAreSkipped)
+{
+    RatedArenaIndex index;
+    auto first = MakeGroup(1, 1500, 100);
+    auto second = MakeGroup(2, 1500, 200);
+
+    index.Insert(first.get());
+    index.Insert(second.get());
+
+    first->IsInvitedToBGInstanceGUID = 1;
+    EXPECT_EQ(index.FindFirst(1000, 2000, 0), second.get());
+
+    index.Remove(second.get());
+    EXPECT_FALSE(index.Contains(second.get()));
+    EXPECT_EQ(index.FindFirst(1000, 2000, 0), nullptr);
+}
+
+// Deterministic queue simulation: random joins, leaves and matches must pick exactly the same teams as the linear scan
+TEST(BattlegroundQueueRatedArenaIndexTest, MatchesLinearScanInSimulation)
+{
+    std::mt19937 rng(20240612);
+    std::uniform_int_distribution<uint32> ratingDist(0, 3000);
+    std::uniform_int_distribution<uint32> actionDist(0, 99);
+    std::uniform_int_distribution<uint32> teamDist(1, 64);
+
+    RatedArenaIndex index;
+    std::list<GroupQueueInfo*> queue;
+    std::vector<std::unique_ptr<GroupQueueInfo>> storage;
+
+    uint32 now = 1000;
+    uint32 nextInstance = 1;
+    uint32 matches = 0;
+
+    for (uint32 step = 0; step < 20000; ++step)
+    {
+        now += std::uniform_int_distribution<uint32>(0, 50)(rng);
+        uint32 action = actionDist(rng);
+
+        if (action < 45 || queue.empty())
+        {
+            storage.push_back(MakeGroup(teamDist(rng), ratingDist(rng), now, teamDist(rng)));
+            queue.push_back(storage.back().get());
+            index.Insert(storage.back().get());
+        }
+        else if (action < 65)
+        {
+            auto itr = queue.begin();
+            std::advance(itr, std::uniform_int_distribution<std::size_t>(0, queue.size() - 1)(rng));
+            index.Remove(*itr);
+            queue.erase(itr);
+        }
+        else
+        {
+            uint32 arenaRating = ratingDist(rng);
+            uint32 maxDifference = 150;
+            uint32 arenaMinRating = arenaRating <= maxDifference ? 0 : arenaRating - maxDifference;
+            uint32 arenaMaxRating = arenaRating + maxDifference;
+            int32 discardTime = int32(now) - 60000;
+            int32 discardOpponentsTime = int32(now) - 30000;
+
+            GroupQueueInfo* first = index.FindFirst(arenaMinRating, arenaMaxRating, discardTime);
+            ASSERT_EQ(first, LinearFindFirst(queue, arenaMinRating, arenaMaxRating, discardTime));
+            if (!first)
+                continue;
+
+            auto CanFaceFirstTeam = [first, discardOpponentsTime](GroupQueueInfo const* ginfo)
+            {
+                return (first->ArenaTeamId != ginfo->PreviousOpponentsTeamId || (int32)ginfo->JoinTime < discardOpponentsTime)
+                    && first->ArenaTeamId != ginfo->ArenaTeamId;
+            };
+
+            GroupQueueInfo* second = index.FindFirst(arenaMinRating, arenaMaxRating, discardTime, first, CanFaceFirstTeam);
+            ASSERT_EQ(second, LinearFindFirst(queue, arenaMinRating, arenaMaxRating, discardTime, first, CanFaceFirstTeam));
+            if (!second)
+                continue;
+
+            // invited groups stay in the queue until their players enter, but leave the index
+            first->IsInvitedToBGInstanceGUID = nextInstance;
+            second->IsInvitedToBGInstanceGUID = nextInstance++;
+            index.Remove(first);
+            index.Remove(second);
+            ++matches;
+        }
+    }
+
+    EXPECT_GT(matches, 0u);
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterEnumCache.h"
+#include "DatabaseEnv.h"
+#include "WorldMock.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace testing;
+
+namespace
+{
+    class CharacterEnumCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            originalWorld = sWorld.release();
+            worldMock = new NiceMock<WorldMock>();
+            sWorld.reset(worldMock);
+
+            ON_CALL(*worldMock, getIntConfig(_)).WillByDefault(Return(0));
+            ON_CALL(*worldMock, getIntConfig(CONFIG_CHAR_ENUM_CACHE_LIFETIME)).WillByDefault(Return(300));
+
+            packet = { 2, 10, 20, 30 };
+            characters = { ObjectGuid::Create<HighGuid::Player>(1), ObjectGuid::Create<HighGuid::Player>(2) };
+
+            uint64 hits, misses;
+            sCharacterEnumCache->GetStats(hits, misses);
+        }
+
+        void TearDown() override
+        {
+            // the cache is a singleton, leave it empty for the next test
+            sCharacterEnumCache->Clear();
+
+            IWorld* currentWorld = sWorld.release();
+            delete currentWorld;
+            worldMock = nullptr;
+
+            sWorld.reset(originalWorld);
+            originalWorld = nullptr;
+        }
+
+        IWorld* originalWorld = nullptr;
+        NiceMock<WorldMock>* worldMock = nullptr;
+        std::vector<uint8> packet;
+        GuidSet characters;
+    };
+}
+
+TEST_F(CharacterEnumCacheTest, StoredEnumIsReturned)
+{
+    std::vector<uint8> cachedPacket;
+    GuidSet cachedCharacters;
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+
+    uint32 ticket = sCharacterEnumCache->BeginQuery(1);
+    EXPECT_NE(ticket, 0u);
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+
+    sCharacterEnumCache->Store(1, ticket, packet.data(), packet.size(), characters);
+    ASSERT_TRUE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+    EXPECT_EQ(cachedPacket, packet);
+    EXPECT_EQ(cachedCharacters, characters);
+
+    EXPECT_FALSE(sCharacterEnumCache->Get(2, cachedPacket, cachedCharacters));
+
+    uint64 hits, misses;
+    sCharacterEnumCache->GetStats(hits, misses);
+    EXPECT_EQ(hits, 1u);
+    EXPECT_EQ(misses, 3u);
+}
+
+TEST_F(CharacterEnumCacheTest, InvalidationDropsEnum)
+{
+    sCharacterEnumCache->Store(1, sCharacterEnumCache->BeginQuery(1), packet.data(), packet.size(), characters);
+    sCharacterEnumCache->InvalidateAccount(1);
+
+    std::vector<uint8> cachedPacket;
+    GuidSet cachedCharacters;
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+}
+
+TEST_F(CharacterEnumCacheTest, InvalidationDuringQueryDiscardsResult)
+{
+    uint32 ticket = sCharacterEnumCache->BeginQuery(1);
+    sCharacterEnumCache->InvalidateAccount(1);
+    sCharacterEnumCache->Store(1, ticket, packet.data(), packet.size(), characters);
+
+    std::vector<uint8> cachedPacket;
+    GuidSet cachedCharacters;
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+
+    // only the result of the latest query is kept
+    uint32 oldTicket = sCharacterEnumCache->BeginQuery(1);
+    uint32 newTicket = sCharacterEnumCache->BeginQuery(1);
+    sCharacterEnumCache->Store(1, oldTicket, packet.data(), packet.size(), characters);
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+
+    sCharacterEnumCache->Store(1, newTicket, packet.data(), packet.size(), characters);
+    EXPECT_TRUE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+}
+
+TEST_F(CharacterEnumCacheTest, UncommittedSaveKeepsAccountUncached)
+{
+    sCharacterEnumCache->Store(1, sCharacterEnumCache->BeginQuery(1), packet.data(), packet.size(), characters);
+
+    TransactionPromise commit;
+    sCharacterEnumCache->AddSave(1, TransactionCallback(commit.get_future()));
+
+    std::vector<uint8> cachedPacket;
+    GuidSet cachedCharacters;
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+
+    // this query may read the rows from before the save
+    sCharacterEnumCache->Store(1, sCharacterEnumCache->BeginQuery(1), packet.data(), packet.size(), characters);
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+
+    uint32 ticket = sCharacterEnumCache->BeginQuery(1);
+    sCharacterEnumCache->ProcessSaveCallbacks();
+    commit.set_value(true);
+    sCharacterEnumCache->ProcessSaveCallbacks();
+
+    // started before the commit as well
+    sCharacterEnumCache->Store(1, ticket, packet.data(), packet.size(), characters);
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+
+    sCharacterEnumCache->Store(1, sCharacterEnumCache->BeginQuery(1), packet.data(), packet.size(), characters);
+    EXPECT_TRUE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+}
+
+TEST_F(CharacterEnumCacheTest, DisabledCacheKeepsNothing)
+{
+    ON_CALL(*worldMock, getIntConfig(CONFIG_CHAR_ENUM_CACHE_LIFETIME)).WillByDefault(Return(0));
+
+    uint32 ticket = sCharacterEnumCache->BeginQuery(1);
+    EXPECT_EQ(ticket, 0u);
+    sCharacterEnumCache->Store(1, ticket, packet.data(), packet.size(), characters);
+
+    std::vector<uint8> cachedPacket;
+    GuidSet cachedCharacters;
+    EXPECT_FALSE(sCharacterEnumCache->Get(1, cachedPacket, cachedCharacters));
+}
@@ -0,0 +1,215 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util.h"
+#include "WhoListCacheMgr.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <set>
+
+namespace
+{
+    WhoListPlayerInfo MakeInfo(uint32 counter, uint8 level, uint32 zoneId)
+    {
+        std::string name = "Player" + std::to_string(counter);
+        std::wstring wideName(name.begin(), name.end());
+        wstrToLower(wideName);
+        return WhoListPlayerInfo(ObjectGuid::Create<HighGuid::Player>(counter), counter % 2 ? TEAM_ALLIANCE : TEAM_HORDE, SEC_PLAYER,
+            level, uint8(counter % 11 + 1), uint8(counter % 10 + 1), zoneId, uint8(counter % 2), true, wideName, 0, L"", name, "");
+    }
+
+    // the filter HandleWhoOpcode used to apply to the whole list
+    std::set<ObjectGuid> LinearMatches(std::vector<WhoListPlayerInfo> const& players, uint32 levelMin, uint32 levelMax, std::vector<uint32> const& zoneIds)
+    {
+        std::set<ObjectGuid> result;
+        for (WhoListPlayerInfo const& info : players)
+        {
+            if (info.GetLevel() < levelMin || info.GetLevel() > levelMax)
+                continue;
+
+            if (!zoneIds.empty() && std::find(zoneIds.begin(), zoneIds.end(), info.GetZoneId()) == zoneIds.end())
+                continue;
+
+            result.insert(info.GetGuid());
+        }
+        return result;
+    }
+
+    std::set<ObjectGuid> IndexMatches(WhoListIndex const& index, uint32 levelMin, uint32 levelMax, std::vector<uint32> const& zoneIds)
+    {
+        std::set<ObjectGuid> result;
+        index.Visit(levelMin, levelMax, zoneIds, [&](WhoListPlayerInfo const& info)
+        {
+            EXPECT_TRUE(result.insert(info.GetGuid()).second) << "visited twice";
+        });
+        return result;
+    }
+
+    // snapshot of the index content, in the shape of the old cache
+    std::vector<WhoListPlayerInfo> Snapshot(WhoListIndex const& index)
+    {
+        std::vector<WhoListPlayerInfo> players;
+        index.Visit(0, STRONG_MAX_LEVEL, {}, [&](WhoListPlayerInfo const& info) { players.push_back(info); });
+        return players;
+    }
+}
+
+TEST(WhoListIndexTest, VisitMatchesLinearFilter)
+{
+    std::mt19937 rng(77);
+    std::uniform_int_distribution<uint32> levelDist(1, 80);
+    std::uniform_int_distribution<uint32> zoneDist(1, 40);
+    std::uniform_int_distribution<uint32> playerDist(1, 800);
+
+    WhoListIndex index;
+    std::set<uint32> online;
+
+    for (uint32 step = 0; step < 20000; ++step)
+    {
+        uint32 counter = playerDist(rng);
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(counter);
+        switch (step % 4)
+        {
+            case 0: // login, or relog while still in world
+                index.Insert(MakeInfo(counter, uint8(levelDist(rng)), zoneDist(rng)));
+                online.insert(counter);
+                break;
+            case 1:
+                if (WhoListPlayerInfo* info = index.Find(guid))
+                    index.SetLevel(*info, uint8(levelDist(rng)));
+                break;
+            case 2:
+                if (WhoListPlayerInfo* info = index.Find(guid))
+                    index.SetZoneId(*info, zoneDist(rng));
+                break;
+            default:
+                if (step % 3 == 0)
+                {
+                    index.Remove(guid);
+                    online.erase(counter);
+                }
+                break;
+        }
+
+        if (step % 50)
+            continue;
+
+        ASSERT_EQ(online.size(), index.GetSize());
+
+        std::vector<WhoListPlayerInfo> players = Snapshot(index);
+        ASSERT_EQ(online.size(), players.size());
+
+        uint32 levelMin = levelDist(rng);
+        uint32 levelMax = levelMin + levelDist(rng) / 4;
+        std::vector<uint32> zoneIds;
+        for (uint32 i = step % 4; i > 0; --i)
+            zoneIds.push_back(zoneDist(rng));
+        if (zoneIds.size() > 1)
+            zoneIds.push_back(zoneIds.front()); // duplicates must not be listed twice
+
+        ASSERT_EQ(LinearMatches(players, levelMin, levelMax, zoneIds), IndexMatches(index, levelMin, levelMax, zoneIds));
+        ASSERT_EQ(LinearMatches(players, 0, STRONG_MAX_LEVEL, {}), IndexMatches(index, 0, 1000, {}));
+    }
+}
+
+TEST(WhoListIndexTest, InsertReplacesEntry)
+{
+    WhoListIndex index;
+    index.Insert(MakeInfo(1, 10, 12));
+    index.Insert(MakeInfo(1, 70, 4395));
+
+    EXPECT_EQ(1u, index.GetSize());
+    EXPECT_TRUE(IndexMatches(index, 1, 20, {}).empty());
+    EXPECT_TRUE(IndexMatches(index, 1, 80, { 12 }).empty());
+    EXPECT_EQ(1u, IndexMatches(index, 60, 80, { 4395 }).size());
+
+    index.Remove(ObjectGuid::Create<HighGuid::Player>(1));
+    EXPECT_EQ(0u, index.GetSize());
+    EXPECT_TRUE(IndexMatches(index, 0, STRONG_MAX_LEVEL, {}).empty());
+}
+
+// the guild master of a new guild joins it before GuildMgr::AddGuild registers it
+TEST(WhoListIndexTest, GuildRegisteredAfterJoining)
+{
+    WhoListIndex index;
+    index.Insert(MakeInfo(1, 80, 4395));
+    index.Insert(MakeInfo(2, 80, 4395));
+    ObjectGuid const leader = ObjectGuid::Create<HighGuid::Player>(1);
+    ObjectGuid const other = ObjectGuid::Create<HighGuid::Player>(2);
+
+    // what UpdatePlayer stores while GuildMgr does not know the guild
+    WhoListPlayerInfo* info = index.Find(leader);
+    ASSERT_TRUE(info->IsGuildOutdated(7));
+    info->SetGuild(7, L"", "");
+    EXPECT_TRUE(info->IsGuildOutdated(7));
+
+    index.SetGuildName(7, L"new guild", "New Guild");
+
+    info = index.Find(leader);
+    EXPECT_EQ("New Guild", info->GetGuildName());
+    EXPECT_EQ(L"new guild", info->GetWideGuildName());
+    EXPECT_FALSE(info->IsGuildOutdated(7));
+    EXPECT_TRUE(info->IsGuildOutdated(0));
+
+    // players of other guilds keep theirs
+    EXPECT_EQ(0u, index.Find(other)->GetGuildId());
+    EXPECT_EQ("", index.Find(other)->GetGuildName());
+    EXPECT_FALSE(index.Find(other)->IsGuildOutdated(0));
+}
+
+// a realistic population of 5000 players, the index finds the same players as the scan over a full list done before
+TEST(WhoListIndexTest, RealisticPopulationMatchesLinearScan)
+{
+    uint32 const players = 5000;
+    uint32 const queries = 2000;
+
+    std::mt19937 rng(5000);
+    std::uniform_int_distribution<uint32> levelDist(1, 80);
+    std::uniform_int_distribution<uint32> zoneDist(1, 60);
+
+    WhoListIndex index;
+    std::vector<WhoListPlayerInfo> list;
+    for (uint32 i = 1; i <= players; ++i)
+    {
+        // a realistic spread: many max level players in a few cities
+        uint8 level = i % 3 ? uint8(levelDist(rng)) : 80;
+        uint32 zoneId = i % 4 ? zoneDist(rng) : 4395;
+        index.Insert(MakeInfo(i, level, zoneId));
+        list.push_back(MakeInfo(i, level, zoneId));
+    }
+
+    // addon style requests: a level bracket, sometimes a zone
+    struct Query
+    {
+        uint32 LevelMin;
+        uint32 LevelMax;
+        std::vector<uint32> ZoneIds;
+    };
+
+    std::vector<Query> requests;
+    for (uint32 i = 0; i < queries; ++i)
+    {
+        uint32 levelMin = levelDist(rng);
+        Query query{ levelMin, std::min<uint32>(levelMin + 5, 80), {} };
+        if (i % 3 == 0)
+            query.ZoneIds.push_back(zoneDist(rng));
+        requests.push_back(query);
+    }
+
+    for (Query const& query : requests)
+        ASSERT_EQ(IndexMatches(index, query.LevelMin, query.LevelMax, query.ZoneIds), LinearMatches(list, query.LevelMin, query.LevelMax, query.ZoneIds));
+}
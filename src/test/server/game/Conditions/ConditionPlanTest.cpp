@@ -0,0 +1,190 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConditionMgr.h"
+#include "ConditionPlan.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+
+namespace
+{
+    ConditionTypes const SyntheticTypes[] =
+    {
+        CONDITION_LEVEL, CONDITION_CLASS, CONDITION_RACE, CONDITION_ZONEID, CONDITION_TEAM,
+        CONDITION_AURA, CONDITION_QUESTREWARDED, CONDITION_QUESTTAKEN, CONDITION_REPUTATION_RANK, CONDITION_ACTIVE_EVENT,
+        CONDITION_ITEM, CONDITION_NEAR_CREATURE, CONDITION_NEAR_GAMEOBJECT
+    };
+
+    // a conditions table shaped like the world database one: lists of one to six rows sorted by
+    // ElseGroup (the primary key order), some rows pointing to reference templates
+    class SyntheticConditions
+    {
+    public:
+        SyntheticConditions(uint32 listCount, uint32 referenceCount, uint32 seed) : _random(seed)
+        {
+            for (uint32 referenceId = 1; referenceId <= referenceCount; ++referenceId)
+                References[referenceId] = MakeList(0);
+
+            Lists.reserve(listCount);
+            for (uint32 i = 0; i < listCount; ++i)
+                Lists.push_back(MakeList(referenceCount));
+        }
+
+        ConditionReferenceContainer References;
+        std::vector<ConditionList> Lists;
+
+    private:
+        ConditionList MakeList(uint32 referenceCount)
+        {
+            ConditionList conditions;
+            uint32 groups = Roll(3) + 1;
+            for (uint32 elseGroup = 0; elseGroup < groups; ++elseGroup)
+            {
+                uint32 rows = Roll(3) + 1;
+                for (uint32 row = 0; row < rows; ++row)
+                {
+                    Condition* condition = Make();
+                    condition->ElseGroup = elseGroup;
+                    // one reference in ten, a few of them to templates that do not exist
+                    if (referenceCount && !Roll(10))
+                        condition->ReferenceId = Roll(referenceCount + 5) + 1;
+                    else
+                    {
+                        condition->ConditionType = SyntheticTypes[Roll(std::size(SyntheticTypes))];
+                        condition->ConditionValue1 = _random();
+                        condition->NegativeCondition = !Roll(4);
+                    }
+                    conditions.push_back(condition);
+                }
+            }
+            return conditions;
+        }
+
+        Condition* Make()
+        {
+            _storage.push_back(std::make_unique<Condition>());
+            return _storage.back().get();
+        }
+
+        uint32 Roll(std::size_t max) { return uint32(_random() % max); }
+
+        std::mt19937 _random;
+        std::vector<std::unique_ptr<Condition>> _storage;
+    };
+
+    // stands in for Condition::Meets: the outcome depends on the condition and the target
+    struct SyntheticCheck
+    {
+        uint32 Target;
+
+        bool operator()(Condition* condition) const
+        {
+            uint32 hash = (condition->ConditionValue1 ^ (Target * 2654435761u)) * 1664525u + 1013904223u;
+            return ((hash >> 7) % 10 < 7) != condition->NegativeCondition;
+        }
+    };
+
+    struct PlanSet
+    {
+        ConditionReferencePlanContainer References;
+        std::vector<ConditionPlan> Lists;
+    };
+
+    void CompileAll(SyntheticConditions const& table, PlanSet& plans)
+    {
+        ConditionPlan::ReferenceResolver resolve = [&](uint32 referenceId) -> ConditionPlan const*
+        {
+            ConditionReferencePlanContainer::const_iterator itr = plans.References.find(referenceId);
+            if (itr != plans.References.end())
+                return itr->second.get();
+
+            ConditionReferenceContainer::const_iterator ref = table.References.find(referenceId);
+            if (ref == table.References.end())
+                return nullptr;
+
+            std::unique_ptr<ConditionPlan> plan = std::make_unique<ConditionPlan>();
+            plan->Compile(ref->second, resolve, true);
+            return plans.References.emplace(referenceId, std::move(plan)).first->second.get();
+        };
+
+        plans.Lists.resize(table.Lists.size());
+        for (std::size_t i = 0; i < table.Lists.size(); ++i)
+            plans.Lists[i].Compile(table.Lists[i], resolve, false);
+    }
+
+    Condition MakeCondition(ConditionTypes type, uint32 elseGroup, uint32 referenceId = 0)
+    {
+        Condition condition;
+        condition.ConditionType = referenceId ? CONDITION_NONE : type;
+        condition.ElseGroup = elseGroup;
+        condition.ReferenceId = referenceId;
+        return condition;
+    }
+}
+
+TEST(ConditionPlanTest, FoldsReferencesAndOrdersByCost)
+{
+    Condition nearCreature = MakeCondition(CONDITION_NEAR_CREATURE, 0);
+    Condition level = MakeCondition(CONDITION_LEVEL, 0);
+    Condition missingReference = MakeCondition(CONDITION_NONE, 1, 2);
+    Condition singleGroupReference = MakeCondition(CONDITION_NONE, 0, 1);
+    Condition referencedAura = MakeCondition(CONDITION_AURA, 0);
+
+    ConditionPlan reference;
+    reference.Compile({ &referencedAura }, [](uint32) { return nullptr; }, true);
+
+    ConditionPlan::ReferenceResolver resolve = [&](uint32 referenceId) { return referenceId == 1 ? &reference : nullptr; };
+
+    ConditionList conditions = { &nearCreature, &singleGroupReference, &level };
+    ConditionPlan plan;
+    plan.Compile(conditions, resolve, false);
+    EXPECT_TRUE(plan.IsCompiledFrom(conditions));
+    EXPECT_FALSE(plan.IsCompiledFrom({ &nearCreature, &level }));
+    EXPECT_EQ(plan.GetGroupCount(), 1u);
+    EXPECT_EQ(plan.GetTermCount(), 3u);
+
+    std::vector<Condition*> checked;
+    EXPECT_FALSE(plan.Evaluate([&](Condition* condition) { checked.push_back(condition); return condition != &nearCreature; }));
+    EXPECT_EQ(checked, std::vector<Condition*>({ &level, &referencedAura, &nearCreature }));
+
+    // kept order for spell conditions, the caller looks at the last failed one
+    checked.clear();
+    plan.Compile(conditions, resolve, true);
+    EXPECT_FALSE(plan.Evaluate([&](Condition* condition) { checked.push_back(condition); return condition != &nearCreature; }));
+    EXPECT_EQ(checked, std::vector<Condition*>({ &nearCreature }));
+
+    // the second group only holds a missing reference, it always passes
+    conditions.push_back(&missingReference);
+    plan.Compile(conditions, resolve, false);
+    EXPECT_TRUE(plan.IsAlwaysTrue());
+    EXPECT_TRUE(plan.Evaluate([](Condition*) { return false; }));
+}
+
+TEST(ConditionPlanTest, MatchesInterpreter)
+{
+    SyntheticConditions table(2000, 50, 7);
+    PlanSet plans;
+    CompileAll(table, plans);
+
+    for (uint32 target = 0; target < 32; ++target)
+    {
+        SyntheticCheck check{ target };
+        for (std::size_t i = 0; i < table.Lists.size(); ++i)
+            ASSERT_EQ(ConditionMgr::IsConditionListMet(table.Lists[i], table.References, check), plans.Lists[i].Evaluate(check)) << "list " << i << " target " << target;
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveScheduler.h"
+#include "WorldMock.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+    class PlayerSaveSchedulerTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            originalWorld = sWorld.release();
+            worldMock = new NiceMock<WorldMock>();
+            sWorld.reset(worldMock);
+
+            ON_CALL(*worldMock, getIntConfig(_)).WillByDefault(Return(0));
+            ON_CALL(*worldMock, getIntConfig(CONFIG_PLAYER_SAVE_MAX_PER_SECOND)).WillByDefault(Return(2));
+
+            for (uint32 i = 1; i <= 5; ++i)
+                players.push_back(ObjectGuid::Create<HighGuid::Player>(i));
+        }
+
+        void TearDown() override
+        {
+            // the scheduler is a singleton, leave it empty for the next test
+            for (ObjectGuid const& guid : players)
+                sPlayerSaveScheduler->Forget(guid);
+
+            IWorld* currentWorld = sWorld.release();
+            delete currentWorld;
+            worldMock = nullptr;
+
+            sWorld.reset(originalWorld);
+            originalWorld = nullptr;
+        }
+
+        IWorld* originalWorld = nullptr;
+        NiceMock<WorldMock>* worldMock = nullptr;
+        std::vector<ObjectGuid> players;
+    };
+}
+
+TEST_F(PlayerSaveSchedulerTest, UnlimitedSavesRunRightAway)
+{
+    ON_CALL(*worldMock, getIntConfig(CONFIG_PLAYER_SAVE_MAX_PER_SECOND)).WillByDefault(Return(0));
+
+    for (ObjectGuid const& guid : players)
+        EXPECT_TRUE(sPlayerSaveScheduler->RequestSave(guid, false));
+
+    EXPECT_EQ(sPlayerSaveScheduler->GetQueueSize(false), 0u);
+}
+
+TEST_F(PlayerSaveSchedulerTest, GrantsInRequestOrderWithinBudget)
+{
+    for (ObjectGuid const& guid : players)
+        EXPECT_FALSE(sPlayerSaveScheduler->RequestSave(guid, false));
+
+    EXPECT_EQ(sPlayerSaveScheduler->GetQueueSize(false), players.size());
+
+    // half a second of a two per second budget
+    sPlayerSaveScheduler->Update(500);
+    EXPECT_TRUE(sPlayerSaveScheduler->RequestSave(players[0], false));
+    EXPECT_FALSE(sPlayerSaveScheduler->RequestSave(players[1], false));
+
+    sPlayerSaveScheduler->Update(1000);
+    EXPECT_TRUE(sPlayerSaveScheduler->RequestSave(players[1], false));
+    EXPECT_TRUE(sPlayerSaveScheduler->RequestSave(players[2], false));
+    EXPECT_FALSE(sPlayerSaveScheduler->RequestSave(players[3], false));
+    EXPECT_EQ(sPlayerSaveScheduler->GetQueueSize(false), 2u);
+}
+
+TEST_F(PlayerSaveSchedulerTest, AtRiskPlayersGoFirst)
+{
+    for (ObjectGuid const& guid : players)
+        EXPECT_FALSE(sPlayerSaveScheduler->RequestSave(guid, false));
+
+    // the last player levels up while waiting
+    EXPECT_FALSE(sPlayerSaveScheduler->RequestSave(players[4], true));
+    EXPECT_EQ(sPlayerSaveScheduler->GetQueueSize(true), 1u);
+
+    sPlayerSaveScheduler->Update(500);
+    EXPECT_TRUE(sPlayerSaveScheduler->RequestSave(players[4], true));
+    EXPECT_FALSE(sPlayerSaveScheduler->RequestSave(players[0], false));
+}
+
+TEST_F(PlayerSaveSchedulerTest, ForgottenPlayersLeaveTheQueue)
+{
+    for (ObjectGuid const& guid : players)
+        EXPECT_FALSE(sPlayerSaveScheduler->RequestSave(guid, false));
+
+    // saved on logout meanwhile
+    sPlayerSaveScheduler->Forget(players[0]);
+    EXPECT_EQ(sPlayerSaveScheduler->GetQueueSize(false), players.size() - 1);
+
+    sPlayerSaveScheduler->Update(500);
+    EXPECT_TRUE(sPlayerSaveScheduler->RequestSave(players[1], false));
+}
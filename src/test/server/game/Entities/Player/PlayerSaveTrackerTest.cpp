@@ -0,0 +1,101 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterDatabase.h"
+#include "PlayerSaveTracker.h"
+#include "PreparedStatement.h"
+#include "Transaction.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    void AppendRow(CharacterDatabaseTransaction const& trans, uint32 index, uint32 value)
+    {
+        CharacterDatabasePreparedStatement* stmt = new CharacterDatabasePreparedStatement(index, 1);
+        stmt->SetData(0, value);
+        trans->Append(stmt);
+    }
+
+    // Appends the rows of one save of a snapshot subsystem and returns the statements left in the transaction
+    std::size_t SaveAuras(PlayerSaveTracker& tracker, bool differential, uint32 value)
+    {
+        CharacterDatabaseTransaction trans = std::make_shared<Transaction<CharacterDatabaseConnection>>();
+        tracker.BeginSave(differential);
+        tracker.Track(trans, PLAYER_SAVE_AURAS, [&]()
+        {
+            trans->Append("DELETE FROM character_aura WHERE guid = 1");
+            AppendRow(trans, 1, value);
+        });
+
+        return trans->GetSize();
+    }
+}
+
+TEST(PlayerSaveTrackerTest, UnchangedSnapshotIsTruncated)
+{
+    PlayerSaveTracker tracker;
+    EXPECT_EQ(SaveAuras(tracker, true, 42), 2u);
+    EXPECT_EQ(tracker.GetStats(PLAYER_SAVE_AURAS).Statements, 2u);
+
+    EXPECT_EQ(SaveAuras(tracker, true, 42), 0u);
+    EXPECT_EQ(tracker.GetStats(PLAYER_SAVE_AURAS).Statements, 0u);
+    EXPECT_EQ(tracker.GetStats(PLAYER_SAVE_AURAS).SkippedStatements, 2u);
+
+    EXPECT_EQ(SaveAuras(tracker, true, 43), 2u);
+}
+
+TEST(PlayerSaveTrackerTest, FullSaveWritesUnchangedSnapshot)
+{
+    PlayerSaveTracker tracker;
+    SaveAuras(tracker, true, 42);
+
+    EXPECT_EQ(SaveAuras(tracker, false, 42), 2u);
+    EXPECT_EQ(tracker.GetStats(PLAYER_SAVE_AURAS).SkippedStatements, 0u);
+}
+
+TEST(PlayerSaveTrackerTest, InvalidatedSnapshotIsWritten)
+{
+    PlayerSaveTracker tracker;
+    SaveAuras(tracker, true, 42);
+    tracker.Invalidate(PLAYER_SAVE_AURAS);
+    EXPECT_EQ(SaveAuras(tracker, true, 42), 2u);
+
+    // a failed commit drops the digests of every snapshot subsystem
+    tracker.InvalidateSnapshots();
+    EXPECT_EQ(SaveAuras(tracker, true, 42), 2u);
+    EXPECT_EQ(SaveAuras(tracker, true, 42), 0u);
+}
+
+TEST(PlayerSaveTrackerTest, OtherSubsystemsAreNeverSkipped)
+{
+    PlayerSaveTracker tracker;
+    CharacterDatabaseTransaction trans = std::make_shared<Transaction<CharacterDatabaseConnection>>();
+
+    for (uint8 i = 0; i < 2; ++i)
+    {
+        tracker.BeginSave(true);
+        tracker.Track(trans, PLAYER_SAVE_INVENTORY, [&]()
+        {
+            AppendRow(trans, 2, 7);
+        });
+
+        EXPECT_EQ(tracker.GetStats(PLAYER_SAVE_INVENTORY).Statements, 1u);
+        EXPECT_EQ(tracker.GetStats(PLAYER_SAVE_INVENTORY).SkippedStatements, 0u);
+    }
+
+    EXPECT_EQ(trans->GetSize(), 2u);
+}
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GuildDirectory.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    ObjectGuid MakeLeader(ObjectGuid::LowType guid)
+    {
+        return ObjectGuid::Create<HighGuid::Player>(guid);
+    }
+
+    bool NoneLoaded(uint32 /*guildId*/)
+    {
+        return false;
+    }
+}
+
+TEST(GuildDirectoryTest, FindsUnloadedGuildsByNameAndLeader)
+{
+    GuildDirectory directory;
+    directory.Set(1, "Knights of Stormwind", MakeLeader(10));
+    directory.Set(2, "Horde Raiders", MakeLeader(20));
+
+    EXPECT_EQ(directory.FindByName("knights of STORMWIND", NoneLoaded), 1u);
+    EXPECT_EQ(directory.FindByName("Horde Raiders", NoneLoaded), 2u);
+    EXPECT_EQ(directory.FindByName("Horde", NoneLoaded), 0u);
+
+    EXPECT_EQ(directory.FindByLeader(MakeLeader(20), NoneLoaded), 2u);
+    EXPECT_EQ(directory.FindByLeader(MakeLeader(30), NoneLoaded), 0u);
+
+    ASSERT_NE(directory.GetName(1), nullptr);
+    EXPECT_EQ(*directory.GetName(1), "Knights of Stormwind");
+    EXPECT_EQ(directory.GetName(3), nullptr);
+
+    // a refreshed entry is found under its new name and leader only
+    directory.Set(1, "Stormwind Guard", MakeLeader(11));
+    EXPECT_EQ(directory.FindByName("Knights of Stormwind", NoneLoaded), 0u);
+    EXPECT_EQ(directory.FindByName("Stormwind Guard", NoneLoaded), 1u);
+    EXPECT_EQ(directory.FindByLeader(MakeLeader(10), NoneLoaded), 0u);
+    EXPECT_EQ(directory.FindByLeader(MakeLeader(11), NoneLoaded), 1u);
+
+    directory.Remove(2);
+    EXPECT_FALSE(directory.Contains(2));
+    EXPECT_EQ(directory.FindByName("Horde Raiders", NoneLoaded), 0u);
+    EXPECT_EQ(directory.GetSize(), 1u);
+}
+
+TEST(GuildDirectoryTest, SkipsOutdatedEntriesOfLoadedGuilds)
+{
+    // guild 1 was renamed while loaded, the name went to guild 2 afterwards
+    GuildDirectory directory;
+    directory.Set(1, "Old Name", MakeLeader(10));
+    directory.Set(2, "Old Name", MakeLeader(10));
+
+    auto isLoaded = [](uint32 guildId) { return guildId == 1; };
+    EXPECT_EQ(directory.FindByName("Old Name", isLoaded), 2u);
+    EXPECT_EQ(directory.FindByLeader(MakeLeader(10), isLoaded), 2u);
+
+    auto allLoaded = [](uint32 /*guildId*/) { return true; };
+    EXPECT_EQ(directory.FindByName("Old Name", allLoaded), 0u);
+    EXPECT_EQ(directory.FindByLeader(MakeLeader(10), allLoaded), 0u);
+}
+
+TEST(GuildDirectoryTest, GuildsInUseAreNotUnloaded)
+{
+    GuildDirectory directory;
+    for (uint32 guildId = 1; guildId <= 4; ++guildId)
+    {
+        directory.Set(guildId, "Guild " + std::to_string(guildId), MakeLeader(guildId));
+        directory.Touch(guildId, 100);
+    }
+
+    std::vector<GuildDirectory::UnloadCandidate> candidates =
+    {
+        { 1, false, false },
+        { 2, true, false },     // members online
+        { 3, false, true },     // prefetch pending
+        { 4, false, false },
+        { 5, false, false }     // not in the directory
+    };
+
+    // not idle for long enough yet
+    EXPECT_TRUE(directory.SelectIdleGuilds(candidates, 1000, 1000, MAX_GUILD_UNLOADS_PER_SWEEP).empty());
+
+    directory.Touch(4, 500);
+    EXPECT_EQ(directory.SelectIdleGuilds(candidates, 1100, 1000, MAX_GUILD_UNLOADS_PER_SWEEP), std::vector<uint32>({ 1 }));
+    EXPECT_EQ(directory.SelectIdleGuilds(candidates, 1500, 1000, MAX_GUILD_UNLOADS_PER_SWEEP), std::vector<uint32>({ 1, 4 }));
+}
+
+TEST(GuildDirectoryTest, UnloadsLeastRecentlyUsedFirst)
+{
+    uint32 const guildCount = MAX_GUILD_UNLOADS_PER_SWEEP * 3 / 2;
+
+    GuildDirectory directory;
+    std::vector<GuildDirectory::UnloadCandidate> candidates;
+    for (uint32 guildId = 1; guildId <= guildCount; ++guildId)
+    {
+        directory.Set(guildId, "Guild " + std::to_string(guildId), MakeLeader(guildId));
+        // every third guild was used last a long time ago, newer guild ids first
+        directory.Touch(guildId, guildId % 3 ? 1000 + guildId : 1000 - guildId);
+        candidates.push_back({ guildId, false, false });
+    }
+
+    std::vector<uint32> idleGuilds = directory.SelectIdleGuilds(candidates, 10000, 60, MAX_GUILD_UNLOADS_PER_SWEEP);
+    ASSERT_EQ(idleGuilds.size(), MAX_GUILD_UNLOADS_PER_SWEEP);
+
+    std::vector<uint32> expected;
+    for (uint32 guildId = guildCount - guildCount % 3; guildId > 0; guildId -= 3)
+        expected.push_back(guildId);
+
+    for (uint32 guildId = 1; expected.size() < MAX_GUILD_UNLOADS_PER_SWEEP; ++guildId)
+        if (guildId % 3)
+            expected.push_back(guildId);
+
+    EXPECT_EQ(idleGuilds, expected);
+
+    // the rest goes with the next sweep
+    for (uint32 guildId : idleGuilds)
+        directory.Remove(guildId);
+
+    EXPECT_EQ(directory.SelectIdleGuilds(candidates, 10000, 60, MAX_GUILD_UNLOADS_PER_SWEEP).size(), guildCount - MAX_GUILD_UNLOADS_PER_SWEEP);
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LootChanceTable.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+
+namespace
+{
+    // the walk LootTemplate::LootGroup::Roll does over the explicitly chanced entries
+    int32 SequentialSelect(std::vector<float> const& chances, float roll)
+    {
+        for (std::size_t i = 0; i < chances.size(); ++i)
+        {
+            if (chances[i] >= 100.0f)
+                return int32(i);
+
+            roll -= chances[i];
+            if (roll < 0)
+                return int32(i);
+        }
+
+        return -1;
+    }
+
+    LootChanceTable MakeTable(std::vector<float> const& chances)
+    {
+        LootChanceTable table;
+        for (float chance : chances)
+            table.Add(chance);
+        return table;
+    }
+}
+
+TEST(LootChanceTableTest, SelectsLikeSequentialWalk)
+{
+    std::vector<float> const chances = { 10.0f, 25.0f, 5.0f };
+    LootChanceTable table = MakeTable(chances);
+    EXPECT_EQ(table.GetSize(), 3u);
+
+    for (float roll : { 0.0f, 9.99f, 10.0f, 34.99f, 35.0f, 39.99f, 40.0f, 99.99f })
+        EXPECT_EQ(table.Select(roll), SequentialSelect(chances, roll)) << "roll " << roll;
+
+    EXPECT_EQ(table.Select(5.0f), 0);
+    EXPECT_EQ(table.Select(20.0f), 1);
+    EXPECT_EQ(table.Select(50.0f), -1);
+
+    // an entry of 100% or more drops whenever the walk reaches it
+    std::vector<float> const guaranteed = { 30.0f, 100.0f, 20.0f };
+    LootChanceTable guaranteedTable = MakeTable(guaranteed);
+    EXPECT_EQ(guaranteedTable.Select(10.0f), 0);
+    EXPECT_EQ(guaranteedTable.Select(30.0f), 1);
+    EXPECT_EQ(guaranteedTable.Select(99.99f), 1);
+
+    EXPECT_EQ(LootChanceTable().Select(0.0f), -1);
+}
+
+TEST(LootChanceTableTest, DistributionMatchesSequentialWalk)
+{
+    // shaped like a raid trash group: a few rare epics, some blues and a common drop, missing 45% of the time
+    std::vector<float> const chances = { 0.01f, 0.5f, 1.2f, 3.0f, 3.0f, 7.3f, 15.0f, 25.0f };
+    LootChanceTable table = MakeTable(chances);
+
+    uint32 const rolls = 10000000;
+    std::vector<uint32> sequentialDrops(chances.size() + 1, 0);
+    std::vector<uint32> tableDrops(chances.size() + 1, 0);
+
+    std::mt19937 random(2024);
+    std::uniform_real_distribution<double> distribution(0.0, 100.0);
+    for (uint32 i = 0; i < rolls; ++i)
+    {
+        // rand_chance() is a double converted to float by the group roll
+        float roll = float(distribution(random));
+        ++sequentialDrops[SequentialSelect(chances, roll) + 1];
+        ++tableDrops[table.Select(roll) + 1];
+    }
+
+    float missChance = 100.0f;
+    for (std::size_t i = 0; i < chances.size(); ++i)
+    {
+        double expected = rolls * chances[i] / 100.0;
+        double sigma = std::sqrt(expected * (1.0 - chances[i] / 100.0));
+
+        // same rolls, same drops; summing the chances up front may only move rolls sitting on a float boundary
+        EXPECT_NEAR(tableDrops[i + 1], sequentialDrops[i + 1], 2.0) << "entry " << i;
+        EXPECT_NEAR(tableDrops[i + 1], expected, 5.0 * sigma + 1.0) << "entry " << i;
+        missChance -= chances[i];
+    }
+
+    EXPECT_NEAR(tableDrops[0], sequentialDrops[0], 2.0);
+    double expectedMisses = rolls * missChance / 100.0;
+    EXPECT_NEAR(tableDrops[0], expectedMisses, 5.0 * std::sqrt(expectedMisses * (1.0 - missChance / 100.0)));
+}
@@ -0,0 +1,225 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Rewrites extracted .map files so that every section starts at a MAP_SECTION_ALIGNMENT boundary.
+ * The worldserver maps such files read-only instead of copying them to the heap, so terrain is shared
+ * through the page cache between all map instances and worldserver processes using the same data dir.
+ * Section contents are unchanged, mmaps_generator reads converted files as well.
+ */
+
+#include "Define.h"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// ******************************************
+// Map file format defines, see GridTerrainData.h
+// ******************************************
+static char const* MAP_MAGIC         = "MAPS";
+static char const* MAP_ALIGNED_MAGIC = "MAPA";
+static uint32 const MAP_VERSION_MAGIC = 9;
+static uint32 const MAP_SECTION_ALIGNMENT = 16;
+
+struct map_fileheader
+{
+    uint32 mapMagic;
+    uint32 versionMagic;
+    uint32 buildMagic;
+    uint32 areaMapOffset;
+    uint32 areaMapSize;
+    uint32 heightMapOffset;
+    uint32 heightMapSize;
+    uint32 liquidMapOffset;
+    uint32 liquidMapSize;
+    uint32 holesOffset;
+    uint32 holesSize;
+};
+
+enum class ConvertResult
+{
+    Converted,
+    AlreadyConverted,
+    Failed
+};
+
+uint32 AlignSectionOffset(uint32 offset)
+{
+    return (offset + MAP_SECTION_ALIGNMENT - 1) & ~(MAP_SECTION_ALIGNMENT - 1);
+}
+
+ConvertResult ConvertMapFile(fs::path const& source, fs::path const& destination)
+{
+    std::ifstream input(source, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (input.bad() || data.size() < sizeof(map_fileheader))
+    {
+        std::cout << "Unable to read " << source << std::endl;
+        return ConvertResult::Failed;
+    }
+
+    map_fileheader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (header.versionMagic != MAP_VERSION_MAGIC)
+    {
+        std::cout << source << " is the wrong version, please extract new .map files" << std::endl;
+        return ConvertResult::Failed;
+    }
+
+    if (!std::memcmp(&header.mapMagic, MAP_ALIGNED_MAGIC, 4))
+    {
+        if (source == destination)
+            return ConvertResult::AlreadyConverted;
+
+        std::error_code error;
+        fs::copy_file(source, destination, fs::copy_options::overwrite_existing, error);
+        return error ? ConvertResult::Failed : ConvertResult::AlreadyConverted;
+    }
+
+    if (std::memcmp(&header.mapMagic, MAP_MAGIC, 4))
+    {
+        std::cout << source << " is not a map file" << std::endl;
+        return ConvertResult::Failed;
+    }
+
+    struct Section
+    {
+        uint32& Offset;
+        uint32 Size;
+        uint32 FileOffset;
+    };
+
+    std::array<Section, 4> sections =
+    { {
+        { header.areaMapOffset, header.areaMapSize, header.areaMapOffset },
+        { header.heightMapOffset, header.heightMapSize, header.heightMapOffset },
+        { header.liquidMapOffset, header.liquidMapSize, header.liquidMapOffset },
+        { header.holesOffset, header.holesSize, header.holesOffset }
+    } };
+
+    uint32 size = AlignSectionOffset(sizeof(header));
+    for (Section& section : sections)
+    {
+        if (!section.Offset || !section.Size)
+            continue;
+
+        if (section.FileOffset > data.size() || section.Size > data.size() - section.FileOffset)
+        {
+            std::cout << source << " is truncated" << std::endl;
+            return ConvertResult::Failed;
+        }
+
+        section.Offset = size;
+        size = AlignSectionOffset(size + section.Size);
+    }
+
+    std::memcpy(&header.mapMagic, MAP_ALIGNED_MAGIC, 4);
+
+    std::vector<char> converted(size, 0);
+    std::memcpy(converted.data(), &header, sizeof(header));
+    for (Section const& section : sections)
+        if (section.Offset && section.Size)
+            std::memcpy(&converted[section.Offset], &data[section.FileOffset], section.Size);
+
+    // Write to a temporary file first, a running worldserver may have the old file mapped
+    fs::path temporary = destination;
+    temporary += ".tmp";
+
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        if (!output.write(converted.data(), converted.size()))
+        {
+            std::cout << "Unable to write " << temporary << std::endl;
+            return ConvertResult::Failed;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, destination, error);
+    if (error)
+    {
+        std::cout << "Unable to replace " << destination << ": " << error.message() << std::endl;
+        fs::remove(temporary, error);
+        return ConvertResult::Failed;
+    }
+
+    return ConvertResult::Converted;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string src = "maps";
+    std::string dest;
+
+    if (argc > 3)
+    {
+        std::cout << "usage: " << argv[0] << " <maps dir> [<output dir>]" << std::endl;
+        std::cout << "Converts the .map files in place when no output dir is given." << std::endl;
+        return 1;
+    }
+
+    if (argc > 1)
+        src = argv[1];
+
+    dest = argc > 2 ? argv[2] : src;
+
+    std::error_code error;
+    if (!fs::is_directory(src, error))
+    {
+        std::cout << "Directory " << src << " does not exist" << std::endl;
+        return 1;
+    }
+
+    if (!fs::is_directory(dest, error) && !fs::create_directories(dest, error))
+    {
+        std::cout << "Unable to create directory " << dest << std::endl;
+        return 1;
+    }
+
+    uint32 converted = 0;
+    uint32 skipped = 0;
+    uint32 failed = 0;
+
+    for (fs::directory_entry const& entry : fs::directory_iterator(src))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".map")
+            continue;
+
+        switch (ConvertMapFile(entry.path(), fs::path(dest) / entry.path().filename()))
+        {
+            case ConvertResult::Converted:
+                ++converted;
+                break;
+            case ConvertResult::AlreadyConverted:
+                ++skipped;
+                break;
+            case ConvertResult::Failed:
+                ++failed;
+                break;
+        }
+    }
+
+    std::cout << "Converted " << converted << " map files, " << skipped << " already converted, " << failed << " failed" << std::endl;
+    return failed ? 1 : 0;
+}
@@ -17,12 +17,16 @@
 
 #define _CRT_SECURE_NO_DEPRECATE
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <deque>
 #include <filesystem>
 #include <set>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include <cstring>
 
 #ifdef _WIN32
@@ -99,6 +103,9 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// Number of threads converting ADT files
+uint32 CONF_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
 // List MPQ for extract from
 const char* CONF_mpq_list[] =
 {
@@ -162,6 +169,7 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of threads converting map tiles - standard: all cores\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -174,6 +182,7 @@ void HandleArgs(int argc, char* arg[])
         // o - output path
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
+        // t - number of threads
         // h - limit minimum height
         if (arg[c][0] != '-')
         {
@@ -214,6 +223,16 @@ void HandleArgs(int argc, char* arg[])
                     Usage(arg[0]);
                 }
                 break;
+            case 't':
+                if (c + 1 < argc)                           // all ok
+                {
+                    CONF_threads = std::max(atoi(arg[(c++) + 1]), 1);
+                }
+                else
+                {
+                    Usage(arg[0]);
+                }
+                break;
             case 'e':
                 if (c + 1 < argc)                           // all ok
                 {
@@ -392,24 +411,24 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per converting thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
 {
@@ -428,6 +447,8 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     memset(liquid_show, 0, sizeof(liquid_show));
     memset(liquid_flags, 0, sizeof(liquid_flags));
     memset(liquid_entry, 0, sizeof(liquid_entry));
+    // the last row and column are only written by MCLQ, don't leak them from whatever tile the thread converted before
+    std::fill(&liquid_height[0][0], &liquid_height[0][0] + (ADT_GRID_SIZE + 1) * (ADT_GRID_SIZE + 1), CONF_use_minHeight);
 
     memset(holes, 0, sizeof(holes));
 
@@ -975,8 +996,6 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
 
 void ExtractMapsFromMpq(uint32 build)
 {
-    std::string mpqFileName;
-    std::string outputFileName;
     std::string mpqMapName;
 
     printf("Extracting maps...\n");
@@ -989,7 +1008,7 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    printf("Convert map files using %u threads\n", CONF_threads);
     for (uint32 z = 0; z < map_count; ++z)
     {
         printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z + 1, map_count);
@@ -1002,19 +1021,39 @@ void ExtractMapsFromMpq(uint32 build)
             continue;
         }
 
+        std::vector<std::pair<uint32, uint32>> tiles;
         for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
-        {
             for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
+                if (wdt.main->adt_list[y][x].exist)
+                    tiles.emplace_back(x, y);
+
+        // every tile is written to its own file, only the MPQ reads are serialized
+        std::atomic<std::size_t> nextTile(0);
+        std::atomic<std::size_t> doneTiles(0);
+        auto convertTiles = [&]()
+        {
+            for (std::size_t i = nextTile++; i < tiles.size(); i = nextTile++)
             {
-                if (!wdt.main->adt_list[y][x].exist)
-                    continue;
-                mpqFileName = Acore::StringFormat(R"(World\Maps\{}\{}_{}_{}.adt)", map_ids[z].name, map_ids[z].name, x, y);
-                outputFileName = Acore::StringFormat("{}/maps/{:03}{:02}{:02}.map", output_path, map_ids[z].id, y, x);
+                auto [x, y] = tiles[i];
+                std::string mpqFileName = Acore::StringFormat(R"(World\Maps\{}\{}_{}_{}.adt)", map_ids[z].name, map_ids[z].name, x, y);
+                std::string outputFileName = Acore::StringFormat("{}/maps/{:03}{:02}{:02}.map", output_path, map_ids[z].id, y, x);
                 ConvertADT(mpqFileName, outputFileName, y, x, build);
+
+                // draw progress bar
+                std::size_t done = ++doneTiles;
+                if ((100 * done) / tiles.size() != (100 * (done - 1)) / tiles.size())
+                    printf("Processing........................%d%%\r", int((100 * done) / tiles.size()));
             }
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
-        }
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < CONF_threads && i < tiles.size(); ++i)
+            workers.emplace_back(convertTiles);
+
+        convertTiles();
+
+        for (std::thread& worker : workers)
+            worker.join();
     }
     printf("\n");
 }
@@ -18,6 +18,7 @@
 #include "mpq_libmpq04.h"
 #include <cstdio>
 #include <deque>
+#include <mutex>
 
 ArchiveSet gOpenArchives;
 
@@ -65,6 +66,10 @@ MPQFile::MPQFile(const char* filename):
     pointer(0),
     size(0)
 {
+    // libmpq archives keep their read state internally, maps are extracted by several threads
+    static std::mutex archiveLock;
+    std::lock_guard<std::mutex> guard(archiveLock);
+
     for (auto & gOpenArchive : gOpenArchives)
     {
         mpq_archive* mpq_a = gOpenArchive->mpq_a;
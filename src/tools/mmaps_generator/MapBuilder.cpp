@@ -26,7 +26,10 @@
 #include "ModelInstance.h"
 #include "PathCommon.h"
 #include "StringFormat.h"
+#include "Timer.h"
+#include "Util.h"
 #include "VMapMgr2.h"
+#include <algorithm>
 
 namespace MMAP
 {
@@ -55,7 +58,7 @@ namespace MMAP
             m_workerThread.join();
     }
 
-    MapBuilder::MapBuilder(Config* config, int mapid, const char* offMeshFilePath, unsigned int threads) :
+    MapBuilder::MapBuilder(Config* config, int mapid, const char* offMeshFilePath, unsigned int threads, bool report) :
         m_config             (config),
         m_debugOutput        (config->IsDebugOutputEnabled()),
         m_offMeshFilePath    (offMeshFilePath),
@@ -67,6 +70,8 @@ namespace MMAP
         m_mapid              (mapid),
         m_totalTiles         (0u),
         m_totalTilesProcessed(0u),
+        m_tileSignatures     (config->DataDirPath(), offMeshFilePath),
+        m_report             (report),
 
         _cancelationToken    (false)
     {
@@ -208,9 +213,10 @@ namespace MMAP
             m_tileBuilders.push_back(new TileBuilder(this, m_skipLiquid, m_debugOutput));
         }
 
+        std::vector<TileInfo> queuedTiles;
         if (mapID)
         {
-            buildMap(*mapID);
+            buildMap(*mapID, queuedTiles);
         }
         else
         {
@@ -218,10 +224,20 @@ namespace MMAP
             for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
             {
                 if (!shouldSkipMap(it->m_mapId))
-                    buildMap(it->m_mapId);
+                    buildMap(it->m_mapId, queuedTiles);
             }
         }
 
+        // the workers pull from one shared queue, handing out the biggest tiles first
+        // keeps a few huge continent tiles from being the only work left at the end
+        std::stable_sort(queuedTiles.begin(), queuedTiles.end(), [](TileInfo const& left, TileInfo const& right)
+        {
+            return left.m_inputSize > right.m_inputSize;
+        });
+
+        for (TileInfo const& tileInfo : queuedTiles)
+            _queue.Push(tileInfo);
+
         while (!_queue.Empty())
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -235,6 +251,9 @@ namespace MMAP
             delete builder;
 
         m_tileBuilders.clear();
+
+        if (m_report)
+            printReport();
     }
 
     /**************************************************************************/
@@ -416,7 +435,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
+    void MapBuilder::buildMap(uint32 mapID, std::vector<TileInfo>& queuedTiles)
     {
         std::set<uint32>* tiles = getTileList(mapID);
 
@@ -446,7 +465,16 @@ namespace MMAP
                 tileInfo.m_tileX = tileX;
                 tileInfo.m_tileY = tileY;
                 memcpy(&tileInfo.m_navMeshParams, navMesh->getParams(), sizeof(dtNavMeshParams));
-                _queue.Push(tileInfo);
+
+                std::error_code error;
+                std::filesystem::path const terrainFile = Acore::StringFormat("{}/{:03}{:02}{:02}.map", m_config->MapsPath(), mapID, tileY, tileX);
+                std::filesystem::path const vmapFile = std::filesystem::path(m_config->VMapsPath()) / StaticMapTree::getTileFileName(mapID, tileY, tileX);
+                if (std::uintmax_t size = std::filesystem::file_size(terrainFile, error); !error)
+                    tileInfo.m_inputSize += size;
+                if (std::uintmax_t size = std::filesystem::file_size(vmapFile, error); !error)
+                    tileInfo.m_inputSize += size;
+
+                queuedTiles.push_back(tileInfo);
             }
 
             dtFreeNavMesh(navMesh);
@@ -456,7 +484,12 @@ namespace MMAP
     /**************************************************************************/
     void TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
-        if (shouldSkipTile(mapID, tileX, tileY))
+        uint32 const startTime = getMSTime();
+
+        ResolvedMeshConfig const cfg = m_mapBuilder->getConfig().GetConfigForTile(mapID, tileX, tileY);
+        std::string const signature = m_mapBuilder->m_tileSignatures.buildSignature(mapID, tileX, tileY, cfg.toMMAPTileRecastConfig(), m_terrainBuilder->usesLiquids());
+
+        if (shouldSkipTile(mapID, tileX, tileY, signature))
         {
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
@@ -501,7 +534,23 @@ namespace MMAP
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_mapBuilder->m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        uint32 tileSize = buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        if (tileSize)
+            m_mapBuilder->m_tileSignatures.storeSignature(mapID, tileX, tileY, signature);
+
+        if (m_mapBuilder->m_report)
+        {
+            TileReport report;
+            report.m_mapId = mapID;
+            report.m_tileX = tileX;
+            report.m_tileY = tileY;
+            report.m_buildTime = GetMSTimeDiffToNow(startTime);
+            report.m_meshSize = (meshData.solidVerts.size() + meshData.liquidVerts.size()) * sizeof(float)
+                + (meshData.solidTris.size() + meshData.liquidTris.size()) * sizeof(int) + meshData.liquidType.size();
+            report.m_tileSize = tileSize;
+            report.m_peakMemory = getPeakMemoryUsage();
+            m_mapBuilder->addTileReport(report);
+        }
 
         ++m_mapBuilder->m_totalTilesProcessed;
     }
@@ -585,10 +634,12 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void TileBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
-                                      MeshData& meshData, float bmin[3], float bmax[3],
-                                      dtNavMesh* navMesh)
+    uint32 TileBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+                                        MeshData& meshData, float bmin[3], float bmax[3],
+                                        dtNavMesh* navMesh)
     {
+        uint32 writtenSize = 0;
+
         // console output
         char tileString[20];
         sprintf(tileString, "[Map %03i] [%02i,%02i]: ", mapID, tileX, tileY);
@@ -742,7 +793,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return 0;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -753,7 +804,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return 0;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -891,6 +942,8 @@ namespace MMAP
             fwrite(navData, sizeof(unsigned char), navDataSize, file);
             fclose(file);
 
+            writtenSize = uint32(navDataSize);
+
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, nullptr, nullptr);
         } while (false);
@@ -908,6 +961,8 @@ namespace MMAP
             iv.generateObjFile(m_mapBuilder->getConfig().DataDirPath(), mapID, tileX, tileY, meshData);
             iv.writeIV(m_mapBuilder->getConfig().DataDirPath(), mapID, tileX, tileY);
         }
+
+        return writtenSize;
     }
 
     /**************************************************************************/
@@ -1032,7 +1087,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const
+    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& signature) const
     {
         const std::string fileName = Acore::StringFormat(
             TILE_FILE_NAME_FORMAT,
@@ -1057,7 +1112,11 @@ namespace MMAP
             return false;
 
         const auto desiredRecastConfig = m_mapBuilder->getConfig().GetConfigForTile(mapID, tileX, tileY).toMMAPTileRecastConfig();
-        return header.recastConfig == desiredRecastConfig;
+        if (header.recastConfig != desiredRecastConfig)
+            return false;
+
+        // tiles built before input signatures existed, or from other input files, are rebuilt
+        return m_mapBuilder->m_tileSignatures.readStoredSignature(mapID, tileX, tileY) == signature;
     }
 
     rcConfig MapBuilder::getRecastConfig(const ResolvedMeshConfig &cfg, float bmin[3], float bmax[3]) const
@@ -1099,4 +1158,35 @@ namespace MMAP
     {
         return percentageDone(m_totalTiles, m_totalTilesProcessed);
     }
+
+    void MapBuilder::addTileReport(TileReport const& report)
+    {
+        printf("[Map %03u] [%02u,%02u]: built in %u ms, mesh %.1f KiB, tile %.1f KiB, peak memory %.1f MiB\n",
+            report.m_mapId, report.m_tileX, report.m_tileY, report.m_buildTime,
+            report.m_meshSize / 1024.0, report.m_tileSize / 1024.0, report.m_peakMemory / (1024.0 * 1024.0));
+
+        std::lock_guard<std::mutex> guard(m_tileReportsLock);
+        m_tileReports.push_back(report);
+    }
+
+    void MapBuilder::printReport() const
+    {
+        std::vector<TileReport> reports = m_tileReports;
+        std::sort(reports.begin(), reports.end(), [](TileReport const& left, TileReport const& right)
+        {
+            return left.m_buildTime > right.m_buildTime;
+        });
+
+        uint64 totalTime = 0;
+        for (TileReport const& report : reports)
+            totalTime += report.m_buildTime;
+
+        printf("\nBuilt %u tiles in %s of worker time, peak memory %.1f MiB\n", uint32(reports.size()),
+            secsToTimeString(totalTime / 1000).c_str(), getPeakMemoryUsage() / (1024.0 * 1024.0));
+
+        printf("Slowest tiles:\n");
+        for (std::size_t i = 0; i < reports.size() && i < 20; ++i)
+            printf("  [Map %03u] [%02u,%02u]: %u ms, mesh %.1f KiB, tile %.1f KiB\n", reports[i].m_mapId, reports[i].m_tileX, reports[i].m_tileY,
+                reports[i].m_buildTime, reports[i].m_meshSize / 1024.0, reports[i].m_tileSize / 1024.0);
+    }
 }
@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <list>
+#include <mutex>
 #include <set>
 #include <thread>
 #include <vector>
@@ -27,6 +28,7 @@
 #include "Config.h"
 #include "Optional.h"
 #include "TerrainBuilder.h"
+#include "TileSignature.h"
 
 #include "DetourNavMesh.h"
 #include "PCQueue.h"
@@ -74,12 +76,25 @@ namespace MMAP
 
     struct TileInfo
     {
-        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams() {}
+        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams(), m_inputSize() {}
 
         uint32 m_mapId;
         uint32 m_tileX;
         uint32 m_tileY;
         dtNavMeshParams m_navMeshParams;
+        uint64 m_inputSize;     // size of the tile's terrain and vmap files, used to start the expensive tiles first
+    };
+
+    // per tile numbers printed by --report
+    struct TileReport
+    {
+        uint32 m_mapId;
+        uint32 m_tileX;
+        uint32 m_tileY;
+        uint32 m_buildTime;     // ms
+        uint64 m_meshSize;      // bytes of terrain and model geometry fed to recast
+        uint64 m_tileSize;      // bytes of the written navmesh tile
+        uint64 m_peakMemory;    // peak memory of the whole process when the tile finished
     };
 
     /// @todo: move this to its own file. For now it will stay here to keep the changes to a minimum, especially in the cpp file
@@ -98,16 +113,16 @@ namespace MMAP
         void WaitCompletion();
 
         void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
-        // move map building
-        void buildMoveMapTile(uint32 mapID,
-                              uint32 tileX,
-                              uint32 tileY,
-                              MeshData& meshData,
-                              float bmin[3],
-                              float bmax[3],
-                              dtNavMesh* navMesh);
+        // move map building, returns the size of the written tile (0 if none was written)
+        uint32 buildMoveMapTile(uint32 mapID,
+                                uint32 tileX,
+                                uint32 tileY,
+                                MeshData& meshData,
+                                float bmin[3],
+                                float bmax[3],
+                                dtNavMesh* navMesh);
 
-        bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const;
+        bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& signature) const;
 
     private:
         bool m_debugOutput;
@@ -126,7 +141,8 @@ namespace MMAP
         MapBuilder(Config* config,
                    int mapid,
                    char const* offMeshFilePath,
-                   unsigned int threads);
+                   unsigned int threads,
+                   bool report = false);
 
         ~MapBuilder();
 
@@ -140,8 +156,8 @@ namespace MMAP
 
         const Config& getConfig() const { return *m_config; }
     private:
-        // builds all mmap tiles for the specified map id (ignores skip settings)
-        void buildMap(uint32 mapID);
+        // queues all mmap tiles for the specified map id (ignores skip settings)
+        void buildMap(uint32 mapID, std::vector<TileInfo>& queuedTiles);
         // detect maps and tiles
         void discoverTiles();
         std::set<uint32>* getTileList(uint32 mapID);
@@ -162,6 +178,9 @@ namespace MMAP
         uint32 percentageDone(uint32 totalTiles, uint32 totalTilesDone) const;
         uint32 currentPercentageDone() const;
 
+        void addTileReport(TileReport const& report);
+        void printReport() const;
+
         TerrainBuilder* m_terrainBuilder{nullptr};
         TileList m_tiles;
 
@@ -184,6 +203,12 @@ namespace MMAP
         // build performance - not really used for now
         rcContext* m_rcContext{nullptr};
 
+        TileSignatureBuilder m_tileSignatures;
+
+        bool m_report;
+        std::mutex m_tileReportsLock;
+        std::vector<TileReport> m_tileReports;
+
         std::vector<TileBuilder*> m_tileBuilders;
         ProducerConsumerQueue<TileInfo> _queue;
         std::atomic<bool> _cancelationToken;
@@ -26,8 +26,10 @@
 #include <cstddef>
 #include <cstring>
 #include <dirent.h>
+#include <sys/resource.h>
 #else
 #include <Windows.h>
+#include <psapi.h>
 #endif
 
 #ifndef _WIN32
@@ -125,6 +127,28 @@ namespace MMAP
 
         return LISTFILE_OK;
     }
+
+    // peak resident memory of the process in bytes, 0 if unknown
+    inline std::size_t getPeakMemoryUsage()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+
+        return 0;
+#else
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+#ifdef __APPLE__
+        return std::size_t(usage.ru_maxrss);
+#else
+        return std::size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
 }
 
 #endif
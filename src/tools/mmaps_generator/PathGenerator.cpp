@@ -65,7 +65,8 @@ bool handleArgs(int argc, char** argv,
                 bool& silent,
                 char*& offMeshInputPath,
                 char*& file,
-                unsigned int& threads)
+                unsigned int& threads,
+                bool& report)
 {
     bool hasCustomConfigPath = false;
     char* param = nullptr;
@@ -120,6 +121,10 @@ bool handleArgs(int argc, char** argv,
         {
             silent = true;
         }
+        else if (strcmp(argv[i], "--report") == 0)
+        {
+            report = true;
+        }
         else if (strcmp(argv[i], "--offMeshInput") == 0)
         {
             param = argv[++i];
@@ -176,9 +181,10 @@ int main(int argc, char** argv)
     bool silent = false;
     char* offMeshInputPath = nullptr;
     char* file = nullptr;
+    bool report = false;
     std::string configFilePath = "mmaps-config.yaml";
     bool validParam = handleArgs(argc, argv, mapnum,
-                                 tileX, tileY, configFilePath, silent, offMeshInputPath, file, threads);
+                                 tileX, tileY, configFilePath, silent, offMeshInputPath, file, threads, report);
 
     if (!validParam)
         return silent ? -1 : finish("You have specified invalid parameters", -1);
@@ -202,7 +208,7 @@ int main(int argc, char** argv)
     if (!checkDirectories(config->DataDirPath(), config->IsDebugOutputEnabled()))
         return silent ? -3 : finish("Press ENTER to close...", -3);
 
-    MapBuilder builder(&config.value(), mapnum, offMeshInputPath, threads);
+    MapBuilder builder(&config.value(), mapnum, offMeshInputPath, threads, report);
 
     uint32 start = getMSTime();
     if (file)
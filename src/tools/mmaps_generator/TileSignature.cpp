@@ -0,0 +1,195 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TileSignature.h"
+#include "BoundingIntervalHierarchy.h"
+#include "MMapMgr.h"
+#include "MapTree.h"
+#include "ModelInstance.h"
+#include "StringFormat.h"
+#include "Util.h"
+#include "VMapDefinitions.h"
+#include "VMapMgr2.h"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace MMAP
+{
+    static char const* const TERRAIN_FILE_NAME_FORMAT = "{}/{:03}{:02}{:02}.map";
+    static char const* const TILE_SIGNATURE_FILE_NAME_FORMAT = "{}/mmaps/{:03}{:02}{:02}.mmtile.inputs";
+
+    // feeds the file (or the fact it is missing) into the hash
+    static void hashFile(Acore::Crypto::SHA1& hash, std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+        {
+            uint8 const missing = 0;
+            hash.UpdateData(&missing, 1);
+            return;
+        }
+
+        uint8 const present = 1;
+        hash.UpdateData(&present, 1);
+
+        std::vector<uint8> buffer(64 * 1024);
+        std::size_t count;
+        while ((count = fread(buffer.data(), 1, buffer.size(), file)) > 0)
+            hash.UpdateData(buffer.data(), count);
+
+        fclose(file);
+    }
+
+    template<typename T>
+    static void hashValue(Acore::Crypto::SHA1& hash, T const& value)
+    {
+        hash.UpdateData(reinterpret_cast<uint8 const*>(&value), sizeof(T));
+    }
+
+    TileSignatureBuilder::TileSignatureBuilder(std::string const& dataDirPath, char const* offMeshFilePath) :
+        m_dataDirPath(dataDirPath),
+        m_mapsPath((std::filesystem::path(dataDirPath) / "maps").string()),
+        m_vmapsPath((std::filesystem::path(dataDirPath) / "vmaps").string() + "/"),
+        m_offMeshFilePath(offMeshFilePath)
+    {
+    }
+
+    std::string TileSignatureBuilder::buildSignature(uint32 mapID, uint32 tileX, uint32 tileY, MmapTileRecastConfig const& recastConfig, bool usesLiquids)
+    {
+        Acore::Crypto::SHA1 hash;
+
+        hashValue(hash, uint32(MMAP_VERSION));
+        hashValue(hash, uint32(DT_NAVMESH_VERSION));
+        hashValue(hash, recastConfig);
+        hashValue(hash, usesLiquids);
+
+        // same files TerrainBuilder::loadMap reads, the neighbours provide the tile borders
+        std::pair<int32, int32> const terrainTiles[] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for (auto const& [offsetX, offsetY] : terrainTiles)
+            hashFile(hash, Acore::StringFormat(TERRAIN_FILE_NAME_FORMAT, m_mapsPath, mapID, uint32(tileY + offsetY), uint32(tileX + offsetX)));
+
+        // TerrainBuilder::loadVMap is called with swapped tile coordinates
+        hash.UpdateData(getSharedFileDigest(VMAP::VMapMgr2::getMapFileName(mapID)));
+        hashFile(hash, m_vmapsPath + VMAP::StaticMapTree::getTileFileName(mapID, tileY, tileX));
+        hashModels(hash, mapID, tileY, tileX);
+
+        hashOffMeshConnections(hash, mapID, tileX, tileY);
+
+        hash.Finalize();
+        return ByteArrayToHexStr(hash.GetDigest());
+    }
+
+    TileSignatureBuilder::Digest const& TileSignatureBuilder::getSharedFileDigest(std::string const& fileName)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_sharedDigestsLock);
+            auto itr = m_sharedDigests.find(fileName);
+            if (itr != m_sharedDigests.end())
+                return itr->second;
+        }
+
+        // hash outside of the lock, two workers racing for the same model just do the work twice
+        Acore::Crypto::SHA1 hash;
+        hashFile(hash, m_vmapsPath + fileName);
+        hash.Finalize();
+
+        std::lock_guard<std::mutex> guard(m_sharedDigestsLock);
+        return m_sharedDigests.emplace(fileName, hash.GetDigest()).first->second;
+    }
+
+    void TileSignatureBuilder::hashModels(Acore::Crypto::SHA1& hash, uint32 mapID, uint32 vmapTileX, uint32 vmapTileY)
+    {
+        std::vector<std::string> modelNames;
+        char chunk[8];
+        VMAP::ModelSpawn spawn;
+
+        // non tiled maps have a single global model stored in the tree file
+        if (FILE* treeFile = fopen((m_vmapsPath + VMAP::VMapMgr2::getMapFileName(mapID)).c_str(), "rb"))
+        {
+            char tiled = 0;
+            BIH tree;
+            if (VMAP::readChunk(treeFile, chunk, VMAP::VMAP_MAGIC, 8) && fread(&tiled, sizeof(char), 1, treeFile) == 1 && !tiled &&
+                VMAP::readChunk(treeFile, chunk, "NODE", 4) && tree.readFromFile(treeFile) &&
+                VMAP::readChunk(treeFile, chunk, "GOBJ", 4) && VMAP::ModelSpawn::readFromFile(treeFile, spawn))
+                modelNames.push_back(spawn.name);
+
+            fclose(treeFile);
+        }
+
+        if (FILE* tileFile = fopen((m_vmapsPath + VMAP::StaticMapTree::getTileFileName(mapID, vmapTileX, vmapTileY)).c_str(), "rb"))
+        {
+            uint32 numSpawns = 0;
+            if (VMAP::readChunk(tileFile, chunk, VMAP::VMAP_MAGIC, 8) && fread(&numSpawns, sizeof(uint32), 1, tileFile) == 1)
+            {
+                for (uint32 i = 0; i < numSpawns; ++i)
+                {
+                    uint32 referencedNode;
+                    if (!VMAP::ModelSpawn::readFromFile(tileFile, spawn) || fread(&referencedNode, sizeof(uint32), 1, tileFile) != 1)
+                        break;
+
+                    modelNames.push_back(spawn.name);
+                }
+            }
+
+            fclose(tileFile);
+        }
+
+        for (std::string const& modelName : modelNames)
+        {
+            hash.UpdateData(modelName);
+            hash.UpdateData(getSharedFileDigest(modelName));
+        }
+    }
+
+    void TileSignatureBuilder::hashOffMeshConnections(Acore::Crypto::SHA1& hash, uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        if (!m_offMeshFilePath)
+            return;
+
+        // only the lines TerrainBuilder::loadOffMeshConnections would pick for this tile
+        std::ifstream file(m_offMeshFilePath);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            uint32 mid, tx, ty;
+            if (sscanf(line.c_str(), "%u %u,%u", &mid, &tx, &ty) == 3 && mid == mapID && tx == tileX && ty == tileY)
+                hash.UpdateData(line);
+        }
+    }
+
+    std::string TileSignatureBuilder::getSignatureFileName(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        // named after the .mmtile it belongs to
+        return Acore::StringFormat(TILE_SIGNATURE_FILE_NAME_FORMAT, m_dataDirPath, mapID, tileY, tileX);
+    }
+
+    std::string TileSignatureBuilder::readStoredSignature(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        std::ifstream file(getSignatureFileName(mapID, tileX, tileY));
+        std::string signature;
+        std::getline(file, signature);
+        return signature;
+    }
+
+    void TileSignatureBuilder::storeSignature(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& signature) const
+    {
+        std::ofstream file(getSignatureFileName(mapID, tileX, tileY), std::ios::trunc);
+        if (file)
+            file << signature << '\n';
+    }
+}
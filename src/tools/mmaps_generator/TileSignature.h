@@ -0,0 +1,69 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MMAP_TILE_SIGNATURE_H
+#define _MMAP_TILE_SIGNATURE_H
+
+#include "CryptoHash.h"
+#include "MapDefines.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace MMAP
+{
+    /**
+     * Content hash of everything a tile build reads: the terrain of the tile and its four neighbours,
+     * the vmap tree and tile, every model spawned on the tile, the tile's off mesh connections and
+     * the recast settings. A tile whose signature matches the one stored next to its .mmtile does
+     * not need to be built again.
+     *
+     * Files shared by many tiles (vmap trees, models) are hashed once per run. Thread safe.
+     */
+    class TileSignatureBuilder
+    {
+    public:
+        TileSignatureBuilder(std::string const& dataDirPath, char const* offMeshFilePath);
+
+        TileSignatureBuilder(TileSignatureBuilder const&) = delete;
+
+        std::string buildSignature(uint32 mapID, uint32 tileX, uint32 tileY, MmapTileRecastConfig const& recastConfig, bool usesLiquids);
+
+        // signature stored by the last successful build of the tile, empty if there is none
+        std::string readStoredSignature(uint32 mapID, uint32 tileX, uint32 tileY) const;
+        void storeSignature(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& signature) const;
+
+    private:
+        typedef Acore::Crypto::SHA1::Digest Digest;
+
+        Digest const& getSharedFileDigest(std::string const& fileName);
+        void hashModels(Acore::Crypto::SHA1& hash, uint32 mapID, uint32 vmapTileX, uint32 vmapTileY);
+        void hashOffMeshConnections(Acore::Crypto::SHA1& hash, uint32 mapID, uint32 tileX, uint32 tileY) const;
+
+        std::string getSignatureFileName(uint32 mapID, uint32 tileX, uint32 tileY) const;
+
+        std::string m_dataDirPath;
+        std::string m_mapsPath;
+        std::string m_vmapsPath;
+        char const* m_offMeshFilePath;
+
+        std::mutex m_sharedDigestsLock;
+        std::unordered_map<std::string, Digest> m_sharedDigests;
+    };
+}
+
+#endif